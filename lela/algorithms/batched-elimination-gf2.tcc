@@ -0,0 +1,362 @@
+/* lela/algorithms/batched-elimination-gf2.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Bit-sliced elimination of many small matrices over GF2 at once
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_BATCHED_ELIMINATION_GF2_TCC
+#define __LELA_ALGORITHMS_BATCHED_ELIMINATION_GF2_TCC
+
+#include <algorithm>
+#include <iterator>
+
+#include "lela/algorithms/batched-elimination-gf2.h"
+#include "lela/blas/level3.h"
+#include "lela/util/commentator.h"
+
+namespace LELA
+{
+
+template <size_t K, class Modules>
+void BatchedEliminationGF2<K, Modules>::transpose (Word *a)
+{
+	size_t j, k;
+	Word m, t;
+
+	// Swap the off-diagonal blocks of sizes 32, 16, ..., 1
+	for (j = 32, m = 0x00000000ffffffffULL; j != 0; j >>= 1, m ^= m << j) {
+		for (k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+			t = ((a[k] >> j) ^ a[k | j]) & m;
+			a[k] ^= t << j;
+			a[k | j] ^= t;
+		}
+	}
+}
+
+template <size_t K, class Modules>
+template <class Endianness>
+void BatchedEliminationGF2<K, Modules>::bitPositions (size_t *pos)
+{
+	size_t p, b;
+
+	for (p = 0; p < 64; ++p)
+		for (b = 0; b < 64; ++b)
+			if (Endianness::e_j (p) == Word (1) << b)
+				pos[p] = b;
+}
+
+template <size_t K, class Modules>
+template <class Iterator>
+void BatchedEliminationGF2<K, Modules>::pack (Iterator begin, Iterator end, VectorRepresentationTypes::Generic)
+{
+	size_t l, i, j;
+	bool a;
+
+	std::fill (_planes.begin (), _planes.end (), 0);
+
+	for (l = 0; begin != end; ++begin, ++l) {
+		lela_check (begin->rowdim () == _m);
+		lela_check (begin->coldim () == _n);
+
+		for (i = 0; i < _m; ++i)
+			for (j = 0; j < _n; ++j)
+				if (begin->getEntry (a, i, j) && a)
+					setBit (plane (i, j), l);
+	}
+}
+
+// Rows stored in 64-bit words are packed 64 matrices at a time: the
+// words at the same place in the same row of the 64 matrices form a
+// 64 x 64 bit-matrix whose transpose holds the planes of 64 entries
+
+template <size_t K, class Modules>
+template <class Iterator>
+void BatchedEliminationGF2<K, Modules>::pack (Iterator begin, Iterator end, VectorRepresentationTypes::Dense01)
+{
+	typedef typename std::iterator_traits<Iterator>::value_type Matrix;
+	typedef typename Matrix::ConstRow Row;
+
+	if (WordTraits<typename Row::word_type>::bits != 64) {
+		pack (begin, end, VectorRepresentationTypes::Generic ());
+		return;
+	}
+
+	std::vector<typename Matrix::ConstRowIterator> rows;
+	Word a[64];
+	size_t pos[64];
+	size_t g, t, count, i, j, k, p;
+
+	bitPositions<typename Row::Endianness> (pos);
+
+	for (g = 0; g < K; ++g) {
+		rows.clear ();
+
+		for (; begin != end && rows.size () < 64; ++begin) {
+			lela_check (begin->rowdim () == _m);
+			lela_check (begin->coldim () == _n);
+
+			rows.push_back (begin->rowBegin ());
+		}
+
+		count = rows.size ();
+
+		for (i = 0; i < _m; ++i) {
+			for (k = 0, j = 0; j < _n; ++k, j += 64) {
+				for (t = 0; t < count; ++t)
+					a[t] = *(rows[t]->word_begin () + k);
+
+				std::fill (a + count, a + 64, 0);
+
+				transpose (a);
+
+				for (p = 0; p < 64 && j + p < _n; ++p)
+					plane (i, j + p)[g] = a[pos[p]];
+			}
+
+			for (t = 0; t < count; ++t)
+				++rows[t];
+		}
+	}
+}
+
+template <size_t K, class Modules>
+void BatchedEliminationGF2<K, Modules>::eliminate ()
+{
+	size_t i, j, c, w;
+	Word mask[K];
+
+	std::fill (_used.begin (), _used.end (), 0);
+
+	for (c = 0; c < _n; ++c) {
+		Word *found = &_found[c * K];
+
+		std::fill (found, found + K, 0);
+
+		// In each matrix, the first row not yet used as pivot-row
+		// with a one in column c becomes the pivot-row
+		for (i = 0; i < _m; ++i) {
+			const Word *a = plane (i, c);
+			const Word *used = &_used[i * K];
+			Word *sel = &_sel[i * K];
+
+			for (w = 0; w < K; ++w) {
+				sel[w] = a[w] & ~used[w] & ~found[w];
+				found[w] |= sel[w];
+			}
+		}
+
+		// Rows not yet used are zero to the left of column c, so
+		// the pivot-rows need only be gathered from column c on
+		std::fill (_pivot_row.begin () + c * K, _pivot_row.end (), 0);
+
+		for (i = 0; i < _m; ++i) {
+			const Word *sel = &_sel[i * K];
+
+			for (j = c; j < _n; ++j) {
+				const Word *a = plane (i, j);
+				Word *p = &_pivot_row[j * K];
+
+				for (w = 0; w < K; ++w)
+					p[w] |= a[w] & sel[w];
+			}
+		}
+
+		// Add the pivot-row to every other row with a one in
+		// column c
+		for (i = 0; i < _m; ++i) {
+			const Word *a = plane (i, c);
+			Word *used = &_used[i * K];
+			Word *sel = &_sel[i * K];
+
+			for (w = 0; w < K; ++w) {
+				mask[w] = a[w] & found[w] & ~sel[w];
+				used[w] |= sel[w];
+			}
+
+			for (j = c; j < _n; ++j) {
+				Word *b = plane (i, j);
+				const Word *p = &_pivot_row[j * K];
+
+				for (w = 0; w < K; ++w)
+					b[w] ^= p[w] & mask[w];
+			}
+		}
+	}
+}
+
+template <size_t K, class Modules>
+size_t BatchedEliminationGF2<K, Modules>::pivotRow (size_t l, size_t c) const
+{
+	size_t i;
+
+	// The pivot-column has a one only in the pivot-row
+	for (i = 0; !getBit (plane (i, c), l); ++i);
+
+	return i;
+}
+
+template <size_t K, class Modules>
+template <class Iterator>
+void BatchedEliminationGF2<K, Modules>::unpack (Iterator begin, Iterator end, std::vector<size_t>::iterator rank,
+						VectorRepresentationTypes::Generic)
+{
+	size_t l, i, j, c, r;
+
+	for (l = 0; begin != end; ++begin, ++l, ++rank) {
+		BLAS3::scal (ctx, ctx.F.zero (), *begin);
+
+		for (c = 0, r = 0; c < _n; ++c) {
+			if (!getBit (&_found[c * K], l))
+				continue;
+
+			i = pivotRow (l, c);
+
+			for (j = c; j < _n; ++j)
+				if (getBit (plane (i, j), l))
+					begin->setEntry (r, j, true);
+
+			++r;
+		}
+
+		*rank = r;
+	}
+}
+
+// The inverse of packing: transposing the planes gives the rows of 64
+// matrices, which are then copied to their places in the reduced
+// row-echelon forms a word at a time
+
+template <size_t K, class Modules>
+template <class Iterator>
+void BatchedEliminationGF2<K, Modules>::unpack (Iterator begin, Iterator end, std::vector<size_t>::iterator rank,
+						VectorRepresentationTypes::Dense01)
+{
+	typedef typename std::iterator_traits<Iterator>::value_type Matrix;
+	typedef typename Matrix::Row Row;
+
+	if (WordTraits<typename Row::word_type>::bits != 64) {
+		unpack (begin, end, rank, VectorRepresentationTypes::Generic ());
+		return;
+	}
+
+	const size_t words = (_n + 63) / 64;
+
+	Word a[64];
+	size_t pos[64];
+	size_t g, t, count, l, i, j, k, p, c;
+
+	bitPositions<typename Row::Endianness> (pos);
+
+	_rows.resize (64 * _m * words);
+
+	for (g = 0; g < K && begin != end; ++g) {
+		Iterator group_end = begin;
+
+		for (count = 0; count < 64 && group_end != end; ++count)
+			++group_end;
+
+		for (i = 0; i < _m; ++i) {
+			for (k = 0, j = 0; j < _n; ++k, j += 64) {
+				std::fill (a, a + 64, 0);
+
+				for (p = 0; p < 64 && j + p < _n; ++p)
+					a[pos[p]] = plane (i, j + p)[g];
+
+				transpose (a);
+
+				for (t = 0; t < count; ++t)
+					_rows[(t * _m + i) * words + k] = a[t];
+			}
+		}
+
+		for (t = 0, l = 64 * g; begin != group_end; ++begin, ++t, ++l, ++rank) {
+			typename Matrix::RowIterator i_A = begin->rowBegin ();
+			size_t r = 0;
+
+			for (c = 0; c < _n; ++c) {
+				if (!getBit (&_found[c * K], l))
+					continue;
+
+				const Word *row = &_rows[(t * _m + pivotRow (l, c)) * words];
+
+				for (k = 0; k < words; ++k)
+					*(i_A->word_begin () + k) = row[k];
+
+				++i_A;
+				++r;
+			}
+
+			*rank = r;
+
+			for (; i_A != begin->rowEnd (); ++i_A)
+				for (k = 0; k < words; ++k)
+					*(i_A->word_begin () + k) = 0;
+		}
+	}
+}
+
+template <size_t K, class Modules>
+template <class Iterator>
+void BatchedEliminationGF2<K, Modules>::echelonize_reduced (Iterator begin, Iterator end, std::vector<size_t> &ranks)
+{
+	ranks.resize (std::distance (begin, end));
+
+	if (begin == end)
+		return;
+
+	_m = begin->rowdim ();
+	_n = begin->coldim ();
+
+	_planes.resize (_m * _n * K);
+	_found.resize (_n * K);
+	_used.resize (_m * K);
+	_sel.resize (_m * K);
+	_pivot_row.resize (_n * K);
+
+	ActivityGuard guard;
+
+	commentator.start ("Batched elimination over GF2", __FUNCTION__, (ranks.size () + batch_size - 1) / batch_size);
+
+	std::vector<size_t>::iterator rank = ranks.begin ();
+
+	while (begin != end) {
+		Iterator batch_end = begin;
+		size_t count;
+
+		for (count = 0; count < batch_size && batch_end != end; ++count)
+			++batch_end;
+
+		ctx.checkCancelled ();
+
+		pack (begin, batch_end);
+		eliminate ();
+		unpack (begin, batch_end, rank);
+
+		begin = batch_end;
+		rank += count;
+
+		commentator.progress ();
+	}
+
+	commentator.stop (MSG_DONE);
+}
+
+} // namespace LELA
+
+#endif // __LELA_ALGORITHMS_BATCHED_ELIMINATION_GF2_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
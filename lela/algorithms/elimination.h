@@ -14,10 +14,15 @@
 #ifndef __LELA_ALGORITHMS_ELIMINATION_H
 #define __LELA_ALGORITHMS_ELIMINATION_H
 
+#include <vector>
+
+#include "lela/util/index.h"
 #include "lela/vector/traits.h"
+#include "lela/matrix/traits.h"
 #include "lela/vector/bit-iterator.h"
 #include "lela/ring/gf2.h"
 #include "lela/algorithms/pivot-strategy.h"
+#include "lela/algorithms/lazy-elimination.h"
 
 namespace LELA
 {
@@ -36,12 +41,74 @@ class Elimination
 {
 public:
 	typedef typename Ring::Element Element;
-	typedef std::pair<uint32, uint32> Transposition;
+	typedef DefaultIndexPolicy::Transposition Transposition;
 	typedef std::vector<Transposition> Permutation;
 
 private:
 	Context<Ring, Modules> &ctx;
 
+	// Number of rows handed to a thread at a time in the backward phase
+	static const size_t backward_rows_per_chunk = 16;
+
+	// Minimal number of columns solved for by each thread in the
+	// backward phase on dense matrices
+	static const size_t backward_min_cols_per_thread = 64;
+
+	// Number of threads available for the backward phase
+	static long threads ();
+
+	// Clear the entries above the pivots of the row-echelon form A,
+	// whose pivots are one and lie in the given columns. Rows are
+	// distributed over the available threads; on dense matrices the
+	// rows are instead reduced with a triangular solve on blocks of
+	// columns.
+	template <class Matrix>
+	void reduce_above (Matrix &A, const std::vector<size_t> &pivot_cols) const
+		{ reduce_above_spec (A, pivot_cols, typename Matrix::StorageType ()); }
+
+	template <class Matrix>
+	void reduce_above_spec (Matrix &A, const std::vector<size_t> &pivot_cols, MatrixStorageTypes::Generic) const;
+
+	template <class Matrix>
+	void reduce_above_spec (Matrix &A, const std::vector<size_t> &pivot_cols, MatrixStorageTypes::Dense) const;
+
+	// Implementation of echelonize with the default
+	// pivot-strategy; dense matrices over rings allowing it are
+	// passed on to LazyElimination, which gives the same result
+	template <class Matrix, class Support, class Trait>
+	Matrix &echelonize_default (Matrix &A, Permutation &P, size_t &rank, Element &det, bool compute_L, Support, Trait) const
+		{ return echelonize_profiled (A, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx), compute_L); }
+
+	template <class Matrix>
+	Matrix &echelonize_default (Matrix &A, Permutation &P, size_t &rank, Element &det, bool compute_L,
+				    LazyEliminationTypes::Supported, VectorRepresentationTypes::Dense) const;
+
+	// Run echelonize resp. echelonize_reduced with the default
+	// pivot-strategy PS. The sparse strategy is given the profile of
+	// A, with which it stops searching as soon as it finds a row
+	// which no other row can beat.
+	template <class Matrix, class PivotStrategy>
+	Matrix &echelonize_profiled (Matrix &A, Permutation &P, size_t &rank, Element &det, PivotStrategy PS, bool compute_L) const
+		{ return echelonize (A, P, rank, det, PS, compute_L); }
+
+	template <class Matrix>
+	Matrix &echelonize_profiled (Matrix &A, Permutation &P, size_t &rank, Element &det, SparsePartialPivotStrategy<Ring, Modules>, bool compute_L) const
+	{
+		MatrixProfile profile (ctx, A);
+		return echelonize (A, P, rank, det, SparsePartialPivotStrategy<Ring, Modules> (ctx, profile), compute_L);
+	}
+
+	template <class Matrix1, class Matrix2, class PivotStrategy>
+	Matrix1 &echelonize_reduced_profiled (Matrix1 &A, Matrix2 &L, Permutation &P, size_t &rank, Element &det, PivotStrategy PS, bool compute_L) const
+		{ return echelonize_reduced (A, L, P, rank, det, PS, compute_L); }
+
+	template <class Matrix1, class Matrix2>
+	Matrix1 &echelonize_reduced_profiled (Matrix1 &A, Matrix2 &L, Permutation &P, size_t &rank, Element &det, SparsePartialPivotStrategy<Ring, Modules>, bool compute_L) const
+	{
+		MatrixProfile profile (ctx, A);
+		return echelonize_reduced (A, L, P, rank, det, SparsePartialPivotStrategy<Ring, Modules> (ctx, profile), compute_L);
+	}
+
 public:
 	/**
 	 * \brief Constructor
@@ -89,7 +156,9 @@ public:
 			    size_t        &rank,
 			    Element       &det,
 			    bool           compute_L = true) const
-		{ return echelonize (A, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix::Row>::Strategy (ctx), compute_L); }
+		{ return echelonize_default (A, P, rank, det, compute_L,
+					     typename LazyEliminationTraits<Ring>::Support (),
+					     typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
 
 	/** Compute the non-reduced row-echelon form of a matrix using
 	 * the pivot-strategy provided
@@ -114,6 +183,11 @@ public:
 	 * row-echelon form, L is the transform-matrix, and P is a
 	 * permutation.
 	 *
+	 * If compute_L is false, the rows are first eliminated only
+	 * below the pivots, and the entries above the pivots are then
+	 * cleared in a separate backward phase in which the rows are
+	 * reduced in parallel.
+	 *
 	 * @param A The matrix whose reduced row-echelon form is to be
 	 * computed. Will be replaced by its reduced row-echelon form
 	 * during computation.
@@ -144,7 +218,7 @@ public:
 				     size_t        &rank,
 				     Element       &det,
 				     bool           compute_L = false) const
-		{ return echelonize_reduced (A, L, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix1::Row>::Strategy (ctx), compute_L); }
+		{ return echelonize_reduced_profiled (A, L, P, rank, det, typename DefaultPivotStrategy<Ring, Modules, typename Matrix1::Row>::Strategy (ctx), compute_L); }
 
 	/** Compute the reduced row-echelon form of a matrix using the
 	 * pivot-strategy provided
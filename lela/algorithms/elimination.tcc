@@ -18,10 +18,15 @@
 #include <iomanip>
 #include <cassert>
 
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
 #include "lela/algorithms/elimination.h"
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
 #include "lela/vector/stream.h"
+#include "lela/matrix/dense.h"
 
 #ifdef DETAILED_PROFILE
 #  define TIMER_DECLARE(part) LELA::UserTimer part##_timer; double part##_time = 0.0;
@@ -44,6 +49,27 @@
 namespace LELA
 {
 
+template <class Ring, class Modules>
+long Elimination<Ring, Modules>::threads ()
+{
+#ifdef _OPENMP
+	return omp_get_max_threads ();
+#else
+	return 1;
+#endif
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+Matrix &Elimination<Ring, Modules>::echelonize_default (Matrix &A, Permutation &P, size_t &rank, Element &det, bool compute_L,
+							LazyEliminationTypes::Supported, VectorRepresentationTypes::Dense) const
+{
+	if (LazyElimination<Ring, Modules>::applies (ctx.F))
+		return LazyElimination<Ring, Modules> (ctx).echelonize (A, P, rank, det, compute_L);
+	else
+		return echelonize (A, P, rank, det, DensePivotStrategy<Ring, Modules> (ctx), compute_L);
+}
+
 template <class Ring, class Modules>
 template <class Matrix, class PivotStrategy>
 Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
@@ -53,7 +79,13 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 						PivotStrategy  PS,
 						bool           compute_L) const
 {
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
 	commentator.start ("Echelonize (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
 
@@ -75,6 +107,8 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 	ctx.F.init (det, 1);
 
 	for (i_A = A.rowBegin (), i = 0, pivot_col = 0; i_A != A.rowEnd () && pivot_col < A.coldim (); ++i, ++i_A, ++pivot_col) {
+		ctx.checkCancelled ();
+
 		TIMER_START(GetPivot);
 		pivot_row = i;
 		if (!PS.getPivot (A, x, pivot_row, pivot_col))
@@ -133,6 +167,7 @@ Matrix &Elimination<Ring, Modules>::echelonize (Matrix        &A,
 	TIMER_REPORT(Permute);
 	TIMER_REPORT(ElimBelow);
 
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE);
 
 	return A;
@@ -151,13 +186,20 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	lela_check (!compute_L || L.rowdim () == A.rowdim ());
 	lela_check (!compute_L || L.coldim () == A.rowdim ());
 
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
 	commentator.start ("Echelonize (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
 
 	TIMER_DECLARE(GetPivot);
 	TIMER_DECLARE(Permute);
 	TIMER_DECLARE(Elim);
+	TIMER_DECLARE(ElimAbove);
 
 	typename Matrix1::RowIterator i_A, j_A;
 	typename Matrix2::RowIterator i_L = L.rowBegin (), j_L = L.rowBegin ();
@@ -166,6 +208,10 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	size_t i, j;
 	Element a, x, xinv, nega;
 
+	// Columns of the pivots, used by the backward phase when L is
+	// not needed
+	std::vector<size_t> pivot_cols;
+
 	ctx.F.copy (a, ctx.F.zero ());
 	ctx.F.copy (x, ctx.F.zero ());
 
@@ -184,6 +230,8 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	}
 
 	for (i_A = A.rowBegin (), i = 0, pivot_col = 0; i_A != A.rowEnd () && pivot_col < A.coldim (); ++i, ++i_A, ++pivot_col) {
+		ctx.checkCancelled ();
+
 		TIMER_START(GetPivot);
 		pivot_row = i;
 		if (!PS.getPivot (A, x, pivot_row, pivot_col))
@@ -227,7 +275,20 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 			j_L = L.rowBegin ();
 		}
 
-		for (j_A = A.rowBegin (), j = 0; j_A != A.rowEnd (); ++j, ++j_A) {
+		// If L is not needed, only the rows below the pivot are
+		// eliminated here; the rows above are reduced
+		// afterwards in the backward phase
+		if (compute_L) {
+			j_A = A.rowBegin ();
+			j = 0;
+		} else {
+			j_A = i_A;
+			++j_A;
+			j = i + 1;
+			pivot_cols.push_back (pivot_col);
+		}
+
+		for (; j_A != A.rowEnd (); ++j, ++j_A) {
 			if (j_A != i_A && A.getEntry (a, j, pivot_col) && !ctx.F.isZero (a)) {
 				// DEBUG
 				// report << "Eliminating row " << j << " from row " << i << std::endl;
@@ -254,15 +315,134 @@ Matrix1 &Elimination<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 			commentator.progress ();
 	}
 
+	if (!compute_L) {
+		ctx.checkCancelled ();
+
+		TIMER_START(ElimAbove);
+		reduce_above (A, pivot_cols);
+		TIMER_STOP(ElimAbove);
+	}
+
 	TIMER_REPORT(GetPivot);
 	TIMER_REPORT(Permute);
 	TIMER_REPORT(Elim);
+	TIMER_REPORT(ElimAbove);
 
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE);
 
 	return A;
 }
 
+template <class Ring, class Modules>
+template <class Matrix>
+void Elimination<Ring, Modules>::reduce_above_spec (Matrix &A, const std::vector<size_t> &pivot_cols, MatrixStorageTypes::Generic) const
+{
+	size_t rank = pivot_cols.size ();
+
+	if (rank < 2)
+		return;
+
+	std::vector<typename Matrix::RowIterator> rows;
+	typename Matrix::RowIterator i_A = A.rowBegin ();
+
+	for (size_t k = 0; k < rank; ++k, ++i_A)
+		rows.push_back (i_A);
+
+	// Each row is reduced against the unreduced rows below it, so
+	// the results are only copied back once all rows are done
+	std::vector<typename Vector<Ring>::Sparse> reduced (rank - 1);
+
+#pragma omp parallel
+	{
+		Context<Ring, Modules> thread_ctx (ctx);
+		typename Vector<Ring>::Dense acc (A.coldim ());
+		Element a, nega;
+
+		thread_ctx.F.copy (a, thread_ctx.F.zero ());
+		thread_ctx.F.copy (nega, thread_ctx.F.zero ());
+
+#pragma omp for schedule(dynamic, backward_rows_per_chunk)
+		for (long i = 0; i < (long) rank - 1; ++i) {
+			BLAS1::copy (thread_ctx, *rows[i], acc);
+
+			// Pivots are visited in increasing order of column, so
+			// that clearing one pivot-column never disturbs one
+			// already cleared
+			for (size_t k = i + 1; k < rank; ++k) {
+				if (VectorUtils::getEntry (acc, a, pivot_cols[k]) && !thread_ctx.F.isZero (a)) {
+					thread_ctx.F.neg (nega, a);
+					BLAS1::axpy (thread_ctx, nega, *rows[k], acc);
+				}
+			}
+
+			BLAS1::copy (thread_ctx, acc, reduced[i]);
+		}
+	}
+
+	for (size_t k = 0; k < rank - 1; ++k)
+		BLAS1::copy (ctx, reduced[k], *rows[k]);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void Elimination<Ring, Modules>::reduce_above_spec (Matrix &A, const std::vector<size_t> &pivot_cols, MatrixStorageTypes::Dense) const
+{
+	size_t rank = pivot_cols.size ();
+
+	if (rank < 2)
+		return;
+
+	// Move the pivot-columns of the pivot-rows to the front, so
+	// that the pivot-rows are [U N] with U upper triangular with
+	// unit diagonal. The reduced rows are then [I U^-1 N]. Since
+	// the pivot-columns are increasing, column k can be swapped
+	// directly with the k-th pivot-column.
+	typename Matrix::SubmatrixType A_piv (A, 0, 0, rank, A.coldim ());
+	Permutation Q;
+	size_t k, l, other = A.coldim () - rank;
+
+	for (k = 0; k < rank; ++k)
+		if (pivot_cols[k] != k)
+			Q.push_back (Transposition (k, pivot_cols[k]));
+
+	BLAS3::permute_cols (ctx, Q.begin (), Q.end (), A_piv);
+
+	typename Matrix::SubmatrixType U (A_piv, 0, 0, rank, rank);
+
+	// Solve for blocks of columns of N independently
+	long num_parts = std::min<long> (threads (), other / backward_min_cols_per_thread + 1);
+	volatile bool cancelled = false;
+
+#pragma omp parallel for schedule(static)
+	for (long p = 0; p < num_parts; ++p) {
+		if (cancelled)
+			continue;
+
+		Context<Ring, Modules> thread_ctx (ctx);
+		size_t start = rank + other * p / num_parts, end = rank + other * (p + 1) / num_parts;
+		typename Matrix::SubmatrixType N_p (A_piv, 0, start, rank, end - start);
+
+		try {
+			BLAS3::trsm (thread_ctx, thread_ctx.F.one (), U, N_p, UpperTriangular, true);
+		}
+		catch (const Cancelled &) {
+			cancelled = true;
+		}
+	}
+
+	// Exceptions may not leave a parallel region, so cancellation
+	// is rethrown here
+	if (cancelled)
+		ctx.checkCancelled ();
+
+	for (k = 0; k < rank; ++k)
+		for (l = k + 1; l < rank; ++l)
+			A_piv.setEntry (k, l, ctx.F.zero ());
+
+	BLAS3::permute_cols (ctx, Q.rbegin (), Q.rend (), A_piv);
+}
+
 template <class Ring, class Modules>
 template <class Matrix, class PivotStrategy>
 Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
@@ -272,7 +452,14 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 					  Element       &det,
 					  PivotStrategy  PS) const
 {
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+	checkDim<DefaultIndexPolicy> (A.coldim (), "Column-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
 	commentator.start ("PLUQ-decomposition (elimination)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
 
 	// std::ostream &report = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
 
@@ -295,6 +482,8 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 	ctx.F.init (det, 1);
 
 	for (i_A = A.rowBegin (), i = 0; i_A != A.rowEnd () && i < A.coldim (); ++i, ++i_A) {
+		ctx.checkCancelled ();
+
 		TIMER_START(GetPivot);
 		pivot_row = pivot_col = i;
 		if (!PS.getPivot (A, x, pivot_row, pivot_col))
@@ -364,6 +553,7 @@ Matrix &Elimination<Ring, Modules>::pluq (Matrix        &A,
 	TIMER_REPORT(Permute);
 	TIMER_REPORT(ElimBelow);
 
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE);
 
 	return A;
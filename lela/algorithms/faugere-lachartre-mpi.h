@@ -0,0 +1,147 @@
+/* lela/algorithms/faugere-lachartre-mpi.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Distributed-memory version of the Faugère-Lachartre algorithm
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_H
+#define __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_H
+
+#include <vector>
+
+#include "lela/lela-config.h"
+#include "lela/blas/context.h"
+#include "lela/util/mpi.h"
+#include "lela/matrix/dense.h"
+#include "lela/matrix/sparse.h"
+#include "lela/algorithms/faugere-lachartre.h"
+
+namespace LELA
+{
+
+/**
+ * \brief Faugère-Lachartre algorithm for reduced row-echelon forms of
+ * F4-matrices, distributed over the processes of an MPI-communicator
+ *
+ * The root process holds the input and receives the output. It finds
+ * the pivot-rows and splits the input into the blocks [A|B] and [C|D]
+ * as @ref FaugereLachartre does. Then:
+ *
+ *  - The columns of B and D are partitioned among the processes; the
+ *    nonzero entries of A and C are broadcast. Each process computes A^-1 B and D - C A^-1 B
+ *    on the columns it owns. It starts on A^-1 B as soon as A and its
+ *    part of B have arrived, while C and its part of D are still in
+ *    transit, and the root computes its own part while the other parts
+ *    are being sent.
+ *
+ *  - D - C A^-1 B is redistributed by rows. Each process computes the
+ *    row-echelon form of its rows, and the echelon forms are merged
+ *    pairwise along a binary tree towards the root. Meanwhile each
+ *    process returns its part of A^-1 B to the root.
+ *
+ *  - The root splits B and D by the pivots of D and computes D1^-1 D2;
+ *    the rows of B are partitioned among the processes, each of which
+ *    computes its rows of B2 - B1 D1^-1 D2.
+ *
+ * The result is the same reduced row-echelon form as computed by @ref
+ * FaugereLachartre.
+ *
+ * Since the splitting needs the pivots of the whole input, the root
+ * must hold all of X together with A, B, C, and D; only the work, not
+ * the memory, of the root is distributed.
+ *
+ * Elements are transferred as raw bytes, so Ring::Element must be
+ * plain old data, e.g. that of Modular<uint32>; GF2 is not supported.
+ * Plans and cancellation are not supported, since every process must
+ * take part in every step.
+ *
+ * \ingroup algorithms
+ */
+template <class Ring, class Modules = AllModules<Ring> >
+class DistributedFaugereLachartre
+{
+	typedef typename Ring::Element Element;
+	typedef DenseMatrix<Element> Dense;
+	typedef typename DefaultSparseMatrix<Ring>::Type Sparse;
+
+	// Tags of the point-to-point messages
+	enum { TAG_B = 1, TAG_D, TAG_B_RESULT, TAG_D_ROWS, TAG_D_MERGE, TAG_B1, TAG_B2, TAG_B2_RESULT };
+
+	Context<Ring, Modules> &ctx;
+	const MPICommunicator &_comm;
+	FaugereLachartre<Ring, Modules> _FL;
+	EchelonForm<Ring, Modules> EF;
+
+	// Copy the entries in rows [r_begin, r_end) and columns
+	// [c_begin, c_end) of A row by row into buf
+	static void packBlock (const Dense &A, size_t r_begin, size_t r_end, size_t c_begin, size_t c_end, std::vector<Element> &buf);
+
+	// Copy buf into rows [r_begin, r_end) and columns [c_begin,
+	// c_end) of A
+	static void unpackBlock (const std::vector<Element> &buf, Dense &A, size_t r_begin, size_t r_end, size_t c_begin, size_t c_end);
+
+	static void packSparse (const Sparse &A, std::vector<uint64> &row_sizes, std::vector<uint64> &indices, std::vector<Element> &values);
+	static void unpackSparse (const std::vector<uint64> &row_sizes, const std::vector<uint64> &indices, const std::vector<Element> &values, Sparse &A);
+
+	// As above, but transfer only the nonzero entries of a dense
+	// matrix
+	void packSparse (const Dense &A, std::vector<uint64> &row_sizes, std::vector<uint64> &indices, std::vector<Element> &values);
+	void unpackSparse (const std::vector<uint64> &row_sizes, const std::vector<uint64> &indices, const std::vector<Element> &values, Dense &A);
+
+	// Append the nonzero rows of A to buf, row by row, after clearing it
+	void packNonzeroRows (const Dense &A, std::vector<Element> &buf);
+
+	static Element *data (std::vector<Element> &v) { return v.empty () ? NULL : &v[0]; }
+
+	// Compute the row-echelon form of the rows of D, distributed
+	// by columns, leaving it in D on the root
+	void echelonize_distributed (Dense &D, const Dense &D_local, size_t m, size_t n);
+
+public:
+	/**
+	 * \brief Construct a new DistributedFaugereLachartre
+	 *
+	 * @param _ctx Context-object for matrix-calculations on
+	 * the calling process
+	 *
+	 * @param comm Communicator over whose processes to
+	 * distribute; must outlive this object
+	 */
+	DistributedFaugereLachartre (Context<Ring, Modules> &_ctx, const MPICommunicator &comm);
+
+	/**
+	 * \brief Convert the matrix A into reduced
+	 * row-echelon form
+	 *
+	 * Must be called by all processes of the communicator.
+	 * Parameters are as in FaugereLachartre::echelonize; R
+	 * and X are only used on the root, det is only set on the
+	 * root, and rank is set on all processes. Since the
+	 * residual block is echelonised in a different order, det
+	 * may differ from that computed by FaugereLachartre.
+	 */
+	template <class Matrix>
+	void echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det);
+};
+
+} // namespace LELA
+
+#include "lela/algorithms/faugere-lachartre-mpi.tcc"
+
+#endif // __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
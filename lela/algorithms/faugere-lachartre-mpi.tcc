@@ -0,0 +1,567 @@
+/* lela/algorithms/faugere-lachartre-mpi.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Distributed-memory version of the Faugère-Lachartre algorithm
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_TCC
+#define __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_TCC
+
+#include <vector>
+#include <algorithm>
+
+#include "lela/algorithms/faugere-lachartre-mpi.h"
+#include "lela/blas/level1.h"
+#include "lela/blas/level3.h"
+#include "lela/solutions/echelon-form.h"
+
+namespace LELA
+{
+
+template <class Ring, class Modules>
+DistributedFaugereLachartre<Ring, Modules>::DistributedFaugereLachartre (Context<Ring, Modules> &_ctx, const MPICommunicator &comm)
+	: ctx (_ctx), _comm (comm), _FL (_ctx), EF (_ctx) {}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::packBlock (const Dense &A, size_t r_begin, size_t r_end, size_t c_begin, size_t c_end,
+							    std::vector<Element> &buf)
+{
+	typename Dense::ConstRowIterator i_A;
+	typename std::vector<Element>::iterator out;
+
+	buf.resize ((r_end - r_begin) * (c_end - c_begin));
+
+	for (i_A = A.rowBegin () + r_begin, out = buf.begin (); i_A != A.rowBegin () + r_end; ++i_A)
+		out = std::copy (i_A->begin () + c_begin, i_A->begin () + c_end, out);
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::unpackBlock (const std::vector<Element> &buf, Dense &A, size_t r_begin, size_t r_end,
+							      size_t c_begin, size_t c_end)
+{
+	lela_check (buf.size () == (r_end - r_begin) * (c_end - c_begin));
+
+	typename Dense::RowIterator i_A;
+	typename std::vector<Element>::const_iterator in;
+
+	for (i_A = A.rowBegin () + r_begin, in = buf.begin (); i_A != A.rowBegin () + r_end; ++i_A, in += c_end - c_begin)
+		std::copy (in, in + (c_end - c_begin), i_A->begin () + c_begin);
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::packSparse (const Sparse &A, std::vector<uint64> &row_sizes, std::vector<uint64> &indices,
+							     std::vector<Element> &values)
+{
+	typename Sparse::ConstRowIterator i_A;
+	typename Sparse::Row::const_iterator j;
+
+	row_sizes.clear ();
+	indices.clear ();
+	values.clear ();
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A) {
+		row_sizes.push_back (i_A->size ());
+
+		for (j = i_A->begin (); j != i_A->end (); ++j) {
+			indices.push_back (j->first);
+			values.push_back (j->second);
+		}
+	}
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::unpackSparse (const std::vector<uint64> &row_sizes, const std::vector<uint64> &indices,
+							       const std::vector<Element> &values, Sparse &A)
+{
+	lela_check (row_sizes.size () == A.rowdim ());
+
+	typename Sparse::RowIterator i_A;
+	std::vector<uint64>::const_iterator i_size;
+	size_t k = 0, l;
+
+	for (i_A = A.rowBegin (), i_size = row_sizes.begin (); i_A != A.rowEnd (); ++i_A, ++i_size) {
+		i_A->clear ();
+
+		for (l = 0; l < *i_size; ++l, ++k)
+			i_A->push_back (typename Sparse::Row::value_type (indices[k], values[k]));
+	}
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::packSparse (const Dense &A, std::vector<uint64> &row_sizes, std::vector<uint64> &indices,
+							     std::vector<Element> &values)
+{
+	typename Dense::ConstRowIterator i_A;
+	typename Dense::ConstRow::const_iterator j;
+	std::vector<uint64>::iterator i_size;
+	size_t before;
+
+	// A matrix without columns has no row-iterators to run over, but
+	// every row must still have a size
+	row_sizes.assign (A.rowdim (), 0);
+	indices.clear ();
+	values.clear ();
+
+	if (A.coldim () == 0)
+		return;
+
+	for (i_A = A.rowBegin (), i_size = row_sizes.begin (); i_A != A.rowEnd (); ++i_A, ++i_size) {
+		before = indices.size ();
+
+		for (j = i_A->begin (); j != i_A->end (); ++j) {
+			if (!ctx.F.isZero (*j)) {
+				indices.push_back (j - i_A->begin ());
+				values.push_back (*j);
+			}
+		}
+
+		*i_size = indices.size () - before;
+	}
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::unpackSparse (const std::vector<uint64> &row_sizes, const std::vector<uint64> &indices,
+							       const std::vector<Element> &values, Dense &A)
+{
+	lela_check (row_sizes.size () == A.rowdim ());
+
+	typename Dense::RowIterator i_A;
+	std::vector<uint64>::const_iterator i_size;
+	size_t k = 0, l;
+
+	for (i_A = A.rowBegin (), i_size = row_sizes.begin (); i_A != A.rowEnd (); ++i_A, ++i_size) {
+		std::fill (i_A->begin (), i_A->end (), ctx.F.zero ());
+
+		for (l = 0; l < *i_size; ++l, ++k)
+			ctx.F.copy (*(i_A->begin () + indices[k]), values[k]);
+	}
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::packNonzeroRows (const Dense &A, std::vector<Element> &buf)
+{
+	typename Dense::ConstRowIterator i_A;
+
+	buf.clear ();
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A)
+		if (!BLAS1::is_zero (ctx, *i_A))
+			buf.insert (buf.end (), i_A->begin (), i_A->end ());
+}
+
+template <class Ring, class Modules>
+void DistributedFaugereLachartre<Ring, Modules>::echelonize_distributed (Dense &D, const Dense &D_local, size_t m, size_t n)
+{
+	if (n == 0)
+		return;
+
+	const int me = _comm.rank (), size = _comm.size ();
+	const size_t r_begin = _comm.partBegin (m, me), r_end = _comm.partEnd (m, me);
+	int p;
+
+	// Redistribute the rows of D among the processes
+
+	std::vector<std::vector<Element> > out (size), in (size);
+	Dense D_rows (r_end - r_begin, n);
+	MPIRequests requests;
+
+	for (p = 0; p < size; ++p) {
+		if (p == me)
+			continue;
+
+		packBlock (D_local, _comm.partBegin (m, p), _comm.partEnd (m, p), 0, D_local.coldim (), out[p]);
+		MPITransfer::isend (_comm, data (out[p]), out[p].size (), p, TAG_D_ROWS, requests);
+
+		in[p].resize ((r_end - r_begin) * (_comm.partEnd (n, p) - _comm.partBegin (n, p)));
+		MPITransfer::irecv (_comm, data (in[p]), in[p].size (), p, TAG_D_ROWS, requests);
+	}
+
+	packBlock (D_local, r_begin, r_end, 0, D_local.coldim (), in[me]);
+
+	requests.wait ();
+
+	for (p = 0; p < size; ++p)
+		unpackBlock (in[p], D_rows, 0, D_rows.rowdim (), _comm.partBegin (n, p), _comm.partEnd (n, p));
+
+	// Echelonise locally, then merge the echelon forms along a
+	// binary tree, each merge echelonising the rows of both
+
+	std::vector<Element> rows, received;
+
+	if (D_rows.rowdim () > 0)
+		EF.echelonize (D_rows);
+
+	packNonzeroRows (D_rows, rows);
+
+	for (int step = 1; step < size; step *= 2) {
+		if (me % (2 * step) != 0) {
+			MPITransfer::send (_comm, rows, me - step, TAG_D_MERGE);
+			break;
+		}
+		else if (me + step < size) {
+			MPITransfer::recv (_comm, received, me + step, TAG_D_MERGE);
+
+			if (!received.empty ()) {
+				size_t k_1 = rows.size () / n, k_2 = received.size () / n;
+				Dense S (k_1 + k_2, n);
+
+				unpackBlock (rows, S, 0, k_1, 0, n);
+				unpackBlock (received, S, k_1, k_1 + k_2, 0, n);
+				EF.echelonize (S);
+				packNonzeroRows (S, rows);
+			}
+		}
+	}
+
+	if (_comm.isRoot ()) {
+		BLAS3::scal (ctx, ctx.F.zero (), D);
+		unpackBlock (rows, D, 0, rows.size () / n, 0, n);
+	}
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void DistributedFaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det)
+{
+	ActivityGuard guard;
+
+	commentator.start ("Distributed reduction of F4-matrix to reduced row-echelon form", __FUNCTION__);
+
+	std::ostream &reportUI = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
+
+	const int me = _comm.rank (), size = _comm.size ();
+	int p;
+
+	Splicer X_splicer, X_reconst_splicer;
+	size_t num_pivot_rows;
+
+	// A is k x k, B is k x n, C is m x k, and D is m x n
+	Sparse A;
+	Dense B, C, D;
+
+	unsigned long long dims[3] = { 0, 0, 0 };
+
+	ctx.F.copy (det, ctx.F.one ());
+
+	if (_comm.isRoot ()) {
+		commentator.traceArgument ("rows", X.rowdim ());
+		commentator.traceArgument ("cols", X.coldim ());
+		commentator.traceArgument ("processes", size);
+
+		commentator.start ("Profiling input-matrix", __FUNCTION__);
+		MatrixProfile profile (ctx, X);
+		commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+
+		// Reduce a copy whose rows are ordered, if those of X are not
+		std::vector<size_t> order;
+		Matrix Y;
+
+		if (_FL.order_rows (profile, order)) {
+			Y.resize (X.rowdim (), X.coldim ());
+			_FL.permute_rows (Y, X, order);
+			profile.compute (ctx, Y);
+		}
+
+		const Matrix &X_ordered = order.empty () ? X : Y;
+
+		_FL.setup_splicer (X_splicer, X_reconst_splicer, X_ordered, profile, num_pivot_rows, det);
+
+		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			<< "Found " << num_pivot_rows << " pivots" << std::endl;
+		reportUI << "Splicer:" << std::endl << X_splicer << std::endl;
+
+		A.resize (num_pivot_rows, num_pivot_rows);
+		B.resize (num_pivot_rows, X.coldim () - num_pivot_rows);
+		C.resize (X.rowdim () - num_pivot_rows, num_pivot_rows);
+		D.resize (X.rowdim () - num_pivot_rows, X.coldim () - num_pivot_rows);
+
+		X_splicer.splice (MatrixGrid1<Ring, const Matrix, Sparse, Dense> (ctx.F, X_ordered, A, B, C, D));
+
+		_FL.normalize_pivot_rows (A, B);
+
+		dims[0] = num_pivot_rows;
+		dims[1] = X.rowdim () - num_pivot_rows;
+		dims[2] = X.coldim () - num_pivot_rows;
+	}
+
+	MPITransfer::bcast (_comm, dims, 3, 0);
+
+	const size_t k = dims[0], m = dims[1], n = dims[2];
+	const size_t c_begin = _comm.partBegin (n, me), c_end = _comm.partEnd (n, me), w = c_end - c_begin;
+
+	rank = k;
+
+	// Broadcast the nonzero entries of A and C, send each process
+	// its columns of B and D
+
+	commentator.start ("Distributing blocks");
+
+	std::vector<uint64> A_row_sizes (k), A_indices, C_row_sizes (m), C_indices;
+	std::vector<Element> A_values, C_values, B_buf, D_buf;
+	std::vector<std::vector<Element> > B_out (size), D_out (size);
+	unsigned long long nnz[2] = { 0, 0 };
+	MPIRequests requests_A, requests_B, requests_C, requests_D;
+
+	if (_comm.isRoot ()) {
+		packSparse (A, A_row_sizes, A_indices, A_values);
+		packSparse (C, C_row_sizes, C_indices, C_values);
+		nnz[0] = A_indices.size ();
+		nnz[1] = C_indices.size ();
+	}
+
+	MPITransfer::bcast (_comm, nnz, 2, 0);
+
+	A_indices.resize (nnz[0]);
+	A_values.resize (nnz[0]);
+	C_indices.resize (nnz[1]);
+	C_values.resize (nnz[1]);
+
+	MPITransfer::ibcast (_comm, A_row_sizes.empty () ? NULL : &A_row_sizes[0], k, 0, requests_A);
+	MPITransfer::ibcast (_comm, A_indices.empty () ? NULL : &A_indices[0], nnz[0], 0, requests_A);
+	MPITransfer::ibcast (_comm, data (A_values), nnz[0], 0, requests_A);
+
+	MPITransfer::ibcast (_comm, C_row_sizes.empty () ? NULL : &C_row_sizes[0], m, 0, requests_C);
+	MPITransfer::ibcast (_comm, C_indices.empty () ? NULL : &C_indices[0], nnz[1], 0, requests_C);
+	MPITransfer::ibcast (_comm, data (C_values), nnz[1], 0, requests_C);
+
+	if (_comm.isRoot ()) {
+		for (p = 1; p < size; ++p) {
+			packBlock (B, 0, k, _comm.partBegin (n, p), _comm.partEnd (n, p), B_out[p]);
+			MPITransfer::isend (_comm, data (B_out[p]), B_out[p].size (), p, TAG_B, requests_B);
+			packBlock (D, 0, m, _comm.partBegin (n, p), _comm.partEnd (n, p), D_out[p]);
+			MPITransfer::isend (_comm, data (D_out[p]), D_out[p].size (), p, TAG_D, requests_D);
+		}
+
+		packBlock (B, 0, k, c_begin, c_end, B_buf);
+		packBlock (D, 0, m, c_begin, c_end, D_buf);
+	} else {
+		B_buf.resize (k * w);
+		MPITransfer::irecv (_comm, data (B_buf), B_buf.size (), 0, TAG_B, requests_B);
+		D_buf.resize (m * w);
+		MPITransfer::irecv (_comm, data (D_buf), D_buf.size (), 0, TAG_D, requests_D);
+	}
+
+	commentator.stop (MSG_DONE);
+
+	Dense B_local (k, w), D_local (m, w);
+
+	requests_A.wait ();
+	requests_B.wait ();
+
+	if (!_comm.isRoot ()) {
+		A.resize (k, k);
+		unpackSparse (A_row_sizes, A_indices, A_values, A);
+	}
+
+	unpackBlock (B_buf, B_local, 0, k, 0, w);
+
+	commentator.start ("Constructing A^-1 B");
+
+	if (k > 0 && w > 0)
+		BLAS3::trsm (ctx, ctx.F.one (), A, B_local, UpperTriangular, true);
+
+	commentator.stop (MSG_DONE);
+
+	requests_C.wait ();
+	requests_D.wait ();
+
+	if (!_comm.isRoot ()) {
+		C.resize (m, k);
+		unpackSparse (C_row_sizes, C_indices, C_values, C);
+	}
+
+	unpackBlock (D_buf, D_local, 0, m, 0, w);
+
+	commentator.start ("Constructing D - C A^-1 B");
+
+	if (k > 0 && m > 0 && w > 0)
+		BLAS3::gemm (ctx, ctx.F.minusOne (), C, B_local, ctx.F.one (), D_local);
+
+	commentator.stop (MSG_DONE);
+
+	// Return A^-1 B to the root while D - C A^-1 B is echelonised
+
+	std::vector<std::vector<Element> > B_in (size);
+	MPIRequests requests_B_result;
+
+	if (_comm.isRoot ()) {
+		for (p = 1; p < size; ++p) {
+			B_in[p].resize (k * (_comm.partEnd (n, p) - _comm.partBegin (n, p)));
+			MPITransfer::irecv (_comm, data (B_in[p]), B_in[p].size (), p, TAG_B_RESULT, requests_B_result);
+		}
+	} else {
+		packBlock (B_local, 0, k, 0, w, B_buf);
+		MPITransfer::isend (_comm, data (B_buf), B_buf.size (), 0, TAG_B_RESULT, requests_B_result);
+	}
+
+	commentator.start ("Row-echelon form of D - C A^-1 B");
+
+	echelonize_distributed (D, D_local, m, n);
+
+	commentator.stop (MSG_DONE);
+
+	requests_B_result.wait ();
+
+	// Split B and D by the pivots of D and compute D1^-1 D2 on the root
+
+	Splicer D_splicer, D_reconst_splicer;
+	Dense B1, B2, D1, D2;
+	unsigned long long dims_D[2] = { 0, 0 };
+
+	if (_comm.isRoot ()) {
+		packBlock (B_local, 0, k, 0, w, B_buf);
+		unpackBlock (B_buf, B, 0, k, c_begin, c_end);
+
+		for (p = 1; p < size; ++p)
+			unpackBlock (B_in[p], B, 0, k, _comm.partBegin (n, p), _comm.partEnd (n, p));
+
+		reportUI << "Row-echelon form of D - C A^-1 B:" << std::endl;
+		BLAS3::write (ctx, reportUI, D);
+
+		_FL.setup_splicer (D_splicer, D_reconst_splicer, D, MatrixProfile (ctx, D), num_pivot_rows, det);
+
+		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+			<< "(In D) found " << num_pivot_rows << " pivots" << std::endl;
+
+		B1.resize (k, num_pivot_rows);
+		B2.resize (k, n - num_pivot_rows);
+		D1.resize (num_pivot_rows, num_pivot_rows);
+		D2.resize (num_pivot_rows, n - num_pivot_rows);
+
+		Splicer B_splicer (D_splicer);
+		B_splicer.clearHorizontalBlocks ();
+		B_splicer.addHorizontalBlock (Block (0, 0, 0, 0, k));
+
+		B_splicer.splice (MatrixGrid2<Ring, Dense> (ctx.F, B, B1, B2));
+		D_splicer.splice (MatrixGrid2<Ring, Dense> (ctx.F, D, D1, D2));
+
+		commentator.start ("Constructing D1^-1 D2");
+
+		if (num_pivot_rows > 0 && n > num_pivot_rows)
+			BLAS3::trsm (ctx, ctx.F.one (), D1, D2, UpperTriangular, false);
+
+		commentator.stop (MSG_DONE);
+
+		dims_D[0] = num_pivot_rows;
+		dims_D[1] = n - num_pivot_rows;
+	}
+
+	MPITransfer::bcast (_comm, dims_D, 2, 0);
+
+	const size_t r_D = dims_D[0], n_2 = dims_D[1];
+	const size_t b_begin = _comm.partBegin (k, me), b_end = _comm.partEnd (k, me);
+
+	rank += r_D;
+
+	// Broadcast D1^-1 D2, send each process its rows of B1 and B2
+
+	std::vector<Element> D2_buf, B1_buf, B2_buf;
+	std::vector<std::vector<Element> > B1_out (size), B2_out (size);
+	MPIRequests requests_D2, requests_B12;
+
+	if (_comm.isRoot ())
+		packBlock (D2, 0, r_D, 0, n_2, D2_buf);
+	else
+		D2_buf.resize (r_D * n_2);
+
+	MPITransfer::ibcast (_comm, data (D2_buf), r_D * n_2, 0, requests_D2);
+
+	if (_comm.isRoot ()) {
+		for (p = 1; p < size; ++p) {
+			packBlock (B1, _comm.partBegin (k, p), _comm.partEnd (k, p), 0, r_D, B1_out[p]);
+			MPITransfer::isend (_comm, data (B1_out[p]), B1_out[p].size (), p, TAG_B1, requests_B12);
+			packBlock (B2, _comm.partBegin (k, p), _comm.partEnd (k, p), 0, n_2, B2_out[p]);
+			MPITransfer::isend (_comm, data (B2_out[p]), B2_out[p].size (), p, TAG_B2, requests_B12);
+		}
+
+		packBlock (B1, b_begin, b_end, 0, r_D, B1_buf);
+		packBlock (B2, b_begin, b_end, 0, n_2, B2_buf);
+	} else {
+		B1_buf.resize ((b_end - b_begin) * r_D);
+		MPITransfer::irecv (_comm, data (B1_buf), B1_buf.size (), 0, TAG_B1, requests_B12);
+		B2_buf.resize ((b_end - b_begin) * n_2);
+		MPITransfer::irecv (_comm, data (B2_buf), B2_buf.size (), 0, TAG_B2, requests_B12);
+	}
+
+	Dense X_2 (r_D, n_2), B1_local (b_end - b_begin, r_D), B2_local (b_end - b_begin, n_2);
+
+	requests_D2.wait ();
+	requests_B12.wait ();
+
+	unpackBlock (D2_buf, X_2, 0, r_D, 0, n_2);
+	unpackBlock (B1_buf, B1_local, 0, b_end - b_begin, 0, r_D);
+	unpackBlock (B2_buf, B2_local, 0, b_end - b_begin, 0, n_2);
+
+	commentator.start ("Constructing B2 - B1 D1^-1 D2");
+
+	if (b_end > b_begin && r_D > 0 && n_2 > 0)
+		BLAS3::gemm (ctx, ctx.F.minusOne (), B1_local, X_2, ctx.F.one (), B2_local);
+
+	commentator.stop (MSG_DONE);
+
+	// Collect B2 - B1 D1^-1 D2 on the root and reconstruct
+
+	MPIRequests requests_B2;
+
+	if (_comm.isRoot ()) {
+		std::vector<std::vector<Element> > B2_in (size);
+
+		for (p = 1; p < size; ++p) {
+			B2_in[p].resize ((_comm.partEnd (k, p) - _comm.partBegin (k, p)) * n_2);
+			MPITransfer::irecv (_comm, data (B2_in[p]), B2_in[p].size (), p, TAG_B2_RESULT, requests_B2);
+		}
+
+		requests_B2.wait ();
+
+		for (p = 1; p < size; ++p)
+			unpackBlock (B2_in[p], B2, _comm.partBegin (k, p), _comm.partEnd (k, p), 0, n_2);
+
+		packBlock (B2_local, 0, b_end - b_begin, 0, n_2, B2_buf);
+		unpackBlock (B2_buf, B2, b_begin, b_end, 0, n_2);
+
+		reportUI << "B2 - B1 D1^-1 D2:" << std::endl;
+		BLAS3::write (ctx, reportUI, B2);
+
+		Splicer composed_splicer, subst_splicer, D_splicer_rev;
+
+		D_splicer.reverse (D_splicer_rev);
+		X_reconst_splicer.compose (subst_splicer, D_reconst_splicer, 1, Splicer::noSource, 0, Splicer::noSource);
+		subst_splicer.removeGaps ();
+		subst_splicer.consolidate ();
+		subst_splicer.compose (composed_splicer, D_splicer_rev, 1, 1);
+		composed_splicer.fillHorizontal (2, 0, X.rowdim ());
+
+		reportUI << "Composed splicer:" << std::endl << composed_splicer << std::endl;
+
+		BLAS3::scal (ctx, ctx.F.zero (), R);
+
+		composed_splicer.splice (MatrixGrid3<Ring, Dense, Matrix> (ctx.F, B2, D2, R));
+	} else {
+		packBlock (B2_local, 0, b_end - b_begin, 0, n_2, B2_buf);
+		MPITransfer::isend (_comm, data (B2_buf), B2_buf.size (), 0, TAG_B2_RESULT, requests_B2);
+		requests_B2.wait ();
+	}
+
+	commentator.traceArgument ("rank", rank);
+	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+}
+
+} // namespace LELA
+
+#endif // __LELA_ALGORITHMS_FAUGERE_LACHARTRE_MPI_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -15,9 +15,12 @@
 #ifndef __LELA_ALGORITHMS_FAUGERE_LACHARTRE_H
 #define __LELA_ALGORITHMS_FAUGERE_LACHARTRE_H
 
+#include <vector>
+
 #include "lela/blas/context.h"
 #include "lela/algorithms/gauss-jordan.h"
 #include "lela/util/splicer.h"
+#include "lela/matrix/profile.h"
 
 namespace LELA
 {
@@ -26,6 +29,55 @@ namespace LELA
 template <class Ring, class Modules>
 class EchelonForm;
 
+/**
+ * \brief Symbolic plan of a reduction by @ref FaugereLachartre
+ *
+ * Records the structural decisions made in reducing one matrix: the
+ * pivot-rows of the input, the splicers cutting it into blocks, the
+ * pivots chosen in the elimination of the residual block, and the
+ * splicer assembling the result. In multi-modular computations the
+ * same matrix is reduced modulo many primes; FaugereLachartre::replay
+ * reduces it modulo further primes by following the plan, without
+ * searching for pivots.
+ *
+ * A plan does not refer to the ring, so a plan recorded over one
+ * prime may be replayed over another.
+ *
+ * \ingroup algorithms
+ */
+class FaugereLachartrePlan
+{
+	template <class Ring, class Modules> friend class FaugereLachartre;
+
+	bool _valid;
+	size_t _rowdim, _coldim, _rank;
+
+	// Pivots of the input and of the residual block after elimination
+	PivotSequence _X_pivots, _D_pivots;
+
+	// Pivots chosen during elimination of the residual block
+	PivotSequence _D_elimination;
+
+	Splicer _X_splicer, _D_splicer, _composed_splicer;
+
+	// Order in which the rows of the input are reduced; empty if
+	// they are already ordered by leading column
+	std::vector<size_t> _row_order;
+
+public:
+	/// Construct an empty plan
+	FaugereLachartrePlan () : _valid (false), _rowdim (0), _coldim (0), _rank (0) {}
+
+	/// true if the plan has been recorded
+	bool valid () const { return _valid; }
+
+	/// Rank of the matrix from which the plan was recorded
+	size_t rank () const { return _rank; }
+
+	/// Discard the plan
+	void clear () { *this = FaugereLachartrePlan (); }
+};
+
 /**
  * \brief Implementation of algorithm for computing reduced row-echelon form
  * of a matrix coming from the F4-algorithm
@@ -35,15 +87,68 @@ class EchelonForm;
  * Elimination for Gröbner bases computations in finite
  * fields", PASCO 2010.
  *
+ * The algorithm takes the first row with each leading column as a
+ * pivot-row, which requires the rows of the input to be ordered by
+ * leading column with zero rows last, as the matrices arising in F4
+ * are. Other matrices are reduced correctly as well, but through a
+ * copy whose rows are in that order.
+ *
+ * The phases of the reduction are reported as activities of the
+ * @ref commentator. Splicing the blocks C and D overlaps with
+ * constructing A^-1 B, and splicing B with splicing D and constructing
+ * D1^-1 D2, through an @ref Executor. When built with OpenMP, each
+ * splice runs on one thread and the triangular solve on the remaining
+ * ones. The overlapping operations run with the commentator muted, so
+ * the activities within those two phases are not reported and their
+ * time is included in that of the phase; if a trace is being
+ * recorded, each operation appears in it as one activity on the
+ * thread which ran it.
+ *
  * \ingroup algorithms
  */
 template <class Ring, class Modules = AllModules<Ring> >
 class FaugereLachartre {
+	template <class R, class M> friend class DistributedFaugereLachartre;
+
 	Context<Ring, Modules> &ctx;
 	EchelonForm<Ring, Modules> EF;
 
 	template <class Matrix>
-	void setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, size_t &num_pivot_rows, typename Ring::Element &det) const;
+	void setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, const MatrixProfile &profile,
+			    size_t &num_pivot_rows, typename Ring::Element &det, PivotSequence *pivots = NULL) const;
+
+	// Compute into order the rows of a matrix with the given
+	// profile, ordered by leading column with zero rows last, as
+	// setup_splicer requires. Returns false if the rows are
+	// already in that order.
+	static bool order_rows (const MatrixProfile &profile, std::vector<size_t> &order);
+
+	// Copy row order[i] of X to row i of Y
+	template <class Matrix>
+	void permute_rows (Matrix &Y, const Matrix &X, const std::vector<size_t> &order) const;
+
+	// Multiply det by the planned pivots of A, throwing
+	// PlanMismatch if any of them is not the leading entry of
+	// its row
+	template <class Matrix>
+	void check_pivots (const Matrix &A, const PivotSequence &pivots, typename Ring::Element &det) const;
+
+	// Reduction proper: if plan_in is given, follow it; if
+	// plan_out is given, record the plan into it. Reduces a copy
+	// of X with its rows ordered if they are not.
+	template <class Matrix>
+	void reduce (Matrix &R, const Matrix &X, const MatrixProfile *profile, size_t &rank, typename Ring::Element &det,
+		     const FaugereLachartrePlan *plan_in, FaugereLachartrePlan *plan_out);
+
+	// As reduce, for X whose rows are ordered by leading column
+	template <class Matrix>
+	void reduce_ordered (Matrix &R, const Matrix &X, const MatrixProfile *profile, size_t &rank, typename Ring::Element &det,
+			     const FaugereLachartrePlan *plan_in, FaugereLachartrePlan *plan_out);
+
+	// Scale the rows of A and B so that A has unit diagonal,
+	// inverting all pivots of A at once
+	template <class Matrix1, class Matrix2>
+	void normalize_pivot_rows (Matrix1 &A, Matrix2 &B) const;
 
 public:
 	/**
@@ -73,6 +178,60 @@ public:
 	 */
 	template <class Matrix>
 	void echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det);
+
+	/**
+	 * \brief Convert the matrix A into reduced
+	 * row-echelon form, using a precomputed profile of X
+	 *
+	 * As above, but the pivot-rows are located from the
+	 * given @ref MatrixProfile rather than by scanning X,
+	 * so that a caller which has already profiled X does
+	 * not pay for it twice.
+	 *
+	 * @param profile Profile of X; must be up to date
+	 */
+	template <class Matrix>
+	void echelonize (Matrix &R, const Matrix &X, const MatrixProfile &profile, size_t &rank, typename Ring::Element &det);
+
+	/**
+	 * \brief Convert the matrix A into reduced
+	 * row-echelon form, recording a plan
+	 *
+	 * As above, and records into plan the structure of the
+	 * reduction, so that matrices of the same structure can
+	 * be reduced with @ref replay.
+	 *
+	 * @param plan Plan into which to record; its previous
+	 * contents are discarded
+	 */
+	template <class Matrix>
+	void echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det, FaugereLachartrePlan &plan);
+
+	/**
+	 * \brief Convert the matrix A into reduced row-echelon
+	 * form by following a recorded plan
+	 *
+	 * Reduces X with the pivots and splicers recorded in
+	 * plan, without searching for pivots. The checks made
+	 * are that the dimensions agree, that each planned
+	 * pivot is the leading entry of its row, and that the
+	 * elimination of the residual block requests exactly
+	 * the planned pivots. These detect primes for which
+	 * the rank drops, e.g. because a pivot vanishes, so
+	 * the plan should be recorded modulo a prime giving
+	 * the maximal rank. On a mismatch, falls back to @ref
+	 * echelonize without a plan.
+	 *
+	 * Parameters are as in @ref echelonize.
+	 *
+	 * @param plan Plan recorded from a matrix of the same
+	 * structure
+	 *
+	 * @returns true if the plan was followed, false if the
+	 * matrix did not match and was reduced from scratch
+	 */
+	template <class Matrix>
+	bool replay (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det, const FaugereLachartrePlan &plan);
 };
 
 } // namespace LELA
@@ -15,9 +15,13 @@
 #ifndef __LELA_ALGORITHMS_FAUGERE_LACHARTRE_TCC
 #define __LELA_ALGORITHMS_FAUGERE_LACHARTRE_TCC
 
+#include <vector>
+
 #include "lela/algorithms/faugere-lachartre.h"
 #include "lela/blas/level1.h"
 #include "lela/blas/level3.h"
+#include "lela/blas/level3-async.h"
+#include "lela/blas/level3-expr.h"
 #include "lela/solutions/echelon-form.h"
 #include "lela/solutions/echelon-form-gf2.h"
 
@@ -34,20 +38,26 @@ FaugereLachartre<Ring, Modules>::FaugereLachartre (Context<Ring, Modules> &_ctx)
 
 template <class Ring, class Modules>
 template <class Matrix>
-void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, size_t &num_pivot_rows, typename Ring::Element &det) const
+void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &reconst_splicer, const Matrix &A, const MatrixProfile &profile,
+						     size_t &num_pivot_rows, typename Ring::Element &det, PivotSequence *pivots) const
 {
+	lela_check (profile.rowdim () == A.rowdim ());
+	lela_check (profile.coldim () == A.coldim ());
+
+	ActivityGuard guard;
+
 	commentator.start ("Finding pivot-rows", __FUNCTION__);
 
 	typename Matrix::ConstRowIterator i_A;
-	int last_col = -1, col, first_col_in_block = 0, height = 0, dest_col_tr = 0, dest_col_res = 0;
-	int row = 0, first_row_in_block = 0, dest_row_tr = 0, dest_row_res = 0;
+	long last_col = -1, col, first_col_in_block = 0, height = 0, dest_col_tr = 0, dest_col_res = 0;
+	long row = 0, first_row_in_block = 0, dest_row_tr = 0, dest_row_res = 0;
 	bool last_was_same_col = false;
 	typename Ring::Element a;
 
 	num_pivot_rows = 0;
 
 	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A, ++row) {
-		col = BLAS1::head (ctx, a, *i_A);
+		col = profile.leadingColumn (row);
 
 		if (col == -1) {
 			if (!last_was_same_col) {
@@ -73,6 +83,9 @@ void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &
 				last_was_same_col = false;
 			}
 
+			if (pivots != NULL)
+				pivots->push_back (PivotSequence::value_type (row, col));
+
 			if (col == last_col + 1) {
 				last_col = col;
 				++height;
@@ -102,6 +115,9 @@ void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &
 			}
 		}
 
+		if (!VectorUtils::getEntry (*i_A, a, col))
+			throw PreconditionFailed (__FUNCTION__, __LINE__, "profile does not match matrix");
+
 		ctx.F.mulin (det, a);
 	}
 
@@ -113,7 +129,7 @@ void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &
 		reconst_splicer.addHorizontalBlock (newblock);
 	}
 
-	if (first_col_in_block + height < (int) A.coldim ()) {
+	if (first_col_in_block + height < (long) A.coldim ()) {
 		Block newblock (1, 0, dest_col_res, first_col_in_block + height, A.coldim () - first_col_in_block - height);
 				
 		splicer.addVerticalBlock (Block (0, 1, first_col_in_block + height, dest_col_res, A.coldim () - first_col_in_block - height));
@@ -121,8 +137,8 @@ void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &
 		reconst_splicer.addHorizontalBlock (newblock);
 	}
 
-	if (first_row_in_block < (int) A.rowdim ()) {
-		if (row < (int) A.rowdim () || last_was_same_col)
+	if (first_row_in_block < (long) A.rowdim ()) {
+		if (row < (long) A.rowdim () || last_was_same_col)
 			splicer.addHorizontalBlock (Block (0, 1, first_row_in_block, dest_row_res, A.rowdim () - first_row_in_block));
 		else
 			splicer.addHorizontalBlock (Block (0, 0, first_row_in_block, dest_row_tr, A.rowdim () - first_row_in_block));
@@ -131,6 +147,71 @@ void FaugereLachartre<Ring, Modules>::setup_splicer (Splicer &splicer, Splicer &
 	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
 }
 
+template <class Ring, class Modules>
+bool FaugereLachartre<Ring, Modules>::order_rows (const MatrixProfile &profile, std::vector<size_t> &order)
+{
+	const std::vector<MatrixProfile::SignedIndex> &lead = profile.leadingColumns ();
+	size_t i, n = profile.coldim ();
+
+	// Zero rows sort after all columns
+	std::vector<size_t> key (lead.size ());
+
+	for (i = 0; i < lead.size (); ++i)
+		key[i] = (lead[i] == -1) ? n : (size_t) lead[i];
+
+	for (i = 1; i < key.size (); ++i)
+		if (key[i] < key[i - 1])
+			break;
+
+	if (i >= key.size ())
+		return false;
+
+	// Stable counting-sort by leading column
+
+	std::vector<size_t> start (n + 2, 0);
+
+	for (i = 0; i < key.size (); ++i)
+		++start[key[i] + 1];
+
+	for (i = 1; i < start.size (); ++i)
+		start[i] += start[i - 1];
+
+	order.resize (key.size ());
+
+	for (i = 0; i < key.size (); ++i)
+		order[start[key[i]]++] = i;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::permute_rows (Matrix &Y, const Matrix &X, const std::vector<size_t> &order) const
+{
+	typename Matrix::RowIterator i_Y;
+	size_t i;
+
+	for (i_Y = Y.rowBegin (), i = 0; i_Y != Y.rowEnd (); ++i_Y, ++i)
+		BLAS1::copy (ctx, *(X.rowBegin () + order[i]), *i_Y);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::check_pivots (const Matrix &A, const PivotSequence &pivots, typename Ring::Element &det) const
+{
+	PivotSequence::const_iterator i;
+	typename Ring::Element a;
+
+	ctx.F.copy (a, ctx.F.zero ());
+
+	for (i = pivots.begin (); i != pivots.end (); ++i) {
+		if (BLAS1::head (ctx, a, *(A.rowBegin () + i->first)) != (long) i->second)
+			throw PlanMismatch ("Planned pivot is not the leading entry of its row");
+
+		ctx.F.mulin (det, a);
+	}
+}
+
 template <class Ring, class Matrix1, class Matrix2, class Matrix3>
 class MatrixGrid1
 {
@@ -138,14 +219,21 @@ class MatrixGrid1
 	Matrix1 &X;
 	Matrix2 &A;
 	Matrix3 &B, &C, &D;
+	unsigned int only_horiz_dest;
 
 public:
-	MatrixGrid1 (const Ring &__R, Matrix1 &__X, Matrix2 &__A, Matrix3 &__B, Matrix3 &__C, Matrix3 &__D)
-		: R (__R), X (__X), A (__A), B (__B), C (__C), D (__D)
+	// If only_horiz_dest is not Splicer::noSource, then only the
+	// pivot-rows (0) or only the remaining rows (1) are copied
+	MatrixGrid1 (const Ring &__R, Matrix1 &__X, Matrix2 &__A, Matrix3 &__B, Matrix3 &__C, Matrix3 &__D,
+		     unsigned int __only_horiz_dest = Splicer::noSource)
+		: R (__R), X (__X), A (__A), B (__B), C (__C), D (__D), only_horiz_dest (__only_horiz_dest)
 		{}
 
 	void operator () (const Block &horiz_block, const Block &vert_block)
 	{
+		if (only_horiz_dest != Splicer::noSource && horiz_block.dest () != only_horiz_dest)
+			return;
+
 		if (horiz_block.dest () == 0) {
 			if (vert_block.dest () == 0)
 				Splicer::copyBlock (R, X, A, horiz_block, vert_block);
@@ -211,6 +299,23 @@ public:
 	}
 };
 
+// Operation splicing a matrix, for submission to an Executor
+
+template <class Grid>
+class SpliceOperation
+{
+	const Splicer &splicer;
+	Grid grid;
+
+public:
+	SpliceOperation (const Splicer &__splicer, const Grid &__grid)
+		: splicer (__splicer), grid (__grid)
+		{}
+
+	void operator () ()
+		{ splicer.splice (grid); }
+};
+
 template <class Ring>
 struct DefaultSparseMatrix
 {
@@ -223,11 +328,154 @@ struct DefaultSparseMatrix<GF2>
 	typedef SparseMatrix<bool, Vector<GF2>::Sparse> Type;
 };
 
+template <class Ring, class Modules>
+template <class Matrix1, class Matrix2>
+void FaugereLachartre<Ring, Modules>::normalize_pivot_rows (Matrix1 &A, Matrix2 &B) const
+{
+	ActivityGuard guard;
+
+	commentator.start ("Normalising pivot-rows", __FUNCTION__);
+
+	std::vector<typename Ring::Element> pivots (A.rowdim ());
+	typename Ring::Element a;
+	typename Matrix1::RowIterator i_A;
+	typename Matrix2::RowIterator i_B;
+	size_t i;
+
+	ctx.F.copy (a, ctx.F.zero ());
+
+	for (i_A = A.rowBegin (), i = 0; i_A != A.rowEnd (); ++i_A, ++i) {
+		BLAS1::head (ctx, a, *i_A);
+		ctx.F.copy (pivots[i], a);
+	}
+
+	if (!ctx.F.invBatch (pivots.begin (), pivots.begin (), pivots.end ()))
+		throw LELAError ("Could not invert pivot-element in the ring");
+
+	for (i_A = A.rowBegin (), i_B = B.rowBegin (), i = 0; i_A != A.rowEnd (); ++i_A, ++i_B, ++i) {
+		if (!ctx.F.isOne (pivots[i])) {
+			BLAS1::scal (ctx, pivots[i], *i_A);
+			BLAS1::scal (ctx, pivots[i], *i_B);
+		}
+	}
+
+	commentator.stop (MSG_DONE);
+}
+
 template <class Ring, class Modules>
 template <class Matrix>
 void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det)
 {
+	ActivityGuard guard;
+
+	commentator.start ("Profiling input-matrix", __FUNCTION__);
+	MatrixProfile profile (ctx, X);
+	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+
+	echelonize (R, X, profile, rank, det);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, const MatrixProfile &profile, size_t &rank, typename Ring::Element &det)
+{
+	reduce (R, X, &profile, rank, det, NULL, NULL);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det, FaugereLachartrePlan &plan)
+{
+	ActivityGuard guard;
+
+	commentator.start ("Profiling input-matrix", __FUNCTION__);
+	MatrixProfile profile (ctx, X);
+	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+
+	plan.clear ();
+	reduce (R, X, &profile, rank, det, NULL, &plan);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+bool FaugereLachartre<Ring, Modules>::replay (Matrix &R, const Matrix &X, size_t &rank, typename Ring::Element &det, const FaugereLachartrePlan &plan)
+{
+	lela_check (plan.valid ());
+
+	ActivityGuard guard;
+
+	commentator.start ("Reduction of F4-matrix following plan", __FUNCTION__);
+
+	ActivityState state = commentator.saveActivityState ();
+	bool followed = true;
+
+	try {
+		if (X.rowdim () != plan._rowdim || X.coldim () != plan._coldim)
+			throw PlanMismatch ("Dimensions of matrix differ from those in plan");
+
+		reduce (R, X, (const MatrixProfile *) NULL, rank, det, &plan, (FaugereLachartrePlan *) NULL);
+	}
+	catch (PlanMismatch &e) {
+		commentator.restoreActivityState (state);
+		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_WARNING)
+			<< "Matrix does not match plan, reducing without plan: " << e;
+
+		echelonize (R, X, rank, det);
+		followed = false;
+	}
+
+	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+
+	return followed;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::reduce (Matrix &R, const Matrix &X, const MatrixProfile *profile, size_t &rank, typename Ring::Element &det,
+					       const FaugereLachartrePlan *plan_in, FaugereLachartrePlan *plan_out)
+{
+	std::vector<size_t> order;
+
+	if (plan_in != NULL)
+		order = plan_in->_row_order;
+	else if (!order_rows (*profile, order))
+		order.clear ();
+
+	if (order.empty ()) {
+		reduce_ordered (R, X, profile, rank, det, plan_in, plan_out);
+		return;
+	}
+
+	ActivityGuard guard;
+
+	commentator.start ("Ordering rows by leading column", __FUNCTION__);
+
+	Matrix Y (X.rowdim (), X.coldim ());
+	permute_rows (Y, X, order);
+
+	MatrixProfile Y_profile;
+
+	if (plan_in == NULL)
+		Y_profile.compute (ctx, Y);
+
+	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
+
+	reduce_ordered (R, Y, (plan_in == NULL) ? &Y_profile : (const MatrixProfile *) NULL, rank, det, plan_in, plan_out);
+
+	if (plan_out != NULL)
+		plan_out->_row_order = order;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+void FaugereLachartre<Ring, Modules>::reduce_ordered (Matrix &R, const Matrix &X, const MatrixProfile *profile, size_t &rank, typename Ring::Element &det,
+						       const FaugereLachartrePlan *plan_in, FaugereLachartrePlan *plan_out)
+{
+	ActivityGuard guard;
+
 	commentator.start ("Reduction of F4-matrix to reduced row-echelon form", __FUNCTION__);
+	commentator.traceArgument ("rows", X.rowdim ());
+	commentator.traceArgument ("cols", X.coldim ());
 
 	std::ostream &reportUI = commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
 
@@ -237,7 +485,14 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 
 	ctx.F.copy (det, ctx.F.one ());
 
-	setup_splicer (X_splicer, X_reconst_splicer, X, num_pivot_rows, det);
+	if (plan_in != NULL) {
+		check_pivots (X, plan_in->_X_pivots, det);
+		X_splicer = plan_in->_X_splicer;
+		num_pivot_rows = plan_in->_X_pivots.size ();
+	} else
+		setup_splicer (X_splicer, X_reconst_splicer, X, *profile, num_pivot_rows, det,
+			       (plan_out != NULL) ? &plan_out->_X_pivots : NULL);
+
 	rank = num_pivot_rows;
 
 	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
@@ -249,16 +504,18 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	DenseMatrix<typename Ring::Element> C (X.rowdim () - num_pivot_rows, num_pivot_rows);
 	DenseMatrix<typename Ring::Element> D (X.rowdim () - num_pivot_rows, X.coldim () - num_pivot_rows);
 
-	X_splicer.splice (MatrixGrid1<Ring, const Matrix, typename DefaultSparseMatrix<Ring>::Type, DenseMatrix<typename Ring::Element> > (ctx.F, X, A, B, C, D));
+	typedef MatrixGrid1<Ring, const Matrix, typename DefaultSparseMatrix<Ring>::Type, DenseMatrix<typename Ring::Element> > Grid1;
+	typedef MatrixGrid2<Ring, DenseMatrix<typename Ring::Element> > Grid2;
+
+	// The pivot-rows are spliced first, so that constructing A^-1 B
+	// may overlap with splicing the remaining rows into C and D
+
+	X_splicer.splice (Grid1 (ctx.F, X, A, B, C, D, 0));
 
 	reportUI << "Matrix A:" << std::endl;
 	BLAS3::write (ctx, reportUI, A);
 	reportUI << "Matrix B:" << std::endl;
 	BLAS3::write (ctx, reportUI, B);
-	reportUI << "Matrix C:" << std::endl;
-	BLAS3::write (ctx, reportUI, C);
-	reportUI << "Matrix D:" << std::endl;
-	BLAS3::write (ctx, reportUI, D);
 
 	// std::ofstream Aout ("A.png");
 	// BLAS3::write (ctx, Aout, A, FORMAT_PNG);
@@ -269,15 +526,43 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	// std::ofstream Dout ("D.png");
 	// BLAS3::write (ctx, Dout, D, FORMAT_PNG);
 
+	normalize_pivot_rows (A, B);
+
+	reportOperationCounts (ctx.F, "splicing and normalisation");
+
+	ctx.checkCancelled ();
+
 	commentator.start ("Constructing A^-1 B");
 
-	BLAS3::trsm (ctx, ctx.F.one (), A, B, UpperTriangular, false);
+	// Splicing does not use OpenMP, so it keeps only one thread and
+	// the triangular solve runs on the others
+
+	{
+		Executor executor;
+
+		Future CD_spliced = executor.submit ("Splicing C and D", AsyncTask::SERIAL,
+						     SpliceOperation<Grid1> (X_splicer, Grid1 (ctx.F, X, A, B, C, D, 1)));
+		Future AB_solved = BLAS3::async::trsm (ctx, executor, ctx.F.one (), A, B, UpperTriangular, true);
+
+		whenAll (CD_spliced, AB_solved).wait ();
+	}
+
+	reportOperationCounts (ctx.F, "A^-1 B");
 
 	commentator.stop (MSG_DONE);
 
+	reportUI << "Matrix C:" << std::endl;
+	BLAS3::write (ctx, reportUI, C);
+	reportUI << "Matrix D:" << std::endl;
+	BLAS3::write (ctx, reportUI, D);
+
+	ctx.checkCancelled ();
+
 	commentator.start ("Constructing D - C A^-1 B");
 
-	BLAS3::gemm (ctx, ctx.F.minusOne (), C, B, ctx.F.one (), D);
+	BLAS3::assign (ctx, D, BLAS3::lazy (D) - BLAS3::lazy (C) * BLAS3::lazy (B));
+
+	reportOperationCounts (ctx.F, "D - C A^-1 B");
 
 	commentator.stop (MSG_DONE);
 
@@ -294,7 +579,31 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 
 	// size_t r_D;
 
-	EF.echelonize (D);
+	ctx.checkCancelled ();
+
+	if (plan_in == NULL && plan_out == NULL)
+		EF.echelonize (D);
+	else {
+		// Recording and replaying the choice of pivots needs a
+		// pivot-strategy, which only GaussJordan accepts
+		GaussJordan<Ring, Modules> GJ (ctx);
+		typename GaussJordan<Ring, Modules>::Permutation P;
+		size_t r_D, position = 0;
+		typename Ring::Element d_D;
+		typedef typename DefaultPivotStrategy<Ring, Modules, typename DenseMatrix<typename Ring::Element>::Row>::Strategy Strategy;
+
+		if (plan_in != NULL) {
+			GJ.echelonize (D, P, r_D, d_D, PlannedPivotStrategy<Ring, Modules> (ctx, plan_in->_D_elimination, position));
+
+			if (position != plan_in->_D_elimination.size ())
+				throw PlanMismatch ("Residual block requires fewer pivots than planned");
+		} else
+			GJ.echelonize (D, P, r_D, d_D, RecordingPivotStrategy<Strategy> (Strategy (ctx), plan_out->_D_elimination));
+
+		Elimination<Ring, Modules> (ctx).move_L (D, D);
+	}
+
+	reportOperationCounts (ctx.F, "row-echelon form of D - C A^-1 B");
 
 	reportUI << "Row-echelon form of D - C A^-1 B:" << std::endl;
 	BLAS3::write (ctx, reportUI, D);
@@ -304,7 +613,14 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 
 	Splicer D_splicer, D_reconst_splicer;
 
-	setup_splicer (D_splicer, D_reconst_splicer, D, num_pivot_rows, det);
+	if (plan_in != NULL) {
+		check_pivots (D, plan_in->_D_pivots, det);
+		D_splicer = plan_in->_D_splicer;
+		num_pivot_rows = plan_in->_D_pivots.size ();
+	} else
+		setup_splicer (D_splicer, D_reconst_splicer, D, MatrixProfile (ctx, D), num_pivot_rows, det,
+			       (plan_out != NULL) ? &plan_out->_D_pivots : NULL);
+
 	rank += num_pivot_rows;
 
 	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
@@ -320,8 +636,25 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	B_splicer.clearHorizontalBlocks ();
 	B_splicer.addHorizontalBlock (Block (0, 0, 0, 0, B.rowdim ()));
 
-	B_splicer.splice (MatrixGrid2<Ring, DenseMatrix<typename Ring::Element> > (ctx.F, B, B1, B2));
-	D_splicer.splice (MatrixGrid2<Ring, DenseMatrix<typename Ring::Element> > (ctx.F, D, D1, D2));
+	ctx.checkCancelled ();
+
+	commentator.start ("Constructing D1^-1 D2");
+
+	// Splicing B overlaps with splicing D and constructing D1^-1 D2
+
+	{
+		Executor executor;
+
+		Future B_spliced = executor.submit ("Splicing B", AsyncTask::SERIAL, SpliceOperation<Grid2> (B_splicer, Grid2 (ctx.F, B, B1, B2)));
+		Future D_spliced = executor.submit ("Splicing D", AsyncTask::SERIAL, SpliceOperation<Grid2> (D_splicer, Grid2 (ctx.F, D, D1, D2)));
+		Future D2_solved = BLAS3::async::trsm (ctx, executor, ctx.F.one (), D1, D2, UpperTriangular, false, D_spliced);
+
+		whenAll (B_spliced, D2_solved).wait ();
+	}
+
+	reportOperationCounts (ctx.F, "D1^-1 D2");
+
+	commentator.stop (MSG_DONE);
 
 	reportUI << "Matrix B1:" << std::endl;
 	BLAS3::write (ctx, reportUI, B1);
@@ -329,40 +662,58 @@ void FaugereLachartre<Ring, Modules>::echelonize (Matrix &R, const Matrix &X, si
 	BLAS3::write (ctx, reportUI, B2);
 	reportUI << "Matrix D1:" << std::endl;
 	BLAS3::write (ctx, reportUI, D1);
-	reportUI << "Matrix D2:" << std::endl;
+	reportUI << "D1^-1 D2:" << std::endl;
 	BLAS3::write (ctx, reportUI, D2);
 
-	commentator.start ("Constructing D1^-1 D2");
-
-	BLAS3::trsm (ctx, ctx.F.one (), D1, D2, UpperTriangular, false);
-
-	commentator.stop (MSG_DONE);
+	ctx.checkCancelled ();
 
 	commentator.start ("Constructing B2 - B1 D1^-1 D2");
 
-	BLAS3::gemm (ctx, ctx.F.minusOne (), B1, D2, ctx.F.one (), B2);
+	BLAS3::assign (ctx, B2, BLAS3::lazy (B2) - BLAS3::lazy (B1) * BLAS3::lazy (D2));
+
+	reportOperationCounts (ctx.F, "B2 - B1 D1^-1 D2");
 
 	commentator.stop (MSG_DONE);
 
 	reportUI << "B2 - B1 D1^-1 D2:" << std::endl;
 	BLAS3::write (ctx, reportUI, B2);
 
-	Splicer composed_splicer, subst_splicer, D_splicer_rev;
+	Splicer composed_splicer;
+
+	if (plan_in != NULL)
+		composed_splicer = plan_in->_composed_splicer;
+	else {
+		Splicer subst_splicer, D_splicer_rev;
 
-	D_splicer.reverse (D_splicer_rev);
-	X_reconst_splicer.compose (subst_splicer, D_reconst_splicer, 1, Splicer::noSource, 0, Splicer::noSource);
-	subst_splicer.removeGaps ();
-	subst_splicer.consolidate ();
-	subst_splicer.compose (composed_splicer, D_splicer_rev, 1, 1);
-	composed_splicer.fillHorizontal (2, 0, X.rowdim ());
+		D_splicer.reverse (D_splicer_rev);
+		X_reconst_splicer.compose (subst_splicer, D_reconst_splicer, 1, Splicer::noSource, 0, Splicer::noSource);
+		subst_splicer.removeGaps ();
+		subst_splicer.consolidate ();
+		subst_splicer.compose (composed_splicer, D_splicer_rev, 1, 1);
+		composed_splicer.fillHorizontal (2, 0, X.rowdim ());
+
+		reportUI << "Splicer after substitution:" << std::endl << subst_splicer << std::endl;
+	}
 
-	reportUI << "Splicer after substitution:" << std::endl << subst_splicer << std::endl;
 	reportUI << "Composed splicer:" << std::endl << composed_splicer << std::endl;
 
+	if (plan_out != NULL) {
+		plan_out->_rowdim = X.rowdim ();
+		plan_out->_coldim = X.coldim ();
+		plan_out->_rank = rank;
+		plan_out->_X_splicer = X_splicer;
+		plan_out->_D_splicer = D_splicer;
+		plan_out->_composed_splicer = composed_splicer;
+		plan_out->_valid = true;
+	}
+
 	BLAS3::scal (ctx, ctx.F.zero (), R);
 
 	composed_splicer.splice (MatrixGrid3<Ring, DenseMatrix<typename Ring::Element>, Matrix> (ctx.F, B2, D2, R));
 
+	reportOperationCounts (ctx.F, "reconstruction");
+
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE, NULL, __FUNCTION__);
 }
 
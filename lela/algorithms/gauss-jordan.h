@@ -17,6 +17,8 @@
 #include "lela/util/commentator.h"
 #include "lela/util/timer.h"
 #include "lela/blas/context.h"
+#include "lela/util/index.h"
+#include "lela/ring/interface.h"
 #include "lela/ring/gf2.h"
 #include "lela/matrix/dense.h"
 #include "lela/matrix/sparse.h"
@@ -34,7 +36,7 @@ class GaussJordan
 {
 public:
 	typedef typename Ring::Element Element;
-	typedef std::pair<uint32, uint32> Transposition;
+	typedef DefaultIndexPolicy::Transposition Transposition;
 	typedef std::vector<Transposition> Permutation;
 
 private:
@@ -78,6 +80,13 @@ private:
 			     Element     &d,
 			     PivotStrategy PS) const;
 
+	// Scale the first rank rows of A, which are its pivot-rows,
+	// and the corresponding rows of L so that the pivots are one.
+	// The inverses of the pivots are computed at once with
+	// Ring::invBatch.
+	template <class Matrix1, class Matrix2>
+	void normalize_pivot_rows (Matrix1 &A, Matrix2 &L, size_t rank) const;
+
 public:
 	/**
 	 * \brief Constructor
@@ -143,7 +152,8 @@ public:
 	 * At conclusion, the parameters will have the property that
 	 * A_out=LPA_in, where A_out is the matrix A at output and
 	 * A_in is the matrix A at input. A_out is in reduced
-	 * row-echelon form and P is a permutation.
+	 * row-echelon form, with all pivots equal to one, and P is a
+	 * permutation.
 	 *
 	 * @param A Matrix A. Will be replaced by its reduced
 	 * row-echelon form
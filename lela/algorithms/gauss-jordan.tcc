@@ -46,6 +46,8 @@ void GaussJordan<Ring, Modules>::GaussJordanTransform (Matrix1      &A,
 	// BLAS3::write (ctx, report, U);
 	// report << "k = " << k << ", d_0 = " << d_0 << std::endl;
 
+	ctx.checkCancelled ();
+
 	typename Matrix1::SubmatrixType Aw (A, k, 0, A.rowdim () - k, A.coldim ());
 
 	if (BLAS3::is_zero (ctx, Aw)) {
@@ -247,6 +249,8 @@ void GaussJordan<Ring, Modules>::GaussTransform (Matrix1     &A,
 	// report << "A =" << std::endl;
 	// BLAS3::write (ctx, report, A);
 
+	ctx.checkCancelled ();
+
 	if (BLAS3::is_zero (ctx, A)) {
 		// DEBUG
 		// report << "A is 0" << std::endl;
@@ -410,6 +414,34 @@ void GaussJordan<Ring, Modules>::GaussTransform (Matrix1     &A,
 	// report << "r = " << r << ", d_0 = " << d_0 << ", d = " << d << std::endl;
 }
 
+template <class Ring, class Modules>
+template <class Matrix1, class Matrix2>
+void GaussJordan<Ring, Modules>::normalize_pivot_rows (Matrix1 &A, Matrix2 &L, size_t rank) const
+{
+	std::vector<Element> pivots (rank);
+	Element a;
+	typename Matrix1::RowIterator i_A;
+	typename Matrix2::RowIterator i_L;
+	size_t i;
+
+	ctx.F.copy (a, ctx.F.zero ());
+
+	for (i_A = A.rowBegin (), i = 0; i < rank; ++i_A, ++i) {
+		BLAS1::head (ctx, a, *i_A);
+		ctx.F.copy (pivots[i], a);
+	}
+
+	if (!ctx.F.invBatch (pivots.begin (), pivots.begin (), pivots.end ()))
+		throw LELAError ("Pivot not invertible in the ring");
+
+	for (i_A = A.rowBegin (), i_L = L.rowBegin (), i = 0; i < rank; ++i_A, ++i_L, ++i) {
+		if (!ctx.F.isOne (pivots[i])) {
+			BLAS1::scal (ctx, pivots[i], *i_A);
+			BLAS1::scal (ctx, pivots[i], *i_L);
+		}
+	}
+}
+
 template <class Ring, class Modules>
 template <class Matrix, class PivotStrategy>
 Matrix &GaussJordan<Ring, Modules>::echelonize (Matrix      &A,
@@ -418,7 +450,13 @@ Matrix &GaussJordan<Ring, Modules>::echelonize (Matrix      &A,
 						Element     &det,
 						PivotStrategy PS)
 {
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
 	commentator.start ("Asymptotically fast row-echelon form", __FUNCTION__);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
 
 	int h;
 
@@ -426,6 +464,9 @@ Matrix &GaussJordan<Ring, Modules>::echelonize (Matrix      &A,
 
 	GaussTransform (A, A, ctx.F.one (), P, rank, h, det, PS);
 
+	reportOperationCounts (ctx.F, "row-echelon form");
+
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE);
 
 	return A;
@@ -443,7 +484,13 @@ Matrix1 &GaussJordan<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 	lela_check (L.rowdim () == A.rowdim ());
 	lela_check (L.coldim () == A.rowdim ());
 
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
 	commentator.start ("Asymptotically fast reduced row-echelon form", __FUNCTION__);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
 
 	int h;
 
@@ -459,7 +506,11 @@ Matrix1 &GaussJordan<Ring, Modules>::echelonize_reduced (Matrix1       &A,
 		s >> *i_L;
 
 	GaussJordanTransform (A, 0, ctx.F.one (), L, P, rank, h, det, S, T, PS);
+	normalize_pivot_rows (A, L, rank);
+
+	reportOperationCounts (ctx.F, "reduced row-echelon form");
 
+	commentator.traceArgument ("rank", rank);
 	commentator.stop (MSG_DONE);
 
 	return A;
@@ -0,0 +1,180 @@
+/* lela/algorithms/lazy-elimination.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Gaussian elimination over Z/p with delayed modular reduction
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_LAZY_ELIMINATION_H
+#define __LELA_ALGORITHMS_LAZY_ELIMINATION_H
+
+#include <vector>
+
+#include "lela/integer.h"
+#include "lela/util/index.h"
+#include "lela/blas/context.h"
+
+namespace LELA
+{
+
+template <class Element> struct ModularTraits;
+template <class Element> class Modular;
+
+/** Gaussian elimination on dense matrices over Z/p with lazy reduction
+ *
+ * This computes the same (non-reduced) row-echelon form as
+ * Elimination::echelonize with the DensePivotStrategy, in place.
+ *
+ * The elimination is left-looking: an entry of A is brought up to
+ * date only when it is needed, i.e. when its column is searched for
+ * a pivot or its row becomes the pivot-row. It is then computed as
+ * the dot-product of the multipliers stored so far in its row with
+ * the entries of the previous pivot-rows. The products are summed
+ * in ModularTraits<Element>::DoubleFatElement without reduction
+ * modulo p, which is only done every blockSize () products and at
+ * the end. A pivot-row is computed as a whole with one such
+ * accumulator per column, so that it is read and written
+ * contiguously.
+ *
+ * The ring must be Modular<uint16> or Modular<uint32> (or a ring
+ * derived from one of these) with elements represented in [0, p),
+ * and the modulus must be small enough that at least two products
+ * fit into an accumulator (see applies). The matrix must have dense
+ * rows. The only workspace is one row of accumulators.
+ *
+ * Elimination::echelonize uses this class for dense matrices over
+ * Modular<uint16> and Modular<uint32> when no pivot-strategy is
+ * given.
+ *
+ * \ingroup algorithms
+ */
+
+template <class Ring, class Modules = AllModules<Ring> >
+class LazyElimination
+{
+public:
+	typedef typename Ring::Element Element;
+	typedef typename ModularTraits<Element>::DoubleFatElement DoubleFatElement;
+	typedef DefaultIndexPolicy::Transposition Transposition;
+	typedef std::vector<Transposition> Permutation;
+
+private:
+	Context<Ring, Modules> &ctx;
+
+	// The modulus and the number of products of two reduced
+	// elements which may be added to a reduced element before an
+	// accumulator overflows
+	DoubleFatElement _modulus;
+	size_t _block_size;
+
+	// Bring the entry (row, col) up to date with the first k
+	// pivot-rows
+	template <class Iterator>
+	void update_entry (std::vector<Iterator> &rows, size_t row, size_t col, size_t k) const;
+
+	// Bring the entries of the pivot-row k from column start onwards
+	// up to date with the pivot-rows above it, using acc as
+	// accumulators
+	template <class Iterator>
+	void update_row (std::vector<Iterator> &rows, size_t k, size_t start, std::vector<DoubleFatElement> &acc) const;
+
+	// Replace the multipliers in the first end columns of row k by
+	// the entries of L, using the finished rows of L above
+	template <class Iterator>
+	void finish_L_row (std::vector<Iterator> &rows, size_t k, size_t end, std::vector<DoubleFatElement> &acc) const;
+
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * Throws LELAError if the modulus is too large for lazy
+	 * reduction, i.e. if applies (_ctx.F) is false.
+	 *
+	 * @param _ctx Context-object for computations
+	 */
+	LazyElimination (Context<Ring, Modules> &_ctx);
+
+	/**
+	 * \brief Compute the (non-reduced) row-echelon form of a
+	 * matrix
+	 *
+	 * The parameters and the result are exactly as in
+	 * Elimination::echelonize, so that in particular
+	 * Elimination::move_L may be used to extract L afterwards.
+	 *
+	 * @param A The matrix whose row-echelon form is to be
+	 * computed. Must have dense rows. Will be replaced by its
+	 * row-echelon form during computation.
+	 *
+	 * @param P The permutation into which to store the
+	 * permutation P.
+	 *
+	 * @param rank An integer into which to store the
+	 * computed rank of A.
+	 *
+	 * @param det A ring-element into which to store the
+	 * computed determinant of the submatrix of A formed
+	 * by taking pivot-rows and -columns.
+	 *
+	 * @param compute_L True if the matrix L should be
+	 * computed and stored below the diagonal of A.
+	 */
+	template <class Matrix>
+	Matrix &echelonize (Matrix        &A,
+			    Permutation   &P,
+			    size_t        &rank,
+			    Element       &det,
+			    bool           compute_L = true) const;
+
+	/// Number of updates an entry may receive before it must be reduced
+	size_t blockSize () const { return _block_size; }
+
+	/// Number of updates an entry may receive before it must be reduced over the ring F
+	static size_t blockSize (const Ring &F);
+
+	/// Whether lazy reduction is worthwhile over the ring F, i.e. whether at least two updates may be delayed
+	static bool applies (const Ring &F) { return blockSize (F) >= 2; }
+};
+
+/// Tags for whether Elimination may use LazyElimination over a ring
+namespace LazyEliminationTypes {
+	struct Unsupported {};
+	struct Supported {};
+}
+
+/** Whether Elimination::echelonize may use LazyElimination over Ring
+ *
+ * \ingroup algorithms
+ */
+template <class Ring>
+struct LazyEliminationTraits
+	{ typedef LazyEliminationTypes::Unsupported Support; };
+
+template <>
+struct LazyEliminationTraits<Modular<uint16> >
+	{ typedef LazyEliminationTypes::Supported Support; };
+
+template <>
+struct LazyEliminationTraits<Modular<uint32> >
+	{ typedef LazyEliminationTypes::Supported Support; };
+
+} // namespace LELA
+
+#include "lela/algorithms/lazy-elimination.tcc"
+
+#endif // __LELA_ALGORITHMS_LAZY_ELIMINATION_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,273 @@
+/* lela/algorithms/lazy-elimination.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Gaussian elimination over Z/p with delayed modular reduction
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_LAZY_ELIMINATION_TCC
+#define __LELA_ALGORITHMS_LAZY_ELIMINATION_TCC
+
+#include <algorithm>
+
+#include "lela/algorithms/lazy-elimination.h"
+#include "lela/util/commentator.h"
+#include "lela/util/error.h"
+
+#ifndef PROGRESS_STEP
+#  define PROGRESS_STEP 1024
+#endif // PROGRESS_STEP
+
+namespace LELA
+{
+
+template <class Ring, class Modules>
+size_t LazyElimination<Ring, Modules>::blockSize (const Ring &F)
+{
+	integer p;
+
+	F.cardinality (p);
+
+	DoubleFatElement max = (DoubleFatElement) -1, pm1 = (DoubleFatElement) p.get_ui () - 1;
+
+	// An accumulator starts out reduced, i.e. below p, and each
+	// update adds at most (p - 1)^2
+	if (pm1 == 0)
+		return 0;
+	else
+		return (max - pm1) / (pm1 * pm1);
+}
+
+template <class Ring, class Modules>
+LazyElimination<Ring, Modules>::LazyElimination (Context<Ring, Modules> &_ctx)
+	: ctx (_ctx), _block_size (blockSize (_ctx.F))
+{
+	integer p;
+
+	ctx.F.cardinality (p);
+	_modulus = p.get_ui ();
+
+	if (_block_size < 2)
+		throw LELAError ("Modulus too large for lazy reduction");
+}
+
+template <class Ring, class Modules>
+template <class Iterator>
+void LazyElimination<Ring, Modules>::update_entry (std::vector<Iterator> &rows, size_t row, size_t col, size_t k) const
+{
+	DoubleFatElement t = rows[row][col];
+	size_t i, pending = 0;
+
+	for (i = 0; i < k; ++i) {
+		if (rows[row][i] == 0)
+			continue;
+
+		t += (DoubleFatElement) rows[row][i] * rows[i][col];
+
+		if (++pending == _block_size) {
+			t %= _modulus;
+			pending = 0;
+		}
+	}
+
+	rows[row][col] = t % _modulus;
+}
+
+template <class Ring, class Modules>
+template <class Iterator>
+void LazyElimination<Ring, Modules>::update_row (std::vector<Iterator> &rows, size_t k, size_t start, std::vector<DoubleFatElement> &acc) const
+{
+	typename std::vector<DoubleFatElement>::iterator i_acc;
+	Iterator i_a, end = rows[k] + acc.size ();
+	DoubleFatElement c;
+	size_t i, pending = 0;
+
+	for (i_a = rows[k] + start, i_acc = acc.begin () + start; i_a != end; ++i_a, ++i_acc)
+		*i_acc = *i_a;
+
+	for (i = 0; i < k; ++i) {
+		if (rows[k][i] == 0)
+			continue;
+
+		c = rows[k][i];
+
+		for (i_a = rows[i] + start, i_acc = acc.begin () + start; i_acc != acc.end (); ++i_a, ++i_acc)
+			*i_acc += c * *i_a;
+
+		if (++pending == _block_size) {
+			for (i_acc = acc.begin () + start; i_acc != acc.end (); ++i_acc)
+				*i_acc %= _modulus;
+
+			pending = 0;
+		}
+	}
+
+	for (i_a = rows[k] + start, i_acc = acc.begin () + start; i_a != end; ++i_a, ++i_acc)
+		*i_a = *i_acc % _modulus;
+}
+
+template <class Ring, class Modules>
+template <class Iterator>
+void LazyElimination<Ring, Modules>::finish_L_row (std::vector<Iterator> &rows, size_t k, size_t end, std::vector<DoubleFatElement> &acc) const
+{
+	typename std::vector<DoubleFatElement>::iterator i_acc, acc_end = acc.begin () + end;
+	Iterator i_a;
+	DoubleFatElement c;
+	size_t i, pending = 0;
+
+	for (i_a = rows[k], i_acc = acc.begin (); i_acc != acc_end; ++i_a, ++i_acc)
+		*i_acc = *i_a;
+
+	// Row i of L has its entries in the columns before i
+	for (i = 1; i < end; ++i) {
+		if (rows[k][i] == 0)
+			continue;
+
+		c = rows[k][i];
+
+		for (i_a = rows[i], i_acc = acc.begin (); i_acc != acc.begin () + i; ++i_a, ++i_acc)
+			*i_acc += c * *i_a;
+
+		if (++pending == _block_size) {
+			for (i_acc = acc.begin (); i_acc != acc_end; ++i_acc)
+				*i_acc %= _modulus;
+
+			pending = 0;
+		}
+	}
+
+	for (i_a = rows[k], i_acc = acc.begin (); i_acc != acc_end; ++i_a, ++i_acc)
+		*i_a = *i_acc % _modulus;
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+Matrix &LazyElimination<Ring, Modules>::echelonize (Matrix        &A,
+						    Permutation   &P,
+						    size_t        &rank,
+						    Element       &det,
+						    bool           compute_L) const
+{
+	checkDim<DefaultIndexPolicy> (A.rowdim (), "Row-dimension exceeds capacity of permutations");
+
+	ActivityGuard guard;
+
+	commentator.start ("Echelonize (elimination with lazy reduction)", __FUNCTION__, A.rowdim () / PROGRESS_STEP);
+	commentator.traceArgument ("rows", A.rowdim ());
+	commentator.traceArgument ("cols", A.coldim ());
+
+	typedef typename Matrix::Row::iterator Iterator;
+
+	// Beginnings of the rows of A. The row-echelon form is built in
+	// place: at step i, the entries (j, k) with k < i of rows j > k
+	// hold the multipliers which have been found so far, the rows
+	// above i are finished and the rest of A is untouched outside of
+	// the columns which have been searched for pivots.
+	std::vector<Iterator> rows;
+	std::vector<DoubleFatElement> acc (A.coldim ());
+
+	typename Matrix::RowIterator i_A;
+
+	size_t m = A.rowdim (), n = A.coldim ();
+	size_t pivot_row, pivot_col, i, j;
+	Element x, negxinv;
+
+	rows.reserve (m);
+
+	for (i_A = A.rowBegin (); i_A != A.rowEnd (); ++i_A)
+		rows.push_back (i_A->begin ());
+
+	P.clear ();
+	rank = 0;
+	ctx.F.init (det, 1);
+
+	for (i = 0, pivot_col = 0; i < m && pivot_col < n; ++i, ++pivot_col) {
+		ctx.checkCancelled ();
+
+		// Bring the columns up to date one at a time until one
+		// of them has a nonzero entry at or below row i. The
+		// whole column is needed for the multipliers.
+		for (pivot_row = m; pivot_col < n; ++pivot_col) {
+			for (j = i; j < m; ++j) {
+				update_entry (rows, j, pivot_col, i);
+
+				if (pivot_row == m && rows[j][pivot_col] != 0)
+					pivot_row = j;
+			}
+
+			if (pivot_row < m)
+				break;
+		}
+
+		if (pivot_row == m)
+			break;
+
+		if (i != pivot_row) {
+			P.push_back (Transposition (i, pivot_row));
+			std::swap_ranges (rows[i], rows[i] + n, rows[pivot_row]);
+		}
+
+		x = rows[i][pivot_col];
+
+		ctx.F.mulin (det, x);
+
+		if (!ctx.F.inv (negxinv, x))
+			throw LELAError ("Could not invert pivot-element in the ring");
+
+		ctx.F.negin (negxinv);
+
+		update_row (rows, i, pivot_col + 1, acc);
+
+		// Replace the pivot-column below the pivot by the
+		// multipliers. Column i is zero in these rows unless it
+		// is the pivot-column itself.
+		for (j = i + 1; j < m; ++j) {
+			x = rows[j][pivot_col];
+
+			if (x != 0) {
+				rows[j][pivot_col] = 0;
+				ctx.F.mul (rows[j][i], x, negxinv);
+			}
+		}
+
+		++rank;
+
+		if (i % PROGRESS_STEP == PROGRESS_STEP - 1)
+			commentator.progress ();
+	}
+
+	// Elimination stores the matrix L with LPA = U, whose rows are
+	// the multipliers plus their combinations of the rows of L
+	// above. These are computed from the top down, so that each row
+	// only uses finished rows.
+	for (j = 1; j < m; ++j) {
+		if (compute_L)
+			finish_L_row (rows, j, std::min (j, rank), acc);
+		else
+			std::fill (rows[j], rows[j] + std::min (j, rank), ctx.F.zero ());
+	}
+
+	commentator.traceArgument ("rank", rank);
+	commentator.stop (MSG_DONE);
+
+	return A;
+}
+
+} // namespace LELA
+
+#endif // __LELA_ALGORITHMS_LAZY_ELIMINATION_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
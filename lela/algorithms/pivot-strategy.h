@@ -13,6 +13,12 @@
 #ifndef __LELA_ALGORITHMS_PIVOT_STRATEGY_H
 #define __LELA_ALGORITHMS_PIVOT_STRATEGY_H
 
+#include <vector>
+#include <utility>
+
+#include "lela/util/error.h"
+#include "lela/matrix/profile.h"
+
 namespace LELA
 {
 
@@ -68,6 +74,11 @@ template <class Ring, class Modules>
 class DensePivotStrategy 
 {
 	Context<Ring, Modules> &ctx;
+	const MatrixProfile *_profile;
+
+	// First column at or after col which may contain a pivot
+	size_t nextColumn (size_t col) const
+		{ return (_profile == NULL) ? col : _profile->nextNonemptyColumn (col); }
 
 	template <class Matrix>
 	bool getPivot_spec (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col,
@@ -83,7 +94,21 @@ public:
 	 * _ctx Context-object to be used
 	 */
 	DensePivotStrategy (Context<Ring, Modules> &_ctx)
-		: ctx (_ctx) 
+		: ctx (_ctx), _profile (NULL)
+	{}
+
+	/** Constructor with profile
+	 *
+	 * Columns which are zero according to the profile are
+	 * skipped without being scanned. Since elimination never
+	 * fills in a zero column, the profile of the matrix before
+	 * elimination may be used throughout.
+	 *
+	 * _ctx Context-object to be used
+	 * profile Profile of the matrix to be eliminated; must remain valid while the strategy is in use
+	 */
+	DensePivotStrategy (Context<Ring, Modules> &_ctx, const MatrixProfile &profile)
+		: ctx (_ctx), _profile (&profile)
 	{}
 
 	template <class Matrix>
@@ -99,7 +124,9 @@ public:
  * with the fewest nonzero entries.
  *
  * This strategy is only available for matrices with sparse, sparse
- * 0-1, or hybrid 0-1 rows.
+ * 0-1, hybrid 0-1, or adaptive rows. With adaptive rows, dense rows
+ * count as having nonzero entries in all columns from the leftmost
+ * one on, so sparse rows are preferred.
  *
  * \ingroup algorithms
  */
@@ -107,6 +134,11 @@ template <class Ring, class Modules>
 class SparsePartialPivotStrategy 
 {
 	Context<Ring, Modules> &ctx;
+	const MatrixProfile *_profile;
+
+	// First column at or after col which may contain a pivot
+	size_t nextColumn (size_t col) const
+		{ return (_profile == NULL) ? col : _profile->nextNonemptyColumn (col); }
 
 	template <class Matrix>
 	bool getPivot_spec (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col,
@@ -120,13 +152,59 @@ class SparsePartialPivotStrategy
 	bool getPivot_spec (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col,
 			    VectorRepresentationTypes::Hybrid01) const;
 
+	template <class Matrix>
+	bool getPivot_spec (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col,
+			    VectorRepresentationTypes::Adaptive) const;
+
+	// Find the first nonzero entry at or after column start of the
+	// given row, together with an estimate of the number of nonzero
+	// entries from there on
+
+	template <class Vector>
+	bool leadingEntry (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight) const;
+
+	template <class Vector>
+	bool leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+				VectorRepresentationTypes::Dense) const;
+
+	template <class Vector>
+	bool leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+				VectorRepresentationTypes::Dense01) const;
+
+	template <class Vector>
+	bool leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+				VectorRepresentationTypes::Sparse) const;
+
+	template <class Vector>
+	bool leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+				VectorRepresentationTypes::Sparse01) const;
+
+	template <class Vector>
+	bool leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+				VectorRepresentationTypes::Hybrid01) const;
+
 public:
 	/** Constructor
 	 *
 	 * _ctx Context-object to be used
 	 */
 	SparsePartialPivotStrategy (Context<Ring, Modules> &_ctx)
-		: ctx (_ctx) 
+		: ctx (_ctx), _profile (NULL)
+	{}
+
+	/** Constructor with profile
+	 *
+	 * The search for a pivot stops as soon as it finds a row
+	 * with a single nonzero entry (resp. block) in the first
+	 * column which is nonzero according to the profile, since
+	 * no better row exists. The profile of the matrix before
+	 * elimination remains valid for this purpose throughout.
+	 *
+	 * _ctx Context-object to be used
+	 * profile Profile of the matrix to be eliminated; must remain valid while the strategy is in use
+	 */
+	SparsePartialPivotStrategy (Context<Ring, Modules> &_ctx, const MatrixProfile &profile)
+		: ctx (_ctx), _profile (&profile)
 	{}
 
 	template <class Matrix>
@@ -134,6 +212,118 @@ public:
 		{ return getPivot_spec (A, pivot, row, col, typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
 };
 
+/** Exception thrown when a matrix does not have the structure
+ * recorded in a plan
+ *
+ * \ingroup algorithms
+ */
+class PlanMismatch : public LELAError
+{
+public:
+	PlanMismatch (const char *msg) : LELAError (msg) {}
+};
+
+/** Sequence of pivots chosen by a pivot-strategy
+ *
+ * Each entry is the (row, column) of a pivot, or (noPivot, noPivot)
+ * for a search which found none.
+ *
+ * \ingroup algorithms
+ */
+typedef std::vector<std::pair<size_t, size_t> > PivotSequence;
+
+/// Marker in a @ref PivotSequence for a search which found no pivot
+const size_t noPivot = (size_t) -1;
+
+/** Pivot-strategy recording the pivots chosen by another
+ *
+ * Forwards each request to the given strategy and appends the result
+ * to a @ref PivotSequence, which a @ref PlannedPivotStrategy can
+ * replay on a matrix of the same structure.
+ *
+ * \ingroup algorithms
+ */
+template <class Strategy>
+class RecordingPivotStrategy
+{
+	Strategy _strategy;
+	PivotSequence *_pivots;
+
+public:
+	/** Constructor
+	 *
+	 * strategy Pivot-strategy to be recorded
+	 * pivots Sequence to which to append the chosen pivots; must remain valid while the strategy is in use
+	 */
+	RecordingPivotStrategy (const Strategy &strategy, PivotSequence &pivots)
+		: _strategy (strategy), _pivots (&pivots)
+	{}
+
+	template <class Matrix, class Element>
+	bool getPivot (const Matrix &A, Element &pivot, size_t &row, size_t &col) const
+	{
+		if (_strategy.getPivot (A, pivot, row, col)) {
+			_pivots->push_back (PivotSequence::value_type (row, col));
+			return true;
+		} else {
+			_pivots->push_back (PivotSequence::value_type (noPivot, noPivot));
+			return false;
+		}
+	}
+};
+
+/** Pivot-strategy following a recorded sequence of pivots
+ *
+ * Returns the pivots in the given @ref PivotSequence in order without
+ * searching the matrix. Each pivot is checked to lie in the part of
+ * the matrix being searched and to be nonzero; otherwise, or if more
+ * pivots are requested than were recorded, @ref PlanMismatch is
+ * thrown. This detects e.g. primes for which an entry chosen as pivot
+ * over another prime vanishes. The caller should check afterwards
+ * that the whole sequence was used.
+ *
+ * \ingroup algorithms
+ */
+template <class Ring, class Modules>
+class PlannedPivotStrategy
+{
+	Context<Ring, Modules> &ctx;
+	const PivotSequence *_pivots;
+	size_t *_position;
+
+public:
+	/** Constructor
+	 *
+	 * _ctx Context-object to be used
+	 * pivots Sequence of pivots to be followed
+	 * position Index in pivots of the next pivot; updated as pivots are used
+	 */
+	PlannedPivotStrategy (Context<Ring, Modules> &_ctx, const PivotSequence &pivots, size_t &position)
+		: ctx (_ctx), _pivots (&pivots), _position (&position)
+	{}
+
+	template <class Matrix>
+	bool getPivot (const Matrix &A, typename Ring::Element &pivot, size_t &row, size_t &col) const
+	{
+		if (*_position >= _pivots->size ())
+			throw PlanMismatch ("Matrix requires more pivots than planned");
+
+		const PivotSequence::value_type &p = (*_pivots)[(*_position)++];
+
+		if (p.first == noPivot)
+			return false;
+
+		if (p.first < row || p.second < col || p.first >= A.rowdim () || p.second >= A.coldim ()
+		    || !A.getEntry (pivot, p.first, p.second) || ctx.F.isZero (pivot))
+			throw PlanMismatch ("Planned pivot is zero");
+
+		row = p.first;
+		col = p.second;
+
+		return true;
+	}
+};
+
 /** Sensible default pivot-strategies for row-types */
 template <class Ring, class Modules, class Row, class Trait = typename VectorTraits<Ring, Row>::RepresentationType>
 struct DefaultPivotStrategy
@@ -159,6 +349,10 @@ template <class Ring, class Modules, class Row>
 struct DefaultPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Hybrid01>
 	{ typedef SparsePartialPivotStrategy<Ring, Modules> Strategy; };
 
+template <class Ring, class Modules, class Row>
+struct DefaultPivotStrategy<Ring, Modules, Row, VectorRepresentationTypes::Adaptive>
+	{ typedef SparsePartialPivotStrategy<Ring, Modules> Strategy; };
+
 } // namespace LELA
 
 #include "lela/algorithms/pivot-strategy.tcc"
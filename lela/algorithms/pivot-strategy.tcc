@@ -28,7 +28,7 @@ bool DensePivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A, typename
 
 	size_t k;
 
-	for (; col < A.coldim (); ++col) {
+	for (col = nextColumn (col); col < A.coldim (); col = nextColumn (col + 1)) {
 		for (i = A.rowBegin () + row, k = row; i != A.rowEnd (); ++i, ++k) {
 			if (!ctx.F.isZero ((*i)[col])) {
 				row = k;
@@ -53,7 +53,7 @@ bool DensePivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A, typename
 
 	size_t k;
 
-	for (; col < A.coldim (); ++col) {
+	for (col = nextColumn (col); col < A.coldim (); col = nextColumn (col + 1)) {
 		for (i = A.rowBegin () + row, k = row; i != A.rowEnd (); ++i, ++k) {
 			if ((*i)[col]) {
 				row = k;
@@ -76,7 +76,7 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 
 	typename Matrix::ConstRowIterator i;
 
-	size_t min_nonzero = 0xffffffffU, k, start_col = col;
+	size_t min_nonzero = 0xffffffffU, k, start_col = col, first_col = nextColumn (col);
 	col = A.coldim ();
 
 	for (i = A.rowBegin () + row, k = row; i != A.rowEnd (); ++i, ++k) {
@@ -94,6 +94,9 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 				x = row_sub.front ().second;
 				row = k;
 			}
+
+			if (col == first_col && min_nonzero == 1)
+				break;
 		}
 	}
 
@@ -110,7 +113,7 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 
 	typename Matrix::ConstRowIterator i;
 
-	size_t min_nonzero = 0xffffffffU, k, start_col = col;
+	size_t min_nonzero = 0xffffffffU, k, start_col = col, first_col = nextColumn (col);
 	col = A.coldim ();
 
 	for (i = A.rowBegin () + row, k = row; i != A.rowEnd (); ++i, ++k) {
@@ -128,6 +131,9 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 				x = true;
 				row = k;
 			}
+
+			if (col == first_col && min_nonzero == 1)
+				break;
 		}
 	}
 
@@ -144,7 +150,7 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 
 	typename Matrix::ConstRowIterator i;
 
-	size_t min_blocks = 0xffffffffU, k, start_col = col, block_col;
+	size_t min_blocks = 0xffffffffU, k, start_col = col, first_col = nextColumn (col), block_col;
 	typename Matrix::Row::word_type v, t;
 	col = A.coldim ();
 
@@ -162,7 +168,7 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 			if (block->first == start_col >> WordTraits<typename Matrix::Row::word_type>::logof_size)
 				v &= Matrix::Row::Endianness::mask_right (start_col & WordTraits<typename Matrix::Row::word_type>::pos_mask);
 
-			for (block_col = block->first << WordTraits<typename Matrix::Row::word_type>::logof_size, t = Matrix::Row::Endianness::e_0;
+			for (block_col = (size_t) block->first << WordTraits<typename Matrix::Row::word_type>::logof_size, t = Matrix::Row::Endianness::e_0;
 			     t != 0 && (t & v) == 0; t = Matrix::Row::Endianness::shift_right (t, 1), ++block_col);
 
 			if (t == 0)
@@ -179,6 +185,9 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 				min_blocks = i->end () - block;
 				row = k;
 			}
+
+			if (col == first_col && min_blocks == 1)
+				break;
 		}
 	}
 
@@ -187,6 +196,152 @@ bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A,
 	return min_blocks != 0xffffffffU;
 }
 
+template <class Ring, class Modules>
+template <class Matrix>
+bool SparsePartialPivotStrategy<Ring, Modules>::getPivot_spec (const Matrix &A, typename Ring::Element &x, size_t &row, size_t &col,
+							       VectorRepresentationTypes::Adaptive) const
+{
+	lela_check (row < A.rowdim ());
+	lela_check (col < A.coldim ());
+
+	typename Matrix::ConstRowIterator i;
+	typename Ring::Element a;
+
+	size_t min_weight = 0xffffffffU, k, start_col = col, first_col = nextColumn (col), row_col, weight;
+	col = A.coldim ();
+
+	for (i = A.rowBegin () + row, k = row; i != A.rowEnd (); ++i, ++k) {
+		if (!leadingEntry (*i, start_col, row_col, a, weight))
+			continue;
+
+		if (row_col < col || (row_col == col && weight < min_weight)) {
+			col = row_col;
+			min_weight = weight;
+			ctx.F.copy (x, a);
+			row = k;
+		}
+
+		if (col == first_col && min_weight == 1)
+			break;
+	}
+
+	return min_weight != 0xffffffffU;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight) const
+{
+	switch (v.kind ()) {
+	case Vector::SPARSE:
+		return leadingEntry_spec (v.sparse (), start, col, a, weight,
+					  typename VectorTraits<Ring, typename Vector::Sparse>::RepresentationType ());
+
+	case Vector::HYBRID:
+		return leadingEntry_spec (v.hybrid (), start, col, a, weight,
+					  typename VectorTraits<Ring, typename Vector::Hybrid>::RepresentationType ());
+
+	default:
+		return leadingEntry_spec (v.dense (), start, col, a, weight,
+					  typename VectorTraits<Ring, typename Vector::Dense>::RepresentationType ());
+	}
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+								   VectorRepresentationTypes::Dense) const
+{
+	for (col = start; col < v.size (); ++col) {
+		if (!ctx.F.isZero (v[col])) {
+			ctx.F.copy (a, v[col]);
+			weight = v.size () - col;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+								   VectorRepresentationTypes::Dense01) const
+{
+	for (col = start; col < v.size (); ++col) {
+		if (v[col]) {
+			a = true;
+			weight = v.size () - col;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+								   VectorRepresentationTypes::Sparse) const
+{
+	typename Vector::const_iterator j = std::lower_bound (v.begin (), v.end (), start, VectorUtils::FindSparseEntryLB ());
+
+	if (j == v.end ())
+		return false;
+
+	col = j->first;
+	ctx.F.copy (a, j->second);
+	weight = v.end () - j;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+								   VectorRepresentationTypes::Sparse01) const
+{
+	typename Vector::const_iterator j = std::lower_bound (v.begin (), v.end (), start);
+
+	if (j == v.end ())
+		return false;
+
+	col = *j;
+	a = true;
+	weight = v.end () - j;
+
+	return true;
+}
+
+template <class Ring, class Modules>
+template <class Vector>
+bool SparsePartialPivotStrategy<Ring, Modules>::leadingEntry_spec (const Vector &v, size_t start, size_t &col, typename Ring::Element &a, size_t &weight,
+								   VectorRepresentationTypes::Hybrid01) const
+{
+	typedef WordTraits<typename Vector::word_type> WT;
+
+	typename Vector::word_type w, t;
+	typename Vector::const_iterator block
+		= std::lower_bound (v.begin (), v.end (), start >> WT::logof_size, VectorUtils::FindSparseEntryLB ());
+
+	for (; block != v.end (); ++block) {
+		w = block->second;
+
+		if (block->first == start >> WT::logof_size)
+			w &= Vector::Endianness::mask_right (start & WT::pos_mask);
+
+		for (col = (size_t) block->first << WT::logof_size, t = Vector::Endianness::e_0; t != 0; t = Vector::Endianness::shift_right (t, 1), ++col) {
+			if (w & t) {
+				a = true;
+				weight = v.end () - block;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 } // namespace LELA
 
 #endif // __LELA_ALGORITHMS_PIVOT_STRATEGY_TCC
@@ -67,6 +67,8 @@ Matrix3 &StrassenWinograd<ParentTag>::gemm_res (const Ring &R, Modules &M, const
 						size_t m, size_t k, size_t n)
 {
 #ifdef __LELA_SW_DETAILED_PROFILE
+	ActivityGuard guard;
+
 	commentator.start ("Residual gemm", __FUNCTION__);
 
 	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
@@ -146,7 +148,11 @@ Matrix3 &StrassenWinograd<ParentTag>::mul (const Ring &R, Modules &M, const type
 	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0)
 		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, R.zero (), C);
 	else {
+		M.checkCancelled ();
+
 #ifdef __LELA_SW_DETAILED_PROFILE
+		ActivityGuard guard;
+
 		commentator.start ("StrassenWinograd::mul", __FUNCTION__);
 
 		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
@@ -305,7 +311,11 @@ Matrix3 &StrassenWinograd<ParentTag>::addmul (const Ring &R, Modules &M, const t
 	if (C.rowdim () < _cutoff || C.coldim () < _cutoff || A.coldim () < _cutoff || m == 0 || n == 0 || k == 0)
 		return BLAS3::_gemm<Ring, ParentTag>::op (R, M, a, A, B, b, C);
 	else {
+		M.checkCancelled ();
+
 #ifdef __LELA_SW_DETAILED_PROFILE
+		ActivityGuard guard;
+
 		commentator.start ("StrassenWinograd::mul", __FUNCTION__);
 
 		commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
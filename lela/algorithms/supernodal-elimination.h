@@ -0,0 +1,144 @@
+/* lela/algorithms/supernodal-elimination.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Elimination on sparse matrices by supernodes
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_H
+#define __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_H
+
+#include <vector>
+
+#include "lela/blas/context.h"
+#include "lela/matrix/dense.h"
+
+namespace LELA
+{
+
+/** Gaussian elimination on sparse matrices by supernodes
+ *
+ * Matrices arising from F4 and other structured problems contain
+ * runs of consecutive rows with the same nonzero-pattern. This class
+ * groups such runs into supernodes. A supernode consists of a set of
+ * column-indices shared by all of its rows and a dense panel (a
+ * DenseMatrix) holding the entries of the rows in those columns.
+ *
+ * Elimination then proceeds supernode by supernode. Each supernode is
+ * first reduced by the pivot-rows of the earlier supernodes. One such
+ * update is a product of two small dense matrices, computed with
+ * BLAS3::gemm, so that it goes through the module-stack like any
+ * other dense computation; the fill-in which it causes is accounted
+ * for by widening the column-set of the target supernode. The panel
+ * is then put into reduced row-echelon form with dense elimination,
+ * and its nonzero rows become the pivot-rows of the supernode.
+ *
+ * The result is a row-echelon form of the input, but not in general
+ * the one which Elimination::echelonize computes, since the
+ * row-operations are different. The row-space and the rank are of
+ * course the same.
+ *
+ * \ingroup algorithms
+ */
+
+template <class Ring, class Modules = AllModules<Ring> >
+class SupernodalElimination
+{
+public:
+	typedef typename Ring::Element Element;
+
+	/// A run of rows sharing a column-set, together with their entries
+	struct Supernode {
+		/// Indices of the rows of the input in the supernode
+		std::vector<size_t> rows;
+
+		/// Sorted column-indices shared by the rows
+		std::vector<size_t> cols;
+
+		/// Entries of the rows in the columns cols. After
+		/// elimination, contains only the pivot-rows.
+		DenseMatrix<Element> panel;
+
+		/// Column-indices of the pivots of the rows of panel,
+		/// filled in by elimination
+		std::vector<size_t> pivots;
+	};
+
+private:
+	Context<Ring, Modules> &ctx;
+	double _relax;
+
+	// Replace the column-set of S by its union with cols, moving
+	// the entries of the panel accordingly
+	void widen (Supernode &S, const std::vector<size_t> &cols) const;
+
+	// Reduce S by the pivot-rows of the supernode U
+	void update (Supernode &S, const Supernode &U) const;
+
+	// Put the panel of S into reduced row-echelon form, keep only
+	// its nonzero rows and columns, and record the pivots
+	void factor (Supernode &S) const;
+
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * @param _ctx Context-object for computations
+	 *
+	 * @param relax Amount of explicit zeros which may be stored in
+	 * a supernode in order to merge rows with different patterns,
+	 * as a fraction of the number of nonzero entries. With the
+	 * default 0, only rows with identical patterns are merged.
+	 */
+	SupernodalElimination (Context<Ring, Modules> &_ctx, double relax = 0.0)
+		: ctx (_ctx), _relax (relax) {}
+
+	/** Partition the rows of a sparse matrix into supernodes
+	 *
+	 * Consecutive rows are placed in the same supernode as long as
+	 * the union of their patterns does not introduce more explicit
+	 * zeros than allowed by the relaxation-parameter. Zero rows are
+	 * skipped.
+	 *
+	 * @param A Matrix with sparse rows
+	 * @param S Vector into which to store the supernodes
+	 * @returns Reference to S
+	 */
+	template <class Matrix>
+	std::vector<Supernode> &findSupernodes (const Matrix &A, std::vector<Supernode> &S) const;
+
+	/** Compute a row-echelon form of a sparse matrix
+	 *
+	 * @param A Matrix with sparse rows. Will be replaced by a
+	 * row-echelon form, with the rank nonzero rows at the top in
+	 * order of their pivots and the remaining rows zero.
+	 *
+	 * @param rank An integer into which to store the computed rank
+	 * of A
+	 *
+	 * @returns Reference to A
+	 */
+	template <class Matrix>
+	Matrix &echelonize (Matrix &A, size_t &rank) const;
+};
+
+} // namespace LELA
+
+#include "lela/algorithms/supernodal-elimination.tcc"
+
+#endif // __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,317 @@
+/* lela/algorithms/supernodal-elimination.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Elimination on sparse matrices by supernodes
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_TCC
+#define __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_TCC
+
+#include <algorithm>
+#include <iterator>
+
+#include "lela/algorithms/supernodal-elimination.h"
+#include "lela/algorithms/elimination.h"
+#include "lela/blas/level1.h"
+#include "lela/blas/level3.h"
+#include "lela/util/commentator.h"
+
+#ifndef PROGRESS_STEP
+#  define PROGRESS_STEP 1024
+#endif // PROGRESS_STEP
+
+namespace LELA
+{
+
+template <class Ring, class Modules>
+template <class Matrix>
+std::vector<typename SupernodalElimination<Ring, Modules>::Supernode> &
+SupernodalElimination<Ring, Modules>::findSupernodes (const Matrix &A, std::vector<Supernode> &S) const
+{
+	typename Matrix::ConstRowIterator i_A;
+	typename Matrix::Row::const_iterator i_a;
+
+	std::vector<size_t> pattern, merged;
+	size_t i, nnz = 0;
+
+	S.clear ();
+
+	for (i_A = A.rowBegin (), i = 0; i_A != A.rowEnd (); ++i_A, ++i) {
+		if (i_A->empty ())
+			continue;
+
+		pattern.clear ();
+
+		for (i_a = i_A->begin (); i_a != i_A->end (); ++i_a)
+			pattern.push_back (i_a->first);
+
+		if (!S.empty ()) {
+			merged.clear ();
+			std::set_union (S.back ().cols.begin (), S.back ().cols.end (), pattern.begin (), pattern.end (),
+					std::back_inserter (merged));
+
+			// Stored entries, including explicit zeros, against
+			// the nonzero entries of the rows
+			if ((double) (merged.size () * (S.back ().rows.size () + 1)) <= (1.0 + _relax) * (double) (nnz + pattern.size ())) {
+				S.back ().cols.swap (merged);
+				S.back ().rows.push_back (i);
+				nnz += pattern.size ();
+				continue;
+			}
+		}
+
+		S.push_back (Supernode ());
+		S.back ().cols = pattern;
+		S.back ().rows.push_back (i);
+		nnz = pattern.size ();
+	}
+
+	typename std::vector<Supernode>::iterator i_S;
+	typename DenseMatrix<Element>::RowIterator i_P;
+	std::vector<size_t>::const_iterator i_r;
+
+	for (i_S = S.begin (); i_S != S.end (); ++i_S) {
+		DenseMatrix<Element> panel (i_S->rows.size (), i_S->cols.size ());
+
+		BLAS3::scal (ctx, ctx.F.zero (), panel);
+
+		for (i_r = i_S->rows.begin (), i_P = panel.rowBegin (); i_r != i_S->rows.end (); ++i_r, ++i_P) {
+			typename Matrix::ConstRowIterator row = A.rowBegin () + *i_r;
+			std::vector<size_t>::iterator i_c = i_S->cols.begin ();
+
+			for (i_a = row->begin (); i_a != row->end (); ++i_a) {
+				i_c = std::lower_bound (i_c, i_S->cols.end (), (size_t) i_a->first);
+				ctx.F.copy ((*i_P)[i_c - i_S->cols.begin ()], i_a->second);
+			}
+		}
+
+		i_S->panel = panel;
+	}
+
+	return S;
+}
+
+template <class Ring, class Modules>
+void SupernodalElimination<Ring, Modules>::widen (Supernode &S, const std::vector<size_t> &cols) const
+{
+	std::vector<size_t> merged;
+
+	std::set_union (S.cols.begin (), S.cols.end (), cols.begin (), cols.end (), std::back_inserter (merged));
+
+	if (merged.size () == S.cols.size ())
+		return;
+
+	std::vector<size_t> pos (S.cols.size ());
+	size_t j, k;
+
+	for (j = 0, k = 0; j < S.cols.size (); ++j, ++k) {
+		while (merged[k] != S.cols[j])
+			++k;
+
+		pos[j] = k;
+	}
+
+	DenseMatrix<Element> panel (S.panel.rowdim (), merged.size ());
+
+	BLAS3::scal (ctx, ctx.F.zero (), panel);
+
+	typename DenseMatrix<Element>::ConstRowIterator i_old;
+	typename DenseMatrix<Element>::RowIterator i_new;
+
+	for (i_old = S.panel.rowBegin (), i_new = panel.rowBegin (); i_old != S.panel.rowEnd (); ++i_old, ++i_new)
+		for (j = 0; j < pos.size (); ++j)
+			ctx.F.copy ((*i_new)[pos[j]], (*i_old)[j]);
+
+	S.panel = panel;
+	S.cols.swap (merged);
+}
+
+template <class Ring, class Modules>
+void SupernodalElimination<Ring, Modules>::update (Supernode &S, const Supernode &U) const
+{
+	widen (S, U.cols);
+
+	std::vector<size_t> pos (U.cols.size ());
+	size_t s, t;
+
+	for (s = 0; s < U.cols.size (); ++s)
+		pos[s] = std::lower_bound (S.cols.begin (), S.cols.end (), U.cols[s]) - S.cols.begin ();
+
+	// Since the pivot-rows of U are in reduced form, the
+	// coefficients by which they must be multiplied are just the
+	// entries of S in the pivot-columns
+	DenseMatrix<Element> C (S.panel.rowdim (), U.pivots.size ()), D (S.panel.rowdim (), U.cols.size ());
+
+	for (t = 0; t < U.pivots.size (); ++t)
+		BLAS1::copy (ctx, *(S.panel.colBegin () + (std::lower_bound (S.cols.begin (), S.cols.end (), U.pivots[t]) - S.cols.begin ())),
+			     *(C.colBegin () + t));
+
+	BLAS3::gemm (ctx, ctx.F.one (), C, U.panel, ctx.F.zero (), D);
+
+	for (s = 0; s < U.cols.size (); ++s)
+		BLAS1::axpy (ctx, ctx.F.minusOne (), *(D.colBegin () + s), *(S.panel.colBegin () + pos[s]));
+}
+
+template <class Ring, class Modules>
+void SupernodalElimination<Ring, Modules>::factor (Supernode &S) const
+{
+	Elimination<Ring, Modules> elim (ctx);
+	typename Elimination<Ring, Modules>::Permutation P;
+	DenseMatrix<Element> L;
+	size_t rank, j, k;
+	Element det;
+
+	elim.echelonize_reduced (S.panel, L, P, rank, det, false);
+
+	S.pivots.clear ();
+
+	if (rank == 0) {
+		S.panel = DenseMatrix<Element> ();
+		S.cols.clear ();
+		return;
+	}
+
+	// Drop the columns which are zero in all pivot-rows, so that
+	// they cause no fill-in in later supernodes
+	std::vector<bool> used (S.cols.size (), false);
+	typename DenseMatrix<Element>::ConstRowIterator i_P;
+
+	for (i_P = S.panel.rowBegin (), k = 0; k < rank; ++i_P, ++k) {
+		bool found_pivot = false;
+
+		for (j = 0; j < S.cols.size (); ++j) {
+			if (!ctx.F.isZero ((*i_P)[j])) {
+				if (!found_pivot) {
+					S.pivots.push_back (S.cols[j]);
+					found_pivot = true;
+				}
+
+				used[j] = true;
+			}
+		}
+	}
+
+	std::vector<size_t> cols;
+
+	for (j = 0; j < S.cols.size (); ++j)
+		if (used[j])
+			cols.push_back (j);
+
+	DenseMatrix<Element> U (rank, cols.size ());
+	typename DenseMatrix<Element>::RowIterator i_U;
+
+	for (i_P = S.panel.rowBegin (), i_U = U.rowBegin (); i_U != U.rowEnd (); ++i_P, ++i_U)
+		for (j = 0; j < cols.size (); ++j)
+			ctx.F.copy ((*i_U)[j], (*i_P)[cols[j]]);
+
+	for (j = 0; j < cols.size (); ++j)
+		cols[j] = S.cols[cols[j]];
+
+	S.panel = U;
+	S.cols.swap (cols);
+}
+
+template <class Ring, class Modules>
+template <class Matrix>
+Matrix &SupernodalElimination<Ring, Modules>::echelonize (Matrix &A, size_t &rank) const
+{
+	std::vector<Supernode> S;
+
+	findSupernodes (A, S);
+
+	ActivityGuard guard;
+
+	commentator.start ("Echelonize (supernodal elimination)", __FUNCTION__, S.size () / PROGRESS_STEP);
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Number of supernodes: " << S.size () << std::endl;
+
+	static const size_t none = (size_t) -1;
+
+	// Supernode owning the pivot in each column, if any
+	std::vector<size_t> owner (A.coldim (), none);
+
+	size_t k, j, c;
+
+	for (k = 0; k < S.size (); ++k) {
+		ctx.checkCancelled ();
+
+		Supernode &T = S[k];
+
+		// Eliminate the entries of T in pivot-columns of earlier
+		// supernodes. The fill-in of each update lies to the
+		// right of the leftmost column it eliminates, so processing
+		// the columns from left to right terminates.
+		for (c = 0; ; ++c) {
+			for (j = std::lower_bound (T.cols.begin (), T.cols.end (), c) - T.cols.begin (); j < T.cols.size (); ++j)
+				if (owner[T.cols[j]] != none && !BLAS1::is_zero (ctx, *(T.panel.colBegin () + j)))
+					break;
+
+			if (j == T.cols.size ())
+				break;
+
+			c = T.cols[j];
+			update (T, S[owner[c]]);
+		}
+
+		factor (T);
+
+		for (j = 0; j < T.pivots.size (); ++j)
+			owner[T.pivots[j]] = k;
+
+		if (k % PROGRESS_STEP == PROGRESS_STEP - 1)
+			commentator.progress ();
+	}
+
+	// Write out the pivot-rows in order of their pivots
+
+	std::vector<std::pair<size_t, std::pair<size_t, size_t> > > rows;
+
+	for (k = 0; k < S.size (); ++k)
+		for (j = 0; j < S[k].pivots.size (); ++j)
+			rows.push_back (std::make_pair (S[k].pivots[j], std::make_pair (k, j)));
+
+	std::sort (rows.begin (), rows.end ());
+
+	typename Matrix::RowIterator i_A = A.rowBegin ();
+
+	for (j = 0; j < rows.size (); ++j, ++i_A) {
+		const Supernode &T = S[rows[j].second.first];
+		typename DenseMatrix<Element>::ConstRow row = T.panel[rows[j].second.second];
+
+		i_A->clear ();
+
+		for (c = 0; c < T.cols.size (); ++c)
+			if (!ctx.F.isZero (row[c]))
+				i_A->push_back (typename Matrix::Row::value_type (T.cols[c], row[c]));
+	}
+
+	for (; i_A != A.rowEnd (); ++i_A)
+		i_A->clear ();
+
+	rank = rows.size ();
+
+	commentator.stop (MSG_DONE);
+
+	return A;
+}
+
+} // namespace LELA
+
+#endif // __LELA_ALGORITHMS_SUPERNODAL_ELIMINATION_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
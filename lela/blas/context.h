@@ -10,6 +10,10 @@
 #ifndef __BLAS_CONTEXT_H
 #define __BLAS_CONTEXT_H
 
+#include <vector>
+
+#include "lela/util/cancellation.h"
+
 namespace LELA
 {
 
@@ -33,8 +37,16 @@ struct GenericModule
 {
 	struct Tag {};
 
-	GenericModule (const Ring &R) {}
-	GenericModule () {}
+	/// Token checked at progress-points, or NULL if the
+	/// computation cannot be cancelled
+	const CancellationToken *_cancellation;
+
+	GenericModule (const Ring &R) : _cancellation (NULL) {}
+	GenericModule () : _cancellation (NULL) {}
+
+	/// Throw Cancelled if the computation has been cancelled
+	void checkCancelled () const
+		{ if (_cancellation != NULL) _cancellation->check (); }
 };
 
 /** All modules
@@ -81,6 +93,26 @@ public:
 
 	/// Copy-constructor
 	Context (const Context &ctx) : F (ctx.F), M (ctx.M) {}
+
+	/** Attach a cancellation-token to this context
+	 *
+	 * Computations with this context then throw @ref Cancelled
+	 * at their next progress-point once the token has been
+	 * cancelled or its deadline has passed. The token must outlive
+	 * its use by the context.
+	 *
+	 * @param token Token to be checked, or NULL to detach it
+	 */
+	void setCancellationToken (const CancellationToken *token)
+		{ M._cancellation = token; }
+
+	/// Token attached to this context, or NULL if there is none
+	const CancellationToken *cancellationToken () const
+		{ return M._cancellation; }
+
+	/// Throw Cancelled if the computation has been cancelled
+	void checkCancelled () const
+		{ M.checkCancelled (); }
 };
 
 /// @name Enumerations used in arithmetic operations
@@ -0,0 +1,414 @@
+/* lela/blas/level1-adaptive.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Level 1 BLAS on adaptive vectors
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL1_ADAPTIVE_H
+#define __BLAS_LEVEL1_ADAPTIVE_H
+
+#include <iostream>
+
+#include "lela/lela-config.h"
+#include "lela/util/debug.h"
+#include "lela/blas/context.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/adaptive.h"
+#include "lela/vector/bit-iterator.h"
+#include "lela/blas/level1-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS1
+{
+
+/** Dispatch of level 1 BLAS on adaptive vectors
+ *
+ * The modules call these methods when one of the arguments is an
+ * @ref AdaptiveVector. Each method replaces the adaptive arguments by
+ * their underlying vectors and re-enters the dispatch at the top of
+ * the module-chain, so that the underlying vectors are handled by the
+ * most specialised implementation available. Methods which write to
+ * an adaptive vector then promote it if it has filled in.
+ */
+template <class Ring>
+class _adaptive
+{
+	typedef AdaptiveVector<typename Ring::Element> Adaptive;
+	typedef typename Adaptive::Kind Kind;
+
+	static inline unsigned int popcount (uint64 t)
+	{
+		t = t - ((t >> 1) & 0x5555555555555555ULL);
+		t = (t & 0x3333333333333333ULL) + ((t >> 2) & 0x3333333333333333ULL);
+		t = (t + (t >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (unsigned int) ((t * 0x0101010101010101ULL) >> 56);
+	}
+
+	// Count the nonzero entries and the nonzero words (in the
+	// hybrid representation) of a vector
+
+	template <class Vector>
+	static void count (const Ring &F, const Vector &v, size_t &nonzero, size_t &words, VectorRepresentationTypes::Dense)
+	{
+		typename Vector::const_iterator i;
+
+		for (i = v.begin (), nonzero = 0; i != v.end (); ++i)
+			if (!F.isZero (*i))
+				++nonzero;
+
+		words = nonzero;
+	}
+
+	template <class Vector>
+	static void count (const Ring &F, const Vector &v, size_t &nonzero, size_t &words, VectorRepresentationTypes::Sparse)
+		{ nonzero = words = v.size (); }
+
+	template <class Vector>
+	static void count (const Ring &F, const Vector &v, size_t &nonzero, size_t &words, VectorRepresentationTypes::Dense01)
+	{
+		typename Vector::const_word_iterator i;
+
+		nonzero = words = 0;
+
+		if (v.size () == 0)
+			return;
+
+		for (i = v.word_begin (); i != v.word_end (); ++i) {
+			if (*i) {
+				++words;
+				nonzero += popcount (*i);
+			}
+		}
+
+		if (v.back_word ()) {
+			++words;
+			nonzero += popcount (v.back_word ());
+		}
+	}
+
+	template <class Vector>
+	static void count (const Ring &F, const Vector &v, size_t &nonzero, size_t &words, VectorRepresentationTypes::Sparse01)
+	{
+		typename Vector::const_iterator i;
+		size_t last = (size_t) -1;
+
+		for (i = v.begin (), words = 0; i != v.end (); ++i) {
+			if (*i >> WordTraits<uint64>::logof_size != last) {
+				last = *i >> WordTraits<uint64>::logof_size;
+				++words;
+			}
+		}
+
+		nonzero = v.size ();
+	}
+
+	template <class Vector>
+	static void count (const Ring &F, const Vector &v, size_t &nonzero, size_t &words, VectorRepresentationTypes::Hybrid01)
+	{
+		typename Vector::const_iterator i;
+
+		for (i = v.begin (), nonzero = 0; i != v.end (); ++i)
+			nonzero += popcount (i->second);
+
+		words = v.size ();
+	}
+
+	static void count (const Ring &F, const Adaptive &v, size_t &nonzero, size_t &words)
+	{
+		switch (v.kind ()) {
+		case Adaptive::SPARSE:
+			count (F, v.sparse (), nonzero, words, typename VectorTraits<Ring, typename Adaptive::Sparse>::RepresentationType ());
+			break;
+
+		case Adaptive::HYBRID:
+			count (F, v.hybrid (), nonzero, words, typename VectorTraits<Ring, typename Adaptive::Hybrid>::RepresentationType ());
+			break;
+
+		default:
+			count (F, v.dense (), nonzero, words, typename VectorTraits<Ring, typename Adaptive::Dense>::RepresentationType ());
+		}
+	}
+
+	// Representation of an adaptive vector corresponding to a
+	// representation-type
+
+	static Kind kindOf (VectorRepresentationTypes::Dense)    { return Adaptive::DENSE; }
+	static Kind kindOf (VectorRepresentationTypes::Dense01)  { return Adaptive::DENSE; }
+	static Kind kindOf (VectorRepresentationTypes::Sparse)   { return Adaptive::SPARSE; }
+	static Kind kindOf (VectorRepresentationTypes::Sparse01) { return Adaptive::SPARSE; }
+	static Kind kindOf (VectorRepresentationTypes::Hybrid01) { return Adaptive::HYBRID; }
+
+	// Copy an ordinary vector into the representation which y
+	// currently has
+
+	template <class Modules, class Vector>
+	static void assign (const Ring &F, Modules &M, const Vector &x, Adaptive &y)
+	{
+		switch (y.kind ()) {
+		case Adaptive::SPARSE: _copy<Ring, typename Modules::Tag>::op (F, M, x, y.sparse ()); break;
+		case Adaptive::HYBRID: _copy<Ring, typename Modules::Tag>::op (F, M, x, y.hybrid ()); break;
+		default:               _copy<Ring, typename Modules::Tag>::op (F, M, x, y.dense ());
+		}
+	}
+
+public:
+	/// Move the entries of v into the given representation
+	template <class Modules>
+	static void convert (const Ring &F, Modules &M, Adaptive &v, Kind kind)
+	{
+		if (v.kind () == kind)
+			return;
+
+		Adaptive tmp (v.dim ());
+		tmp.setThresholds (v.sparseMax (), v.hybridMax ());
+		tmp.reset (kind);
+
+		switch (v.kind ()) {
+		case Adaptive::SPARSE: assign (F, M, v.sparse (), tmp); break;
+		case Adaptive::HYBRID: assign (F, M, v.hybrid (), tmp); break;
+		default:               assign (F, M, v.dense (), tmp);
+		}
+
+		v.swap (tmp);
+	}
+
+	/** Move v to a denser representation if it has filled in
+	 *
+	 * This only looks at the number of stored entries, so it costs
+	 * nothing unless the vector must actually be converted.
+	 */
+	template <class Modules>
+	static void promote (const Ring &F, Modules &M, Adaptive &v)
+	{
+		size_t nonzero, words;
+
+		switch (v.kind ()) {
+		case Adaptive::SPARSE:
+			if ((double) v.sparse ().size () <= v.sparseMax () * (double) v.dim ())
+				return;
+
+			break;
+
+		case Adaptive::HYBRID:
+			if ((double) v.hybrid ().size () <= v.hybridMax () * (double) Adaptive::Storage::words (v.dim ()))
+				return;
+
+			break;
+
+		default:
+			return;
+		}
+
+		count (F, v, nonzero, words);
+		convert (F, M, v, v.classify (nonzero, words));
+	}
+
+	/** Move v to the representation appropriate to its density
+	 *
+	 * Unlike @ref promote, this counts the nonzero entries of v and
+	 * may move it to a sparser representation.
+	 */
+	template <class Modules>
+	static void adapt (const Ring &F, Modules &M, Adaptive &v)
+	{
+		size_t nonzero, words;
+
+		count (F, v, nonzero, words);
+
+		Kind kind = v.classify (nonzero, words);
+
+		if (kind < v.kind ())
+			kind = std::max (kind, v.classify (nonzero, words, 0.5));
+
+		convert (F, M, v, kind);
+	}
+
+	template <class Modules, class T, class Vector2>
+	static T &dot (const Ring &F, Modules &M, T &res, const Adaptive &x, const Vector2 &y)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _dot<Ring, typename Modules::Tag>::op (F, M, res, x.sparse (), y);
+		case Adaptive::HYBRID: return _dot<Ring, typename Modules::Tag>::op (F, M, res, x.hybrid (), y);
+		default:               return _dot<Ring, typename Modules::Tag>::op (F, M, res, x.dense (), y);
+		}
+	}
+
+	template <class Modules, class Vector2>
+	static Vector2 &copyFrom (const Ring &F, Modules &M, const Adaptive &x, Vector2 &y)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _copy<Ring, typename Modules::Tag>::op (F, M, x.sparse (), y);
+		case Adaptive::HYBRID: return _copy<Ring, typename Modules::Tag>::op (F, M, x.hybrid (), y);
+		default:               return _copy<Ring, typename Modules::Tag>::op (F, M, x.dense (), y);
+		}
+	}
+
+	template <class Modules, class Vector1>
+	static Adaptive &copyTo (const Ring &F, Modules &M, const Vector1 &x, Adaptive &y)
+	{
+		y.reset (kindOf (typename VectorTraits<Ring, Vector1>::RepresentationType ()));
+		assign (F, M, x, y);
+		adapt (F, M, y);
+		return y;
+	}
+
+	template <class Modules>
+	static Adaptive &copy (const Ring &F, Modules &M, const Adaptive &x, Adaptive &y)
+	{
+		if (&x == &y)
+			return y;
+
+		y.reset (x.kind ());
+
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: assign (F, M, x.sparse (), y); break;
+		case Adaptive::HYBRID: assign (F, M, x.hybrid (), y); break;
+		default:               assign (F, M, x.dense (), y);
+		}
+
+		adapt (F, M, y);
+		return y;
+	}
+
+	template <class Modules, class Vector2>
+	static Vector2 &axpyFrom (const Ring &F, Modules &M, const typename Ring::Element &a, const Adaptive &x, Vector2 &y)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _axpy<Ring, typename Modules::Tag>::op (F, M, a, x.sparse (), y);
+		case Adaptive::HYBRID: return _axpy<Ring, typename Modules::Tag>::op (F, M, a, x.hybrid (), y);
+		default:               return _axpy<Ring, typename Modules::Tag>::op (F, M, a, x.dense (), y);
+		}
+	}
+
+	template <class Modules, class Vector1>
+	static Adaptive &axpyTo (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, Adaptive &y)
+	{
+		// Adding a vector of a denser representation would fill y
+		// in anyway, so convert y first
+		Kind kind = kindOf (typename VectorTraits<Ring, Vector1>::RepresentationType ());
+
+		if (kind > y.kind ())
+			convert (F, M, y, kind);
+
+		switch (y.kind ()) {
+		case Adaptive::SPARSE: _axpy<Ring, typename Modules::Tag>::op (F, M, a, x, y.sparse ()); break;
+		case Adaptive::HYBRID: _axpy<Ring, typename Modules::Tag>::op (F, M, a, x, y.hybrid ()); break;
+		default:               _axpy<Ring, typename Modules::Tag>::op (F, M, a, x, y.dense ());
+		}
+
+		promote (F, M, y);
+		return y;
+	}
+
+	template <class Modules>
+	static Adaptive &axpy (const Ring &F, Modules &M, const typename Ring::Element &a, const Adaptive &x, Adaptive &y)
+	{
+		if (x.kind () > y.kind ())
+			convert (F, M, y, x.kind ());
+
+		return axpyFrom (F, M, a, x, y);
+	}
+
+	template <class Modules>
+	static Adaptive &scal (const Ring &F, Modules &M, const typename Ring::Element &a, Adaptive &x)
+	{
+		if (F.isZero (a)) {
+			x.reset (Adaptive::SPARSE);
+			return x;
+		}
+
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: _scal<Ring, typename Modules::Tag>::op (F, M, a, x.sparse ()); break;
+		case Adaptive::HYBRID: _scal<Ring, typename Modules::Tag>::op (F, M, a, x.hybrid ()); break;
+		default:               _scal<Ring, typename Modules::Tag>::op (F, M, a, x.dense ());
+		}
+
+		return x;
+	}
+
+	template <class Modules, class Iterator>
+	static Adaptive &permute (const Ring &F, Modules &M, Iterator P_begin, Iterator P_end, Adaptive &v)
+	{
+		switch (v.kind ()) {
+		case Adaptive::SPARSE: _permute<Ring, typename Modules::Tag>::op (F, M, P_begin, P_end, v.sparse ()); break;
+		case Adaptive::HYBRID: _permute<Ring, typename Modules::Tag>::op (F, M, P_begin, P_end, v.hybrid ()); break;
+		default:               _permute<Ring, typename Modules::Tag>::op (F, M, P_begin, P_end, v.dense ());
+		}
+
+		return v;
+	}
+
+	template <class Modules, class Vector2>
+	static bool equal (const Ring &F, Modules &M, const Adaptive &x, const Vector2 &y)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _equal<Ring, typename Modules::Tag>::op (F, M, x.sparse (), y);
+		case Adaptive::HYBRID: return _equal<Ring, typename Modules::Tag>::op (F, M, x.hybrid (), y);
+		default:               return _equal<Ring, typename Modules::Tag>::op (F, M, x.dense (), y);
+		}
+	}
+
+	template <class Modules>
+	static bool is_zero (const Ring &F, Modules &M, const Adaptive &x)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _is_zero<Ring, typename Modules::Tag>::op (F, M, x.sparse ());
+		case Adaptive::HYBRID: return _is_zero<Ring, typename Modules::Tag>::op (F, M, x.hybrid ());
+		default:               return _is_zero<Ring, typename Modules::Tag>::op (F, M, x.dense ());
+		}
+	}
+
+	template <class Modules, class T>
+	static long head (const Ring &F, Modules &M, T &a, const Adaptive &x)
+	{
+		switch (x.kind ()) {
+		case Adaptive::SPARSE: return _head<Ring, typename Modules::Tag>::op (F, M, a, x.sparse ());
+		case Adaptive::HYBRID: return _head<Ring, typename Modules::Tag>::op (F, M, a, x.hybrid ());
+		default:               return _head<Ring, typename Modules::Tag>::op (F, M, a, x.dense ());
+		}
+	}
+
+	// Vectors are read in dense format in all representations, so
+	// read into the dense representation and adapt afterwards
+	template <class Modules>
+	static std::istream &read (const Ring &F, Modules &M, std::istream &is, Adaptive &v)
+	{
+		v.reset (Adaptive::DENSE);
+		_read<Ring, typename Modules::Tag>::op (F, M, is, v.dense ());
+		adapt (F, M, v);
+		return is;
+	}
+
+	template <class Modules>
+	static std::ostream &write (const Ring &F, Modules &M, std::ostream &os, const Adaptive &v)
+	{
+		switch (v.kind ()) {
+		case Adaptive::SPARSE: return _write<Ring, typename Modules::Tag>::op (F, M, os, v.sparse ());
+		case Adaptive::HYBRID: return _write<Ring, typename Modules::Tag>::op (F, M, os, v.hybrid ());
+		default:               return _write<Ring, typename Modules::Tag>::op (F, M, os, v.dense ());
+		}
+	}
+};
+
+} // namespace BLAS1
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL1_ADAPTIVE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
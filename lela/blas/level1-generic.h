@@ -17,6 +17,7 @@
 #include "lela/blas/context.h"
 #include "lela/vector/traits.h"
 #include "lela/blas/level1-ll.h"
+#include "lela/blas/level1-adaptive.h"
 
 // These are needed for the specialisations of std::swap to that the correct overload is used
 #include "lela/vector/bit-subvector-word-aligned.h"
@@ -49,6 +50,21 @@ class _dot<Ring, typename GenericModule<Ring>::Tag>
 	static T &dot_impl (const Ring &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
 			    VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const Ring &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<Ring>::dot (F, M, res, x, y); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const Ring &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::dot (F, M, res, y, x); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const Ring &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::dot (F, M, res, x, y); }
+
 public:
 	template <class Modules, class T, class Vector1, class Vector2>
 	static T &op (const Ring &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y)
@@ -85,6 +101,21 @@ class _copy<Ring, typename GenericModule<Ring>::Tag>
 	static Vector2 &copy_impl (const Ring &F, Modules &M, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const Ring &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<Ring>::copyFrom (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const Ring &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::copyTo (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const Ring &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::copy (F, M, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &op (const Ring &F, Modules &M, const Vector1 &x, Vector2 &y)
@@ -112,6 +143,21 @@ class _axpy<Ring, typename GenericModule<Ring>::Tag>
 	static Vector2 &axpy_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const Ring &F, Modules &M, const typename Ring::Element & a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<Ring>::axpyFrom (F, M, a, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const Ring &F, Modules &M, const typename Ring::Element & a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::axpyTo (F, M, a, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const Ring &F, Modules &M, const typename Ring::Element & a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::axpy (F, M, a, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, Vector2 &y)
@@ -129,6 +175,10 @@ class _scal<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Vector>
 	static Vector &scal_impl (const Ring &F, Modules &M, const typename Ring::Element &a, Vector &x, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector>
+	static Vector &scal_impl (const Ring &F, Modules &M, const typename Ring::Element & a, Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::scal (F, M, a, x); }
+
 public:
 	template <class Modules, class Vector>
 	static Vector &op (const Ring &F, Modules &M, const typename Ring::Element &a, Vector &x)
@@ -145,6 +195,10 @@ class _permute<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Iterator, class Vector>
 	static Vector &permute_impl (const Ring &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Iterator, class Vector>
+	static Vector &permute_impl (const Ring &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::permute (F, M, P_begin, P_end, v); }
+
 public:
 	template <class Modules, class Iterator, class Vector>
 	static Vector &op (const Ring &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v)
@@ -172,6 +226,21 @@ class _equal<Ring, typename GenericModule<Ring>::Tag>
 	static bool equal_impl (const Ring &F, Modules &M, const Vector1 &x, const Vector2 &y,
 				VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const Ring &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<Ring>::equal (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const Ring &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::equal (F, M, y, x); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const Ring &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::equal (F, M, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static bool op (const Ring &F, Modules &M, const Vector1 &x, const Vector2 &y)
@@ -189,6 +258,10 @@ class _is_zero<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Vector>
 	static bool is_zero_impl (const Ring &F, Modules &M, const Vector &x, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector>
+	static bool is_zero_impl (const Ring &F, Modules &M, const Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::is_zero (F, M, x); }
+
 public:
 	template <class Modules, class Vector>
 	static bool op (const Ring &F, Modules &M, const Vector &x)
@@ -200,14 +273,18 @@ template <class Ring>
 class _head<Ring, typename GenericModule<Ring>::Tag>
 {
 	template <class Modules, class Vector>
-	static int head_impl (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Dense);
+	static long head_impl (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Dense);
 
 	template <class Modules, class Vector>
-	static int head_impl (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Sparse);
+	static long head_impl (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Sparse);
+
+	template <class Modules, class T, class Vector>
+	static long head_impl (const Ring &F, Modules &M, T &a, const Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::head (F, M, a, x); }
 
 public:
 	template <class Modules, class Vector>
-	static int op (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x)
+	static long op (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x)
 		{ return head_impl (F, M, a, x,
 				    typename VectorTraits<Ring, Vector>::RepresentationType ()); }
 };
@@ -221,6 +298,10 @@ class _read<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Vector>
 	static std::istream &read_impl (const Ring &F, Modules &M, std::istream &is, Vector &v, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector>
+	static std::istream &read_impl (const Ring &F, Modules &M, std::istream &is, Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::read (F, M, is, v); }
+
 public:
 	template <class Modules, class Vector>
 	static std::istream &op (const Ring &F, Modules &M, std::istream &is, Vector &v)
@@ -237,6 +318,10 @@ class _write<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Vector>
 	static std::ostream &write_impl (const Ring &F, Modules &M, std::ostream &os, const Vector &v, VectorRepresentationTypes::Sparse);
 
+	template <class Modules, class Vector>
+	static std::ostream &write_impl (const Ring &F, Modules &M, std::ostream &os, const Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<Ring>::write (F, M, os, v); }
+
 public:
 	template <class Modules, class Vector>
 	static std::ostream &op (const Ring &F, Modules &M, std::ostream &os, const Vector &v)
@@ -431,7 +431,7 @@ bool _is_zero<Ring, typename GenericModule<Ring>::Tag>::is_zero_impl
 
 template <class Ring>
 template <class Modules, class Vector>
-int _head<Ring, typename GenericModule<Ring>::Tag>::head_impl
+long _head<Ring, typename GenericModule<Ring>::Tag>::head_impl
 	(const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Dense)
 {
 	typename Vector::const_iterator i;
@@ -448,7 +448,7 @@ int _head<Ring, typename GenericModule<Ring>::Tag>::head_impl
 
 template <class Ring>
 template <class Modules, class Vector>
-int _head<Ring, typename GenericModule<Ring>::Tag>::head_impl
+long _head<Ring, typename GenericModule<Ring>::Tag>::head_impl
 	(const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x, VectorRepresentationTypes::Sparse)
 {
 	if (x.empty ())
@@ -18,6 +18,7 @@
 #include "lela/ring/gf2.h"
 #include "lela/vector/traits.h"
 #include "lela/blas/level1-ll.h"
+#include "lela/blas/level1-adaptive.h"
 
 namespace LELA
 {
@@ -67,6 +68,21 @@ class _dot<GF2, GenericModule<GF2>::Tag>
 	static reference &dot_impl (const GF2 &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y,
 				    VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const GF2 &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<GF2>::dot (F, M, res, x, y); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const GF2 &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::dot (F, M, res, y, x); }
+
+	template <class Modules, class T, class Vector1, class Vector2>
+	static T &dot_impl (const GF2 &F, Modules &M, T &res, const Vector1 &x, const Vector2 &y,
+			    VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::dot (F, M, res, x, y); }
+
 public:
 	template <class Modules, class reference, class Vector1, class Vector2>
 	static reference &op (const GF2 &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y)
@@ -126,6 +142,21 @@ class _copy<GF2, GenericModule<GF2>::Tag>
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Hybrid01)
 		{ y.assign (x.begin (), x.end ()); return y; }
 
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<GF2>::copyFrom (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::copyTo (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &copy_impl (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::copy (F, M, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &op (const GF2 &F, Modules &M, const Vector1 &x, Vector2 &y)
@@ -169,6 +200,27 @@ class _axpy<GF2, GenericModule<GF2>::Tag>
 	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
 				   VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<GF2>::axpyFrom (F, M, a, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::axpyTo (F, M, a, x, y); }
+
+	// Needed to resolve ambiguity with (Dense01, Generic) above
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Dense01, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::axpyTo (F, M, a, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static Vector2 &axpy_impl (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y,
+				   VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::axpy (F, M, a, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static Vector2 &op (const GF2 &F, Modules &M, bool a, const Vector1 &x, Vector2 &y)
@@ -192,6 +244,10 @@ class _scal<GF2, GenericModule<GF2>::Tag>
 	static Vector &scal_impl (const GF2 &F, Modules &M, bool a, Vector &x, VectorRepresentationTypes::Hybrid01)
 		{ if (!a) x.clear (); return x; }
 
+	template <class Modules, class Vector>
+	static Vector &scal_impl (const GF2 &F, Modules &M, bool a, Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::scal (F, M, a, x); }
+
 public:
 	template <class Modules, class Vector>
 	static Vector &op (const GF2 &F, Modules &M, bool a, Vector &x)
@@ -211,6 +267,10 @@ class _permute<GF2, GenericModule<GF2>::Tag>
 	template <class Modules, class Iterator, class Vector>
 	static Vector &permute_impl (const GF2 &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class Iterator, class Vector>
+	static Vector &permute_impl (const GF2 &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::permute (F, M, P_begin, P_end, v); }
+
 public:
 	template <class Modules, class Iterator, class Vector>
 	static Vector &op (const GF2 &F, Modules &M, Iterator P_begin, Iterator P_end, Vector &v)
@@ -260,6 +320,21 @@ class _equal<GF2, GenericModule<GF2>::Tag>
 	static bool equal_impl (const GF2 &F, Modules &M, const Vector1 &x, const Vector2 &y,
 				VectorRepresentationTypes::Hybrid01, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const GF2 &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Generic)
+		{ return _adaptive<GF2>::equal (F, M, x, y); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const GF2 &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Generic, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::equal (F, M, y, x); }
+
+	template <class Modules, class Vector1, class Vector2>
+	static bool equal_impl (const GF2 &F, Modules &M, const Vector1 &x, const Vector2 &y,
+				VectorRepresentationTypes::Adaptive, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::equal (F, M, x, y); }
+
 public:
 	template <class Modules, class Vector1, class Vector2>
 	static bool op (const GF2 &F, Modules &M, const Vector1 &x, const Vector2 &y)
@@ -282,6 +357,10 @@ class _is_zero<GF2, GenericModule<GF2>::Tag>
 	static bool is_zero_impl (const GF2 &F, Modules &M, const Vector &x, VectorRepresentationTypes::Hybrid01)
 		{ return x.empty (); }
 
+	template <class Modules, class Vector>
+	static bool is_zero_impl (const GF2 &F, Modules &M, const Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::is_zero (F, M, x); }
+
 public:
 	template <class Modules, class Vector>
 	static bool op (const GF2 &F, Modules &M, const Vector &x)
@@ -293,18 +372,22 @@ template <>
 class _head<GF2, GenericModule<GF2>::Tag>
 {
 	template <class Modules, class reference, class Vector>
-	static int head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Dense01);
+	static long head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Dense01);
 
 	template <class Modules, class reference, class Vector>
-	static int head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Sparse01)
+	static long head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Sparse01)
 		{ if (x.empty ()) return -1; a = true; return x.front (); }
 
 	template <class Modules, class reference, class Vector>
-	static int head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Hybrid01);
+	static long head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Hybrid01);
+
+	template <class Modules, class T, class Vector>
+	static long head_impl (const GF2 &F, Modules &M, T &a, const Vector &x, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::head (F, M, a, x); }
 
 public:
 	template <class Modules, class reference, class Vector>
-	static int op (const GF2 &F, Modules &M, reference &a, const Vector &x)
+	static long op (const GF2 &F, Modules &M, reference &a, const Vector &x)
 		{ return head_impl (F, M, a, x,
 				    typename VectorTraits<GF2, Vector>::RepresentationType ()); }
 };
@@ -318,6 +401,10 @@ class _read<GF2, GenericModule<GF2>::Tag>
 	template <class Modules, class Vector>
 	static std::istream &read_impl (const GF2 &F, Modules &M, std::istream &is, const Vector &v, VectorRepresentationTypes::Sparse01);
 
+	template <class Modules, class Vector>
+	static std::istream &read_impl (const GF2 &F, Modules &M, std::istream &is, Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::read (F, M, is, v); }
+
 public:
 	template <class Modules, class Vector>
 	static std::istream &op (const GF2 &F, Modules &M, std::istream &is, Vector &v)
@@ -337,6 +424,10 @@ class _write<GF2, GenericModule<GF2>::Tag>
 	template <class Modules, class Vector>
 	static std::ostream &write_impl (const GF2 &F, Modules &M, std::ostream &os, const Vector &v, VectorRepresentationTypes::Hybrid01);
 
+	template <class Modules, class Vector>
+	static std::ostream &write_impl (const GF2 &F, Modules &M, std::ostream &os, const Vector &v, VectorRepresentationTypes::Adaptive)
+		{ return _adaptive<GF2>::write (F, M, os, v); }
+
 public:
 	template <class Modules, class Vector>
 	static std::ostream &op (const GF2 &F, Modules &M, std::ostream &os, const Vector &v)
@@ -256,7 +256,7 @@ Vector2 &_copy<GF2, GenericModule<GF2>::Tag>::copy_impl (const GF2 &F, Modules &
 	y.clear ();
 
 	for (i = x.begin (); i != x.end (); ++i)
-		for (t = Vector1::Endianness::e_0, idx = i->first << WordTraits<typename Vector1::word_type>::logof_size; t != 0; t = Vector1::Endianness::shift_right (t, 1), ++idx)
+		for (t = Vector1::Endianness::e_0, idx = (size_t) i->first << WordTraits<typename Vector1::word_type>::logof_size; t != 0; t = Vector1::Endianness::shift_right (t, 1), ++idx)
 			if (i->second & t) y.push_back (idx);
 
 	return y;
@@ -587,14 +587,14 @@ bool _equal<GF2, GenericModule<GF2>::Tag>::equal_impl (const GF2 &F, Modules &M,
 {
 	typename Vector1::const_iterator i;
 	typename Vector2::const_iterator j = y.begin ();
-	typename Vector1::index_type idx;
+	size_t idx;
 	typename Vector1::word_type t;
 
 	for (i = x.begin (); i != x.end (); ++i) {
 		if (j == y.end () || *j < i->first)
 			return false;
 
-		idx = i->first << WordTraits<typename Vector1::word_type>::logof_size;
+		idx = (size_t) i->first << WordTraits<typename Vector1::word_type>::logof_size;
 		t = Vector1::Endianness::e_0;
 
 		for (; t != 0; t = Vector1::Endianness::shift_right (t, 1), ++idx) {
@@ -656,7 +656,7 @@ inline int head_in_word (word v)
 }
 
 template <class Modules, class reference, class Vector>
-int _head<GF2, GenericModule<GF2>::Tag>::head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Dense01)
+long _head<GF2, GenericModule<GF2>::Tag>::head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Dense01)
 {
 	typename Vector::const_word_iterator i;
 	size_t idx;
@@ -679,14 +679,14 @@ int _head<GF2, GenericModule<GF2>::Tag>::head_impl (const GF2 &F, Modules &M, re
 }
 
 template <class Modules, class reference, class Vector>
-int _head<GF2, GenericModule<GF2>::Tag>::head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Hybrid01)
+long _head<GF2, GenericModule<GF2>::Tag>::head_impl (const GF2 &F, Modules &M, reference &a, const Vector &x, VectorRepresentationTypes::Hybrid01)
 {
 	if (x.empty ())
 		return -1;
 	else {
 		a = true;
 		return head_in_word<typename Vector::word_type, typename Vector::Endianness> (x.front ().second)
-			+ (x.front ().first << WordTraits<typename Vector::word_type>::logof_size);
+			+ ((long) x.front ().first << WordTraits<typename Vector::word_type>::logof_size);
 	}
 }
 
@@ -774,13 +774,13 @@ std::ostream &_write<GF2, GenericModule<GF2>::Tag>::write_impl (const GF2 &F, Mo
 								VectorRepresentationTypes::Hybrid01)
 {
 	typename Vector::const_iterator i;
-	typename Vector::index_type idx = 0;
+	size_t idx = 0;
 	typename Vector::word_type mask;
 
 	os << "[ ";
 
 	for (i = x.begin (); i != x.end (); ++i) {
-		while (++idx <= i->first << WordTraits<typename Vector::word_type>::logof_size)
+		while (++idx <= (size_t) i->first << WordTraits<typename Vector::word_type>::logof_size)
 			os << "0 ";
 
 		for (mask = Vector::Endianness::e_0; mask != 0; mask = Vector::Endianness::shift_right (mask, 1)) {
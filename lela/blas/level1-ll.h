@@ -104,7 +104,7 @@ class _head
 {
 public:
 	template <class Modules, class Vector>
-	static int op (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x)
+	static long op (const Ring &F, Modules &M, typename Ring::Element &a, const Vector &x)
 		{ return _head<Ring, typename ModulesTag::Parent>::op (F, M, a, x); }
 };
 
@@ -126,6 +126,10 @@ public:
 		{ return _write<Ring, typename ModulesTag::Parent>::op (F, M, os, v); }
 };
 
+// Dispatch on adaptive vectors, see lela/blas/level1-adaptive.h
+template <class Ring>
+class _adaptive;
+
 } // namespace BLAS1
 
 } // namespace LELA
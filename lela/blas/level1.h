@@ -15,6 +15,7 @@
 
 #include "lela/blas/context.h"
 #include "lela/blas/level1-ll.h"
+#include "lela/blas/level1-adaptive.h"
 #include "lela/util/property.h"
 #include "lela/vector/bit-iterator.h"
 
@@ -137,6 +138,22 @@ template <class Ring, class Modules, class Iterator, class Vector>
 Vector &permute (Context<Ring, Modules> &ctx, Iterator P_begin, Iterator P_end, Vector &v)
 	{ return _permute<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, P_begin, P_end, v); }
 
+/** Move an adaptive vector to the representation appropriate to its density
+ *
+ * Operations which write to an @ref AdaptiveVector move it to a
+ * denser representation as it fills in, but only this and copying
+ * move it to a sparser one, since that requires counting its nonzero
+ * entries.
+ *
+ * @param ctx @ref Context object for calculation
+ * @param v Adaptive vector
+ * @returns Reference to v
+ */
+
+template <class Ring, class Modules>
+AdaptiveVector<typename Ring::Element> &adapt (Context<Ring, Modules> &ctx, AdaptiveVector<typename Ring::Element> &v)
+	{ _adaptive<Ring>::adapt (ctx.F, ctx.M, v); return v; }
+
 //@} Operations on vectors
 
 /// @name Queries on vectors
@@ -176,7 +193,7 @@ bool is_zero (Context<Ring, Modules> &ctx, const Vector &x)
  */
 
 template <class Ring, class Modules, class Vector>
-int head (Context<Ring, Modules> &ctx, typename Ring::Element &a, const Vector &x)
+long head (Context<Ring, Modules> &ctx, typename Ring::Element &a, const Vector &x)
 	{ return _head<Ring, typename Modules::Tag>::op (ctx.F, ctx.M, a, x); }
 
 //@} Queries on vectors
@@ -0,0 +1,79 @@
+/* lela/blas/level2-counting.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Level 2 BLAS over CountingRing, passed to the modules of the
+ * underlying ring
+ * ------------------------------------
+ * 
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_COUNTING_H
+#define __BLAS_LEVEL2_COUNTING_H
+
+#include "lela/blas/context.h"
+#include "lela/ring/counting.h"
+#include "lela/blas/level2-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS2
+{
+
+template <class Ring>
+class _gemv<CountingRing<Ring>, CountingModuleTag<Ring> >
+{
+public:
+	template <class Modules, class Matrix, class Vector1, class Vector2>
+	static Vector2 &op (const CountingRing<Ring> &F, Modules &M, const typename Ring::Element &a, const Matrix &A, const Vector1 &x, const typename Ring::Element &b, Vector2 &y)
+	{
+		if (!CountingModule<Ring>::isDenseMatrix (A) || !CountingModule<Ring>::isDense (x) || !CountingModule<Ring>::isDense (y))
+			return _gemv<CountingRing<Ring>, typename CountingModuleTag<Ring>::Parent>::op (F, M, a, A, x, b, y);
+
+		OperationCounts c;
+		c.muls = c.adds = (unsigned long long) A.rowdim () * A.coldim ();
+		F.countOperations (c);
+
+		return _gemv<Ring, typename AllModules<Ring>::Tag>::op (F.ring (), M.forward (), a, A, x, b, y);
+	}
+};
+
+template <class Ring>
+class _trsv<CountingRing<Ring>, CountingModuleTag<Ring> >
+{
+public:
+	template <class Modules, class Matrix, class Vector>
+	static Vector &op (const CountingRing<Ring> &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne)
+	{
+		if (!CountingModule<Ring>::isDenseMatrix (A) || !CountingModule<Ring>::isDense (x))
+			return _trsv<CountingRing<Ring>, typename CountingModuleTag<Ring>::Parent>::op (F, M, A, x, type, diagIsOne);
+
+		unsigned long long n = A.rowdim ();
+		OperationCounts c;
+		c.adds = n * (n - 1) / 2;
+		c.muls = c.adds + (diagIsOne ? 0 : n);
+		c.invs = diagIsOne ? 0 : n;
+		F.countOperations (c);
+
+		return _trsv<Ring, typename AllModules<Ring>::Tag>::op (F.ring (), M.forward (), A, x, type, diagIsOne);
+	}
+};
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_COUNTING_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
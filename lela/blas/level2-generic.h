@@ -144,6 +144,41 @@ class _trsv<Ring, typename GenericModule<Ring>::Tag>
 				  VectorRepresentationTypes::Dense01)
 		{ return trsv_impl (F, M, A, x, type, diagIsOne, VectorRepresentationTypes::Dense ()); }
 
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_impl (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+				  VectorRepresentationTypes::Sparse)
+		{ return trsv_sparse (F, M, A, x, type, diagIsOne, typename Matrix::IteratorType ()); }
+
+	// Without sparse columns there is no way to avoid touching
+	// all of A, so the solve is done on a dense copy of x
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_sparse (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+				    MatrixIteratorTypes::Generic);
+
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_sparse (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+				    MatrixIteratorTypes::Col)
+		{ return trsv_sparse_col (F, M, A, x, type, diagIsOne,
+					  typename VectorTraits<Ring, typename std::iterator_traits<typename Matrix::ConstColIterator>::value_type>::RepresentationType ()); }
+
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_sparse (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+				    MatrixIteratorTypes::RowCol)
+		{ return trsv_sparse (F, M, A, x, type, diagIsOne, MatrixIteratorTypes::Col ()); }
+
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_sparse_col (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+					VectorRepresentationTypes::Generic)
+		{ return trsv_sparse (F, M, A, x, type, diagIsOne, MatrixIteratorTypes::Generic ()); }
+
+	// Gilbert-Peierls: a depth-first search from the nonzero
+	// entries of x over the graph of A finds the entries of the
+	// solution which may be nonzero, so that only the corresponding
+	// columns of A are touched
+	template <class Modules, class Matrix, class Vector>
+	static Vector &trsv_sparse_col (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+					VectorRepresentationTypes::Sparse);
+
 public:
 	template <class Modules, class Matrix, class Vector>
 	static Vector &op (const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne)
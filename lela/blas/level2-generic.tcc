@@ -280,6 +280,155 @@ Vector &_trsv<Ring, typename GenericModule<Ring>::Tag>::trsv_impl
 	}
 }
 
+template <class Ring>
+template <class Modules, class Matrix, class Vector>
+Vector &_trsv<Ring, typename GenericModule<Ring>::Tag>::trsv_sparse
+	(const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+	 MatrixIteratorTypes::Generic)
+{
+	lela_check (A.coldim () == A.rowdim ());
+	lela_check (VectorUtils::hasDim<Ring> (x, A.coldim ()));
+
+	typename LELA::Vector<Ring>::Dense y (A.coldim ());
+
+	BLAS1::_copy<Ring, typename Modules::Tag>::op (F, M, x, y);
+	_trsv<Ring, typename Modules::Tag>::op (F, M, A, y, type, diagIsOne);
+	return BLAS1::_copy<Ring, typename Modules::Tag>::op (F, M, y, x);
+}
+
+template <class Ring>
+template <class Modules, class Matrix, class Vector>
+Vector &_trsv<Ring, typename GenericModule<Ring>::Tag>::trsv_sparse_col
+	(const Ring &F, Modules &M, const Matrix &A, Vector &x, TriangularMatrixType type, bool diagIsOne,
+	 VectorRepresentationTypes::Sparse)
+{
+	lela_check (A.coldim () == A.rowdim ());
+	lela_check (VectorUtils::hasDim<Ring> (x, A.coldim ()));
+
+	typedef typename Matrix::ConstColIterator ColIterator;
+	typedef typename std::iterator_traits<ColIterator>::value_type Column;
+	typedef typename Column::const_iterator EntryIterator;
+
+	size_t n = A.coldim ();
+
+	// The dense accumulator and the visited-marks are allocated for
+	// each solve, so that solves sharing a context may run in
+	// parallel
+	std::vector<bool> visited (n, false);
+	std::vector<typename Ring::Element> w (n);
+
+	ColIterator cols = A.colBegin ();
+
+	// Symbolic phase: depth-first search from the nonzero entries of
+	// x. An entry j of the solution enters entry i if and only if A
+	// has a nonzero off-diagonal entry at (i, j) on the triangular
+	// side. The reach is recorded in postorder, so that its reverse
+	// is a topological order in which the columns may be processed.
+	// Each stack-frame holds a node and the position of the next
+	// entry of its column to be explored.
+
+	std::vector<size_t> reach;
+	std::vector<std::pair<size_t, size_t> > stack;
+
+	typename Vector::const_iterator i_x;
+
+	for (i_x = x.begin (); i_x != x.end (); ++i_x) {
+		if (visited[i_x->first])
+			continue;
+
+		visited[i_x->first] = true;
+		stack.push_back (std::pair<size_t, size_t> (i_x->first, 0));
+
+		while (!stack.empty ()) {
+			size_t j = stack.back ().first;
+			size_t &pos = stack.back ().second;
+			ColIterator col = cols + j;
+			EntryIterator e = col->begin () + pos, end = col->end ();
+			bool descended = false;
+
+			for (; e != end; ++e) {
+				size_t i = e->first;
+
+				if ((type == UpperTriangular) ? (i >= j) : (i <= j))
+					continue;
+
+				if (!visited[i]) {
+					visited[i] = true;
+					pos = e - col->begin () + 1;
+					stack.push_back (std::pair<size_t, size_t> (i, 0));
+					descended = true;
+					break;
+				}
+			}
+
+			if (!descended) {
+				reach.push_back (j);
+				stack.pop_back ();
+			}
+		}
+	}
+
+	// Numeric phase: only the entries in the reach are cleared and
+	// updated
+
+	std::vector<size_t>::const_iterator i_r;
+	std::vector<size_t>::reverse_iterator ri_r;
+
+	for (i_r = reach.begin (); i_r != reach.end (); ++i_r)
+		F.copy (w[*i_r], F.zero ());
+
+	for (i_x = x.begin (); i_x != x.end (); ++i_x)
+		F.copy (w[i_x->first], i_x->second);
+
+	typename Ring::Element d, negwj;
+
+	for (ri_r = reach.rbegin (); ri_r != reach.rend (); ++ri_r) {
+		size_t j = *ri_r;
+
+		if (F.isZero (w[j]))
+			continue;
+
+		ColIterator col = cols + j;
+
+		if (!diagIsOne) {
+			EntryIterator diag = std::lower_bound (col->begin (), col->end (), j, VectorUtils::FindSparseEntryLB ());
+
+			if (diag == col->end () || diag->first != j)
+				throw DiagonalEntryNotInvertible ();
+
+			F.copy (d, diag->second);
+
+			if (!F.invin (d))
+				throw DiagonalEntryNotInvertible ();
+
+			F.mulin (w[j], d);
+		}
+
+		F.neg (negwj, w[j]);
+
+		for (EntryIterator e = col->begin (); e != col->end (); ++e) {
+			size_t i = e->first;
+
+			if ((type == UpperTriangular) ? (i >= j) : (i <= j))
+				continue;
+
+			F.axpyin (w[i], negwj, e->second);
+		}
+	}
+
+	// Gather the nonzero entries of the solution back into x
+
+	std::sort (reach.begin (), reach.end ());
+
+	x.clear ();
+
+	for (i_r = reach.begin (); i_r != reach.end (); ++i_r)
+		if (!F.isZero (w[*i_r]))
+			x.push_back (typename Vector::value_type (*i_r, w[*i_r]));
+
+	return x;
+}
+
 template <class Ring>
 template <class Modules, class Vector1, class Vector2, class Matrix>
 Matrix &_ger<Ring, typename GenericModule<Ring>::Tag>::ger_impl
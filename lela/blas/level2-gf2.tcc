@@ -191,7 +191,7 @@ Vector2 &_gemv<GF2, GenericModule<GF2>::Tag>::gemv_impl (const GF2 &F, Modules &
 	typename Matrix::ConstColIterator i_A;
 	typename Vector1::const_iterator i_x;
 	typename Vector1::word_type t;
-	typename Vector1::index_type idx;
+	size_t idx;
 
 	if (!b)
 		BLAS1::_scal<GF2, typename Modules::Tag>::op (F, M, false, y);
@@ -201,7 +201,7 @@ Vector2 &_gemv<GF2, GenericModule<GF2>::Tag>::gemv_impl (const GF2 &F, Modules &
 
 	for (i_x = x.begin (); i_x != x.end (); ++i_x) {
 		t = Vector1::Endianness::e_0;
-		idx = i_x->first << WordTraits<typename Vector1::word_type>::logof_size;
+		idx = (size_t) i_x->first << WordTraits<typename Vector1::word_type>::logof_size;
 
 		i_A = A.colBegin () + idx;
 
@@ -267,7 +267,7 @@ Matrix &_ger<GF2, GenericModule<GF2>::Tag>::ger_impl (const GF2 &F, Modules &M,
 	size_t row;
 
 	for (i_x = x.begin (); i_x != x.end (); ++i_x) {
-		row = i_x->first << WordTraits<typename Vector1::word_type>::logof_size;
+		row = (size_t) i_x->first << WordTraits<typename Vector1::word_type>::logof_size;
 
 		for (t = Vector1::Endianness::e_0; t != 0 && row < A.rowdim (); t = Vector1::Endianness::shift_right (t, 1), ++row)
 			BLAS1::_axpy<GF2, typename Modules::Tag>::op (F, M, i_x->second & t, y, *(A.rowBegin () + row));
@@ -331,7 +331,7 @@ Matrix &_ger<GF2, GenericModule<GF2>::Tag>::ger_impl (const GF2 &F, Modules &M,
 	size_t col;
 
 	for (i_y = y.begin (); i_y != y.end (); ++i_y) {
-		col = i_y->first << WordTraits<typename Vector1::word_type>::logof_size;
+		col = (size_t) i_y->first << WordTraits<typename Vector1::word_type>::logof_size;
 
 		for (t = Vector1::Endianness::e_0; t != 0 && col < A.coldim (); t = Vector1::Endianness::shift_right (t, 1), ++col)
 			BLAS1::_axpy<GF2, typename Modules::Tag>::op (F, M, i_y->second & t, y, *(A.colBegin () + col));
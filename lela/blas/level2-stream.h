@@ -0,0 +1,240 @@
+/* lela/blas/level2-stream.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * BLAS Level 2 with matrices given as streams of rows
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL2_STREAM_H
+#define __BLAS_LEVEL2_STREAM_H
+
+#include <vector>
+
+#include "lela/blas/context.h"
+#include "lela/blas/level1.h"
+#include "lela/vector/stream.h"
+#include "lela/vector/traits.h"
+#include "lela/matrix/io.h"
+#include "lela/util/error.h"
+
+// Number of rows read from a stream in one batch. When compiled with
+// OpenMP, the next batch is read while the current one is being
+// processed.
+#ifndef STREAM_BATCH_SIZE
+#  define STREAM_BATCH_SIZE 256
+#endif // STREAM_BATCH_SIZE
+
+namespace LELA
+{
+
+namespace BLAS2
+{
+
+/// Read up to batch.size () rows from A into batch, returning the number read
+template <class Ring, class Row>
+size_t _read_batch (VectorStream<Row> &A, std::vector<Row> &batch)
+{
+	size_t k;
+
+	for (k = 0; k < batch.size () && A; ++k) {
+		VectorUtils::ensureDim<Ring, Row> (batch[k], A.dim ());
+		A >> batch[k];
+	}
+
+	return k;
+}
+
+/** Pass each row of A with its index to op, reading ahead by one batch
+ *
+ * An InvalidMatrixInput or LELAError thrown while reading ahead
+ * stops the processing of the current batch and is rethrown once
+ * both sections are done, since exceptions may not leave a parallel
+ * region. A LELAError is rethrown as such, i.e. without its derived
+ * type.
+ */
+template <class Ring, class Row, class Operation>
+void _for_each_row (VectorStream<Row> &A, Operation &op)
+{
+	std::vector<Row> current (STREAM_BATCH_SIZE), next (STREAM_BATCH_SIZE);
+	size_t start = 0, num_current, num_next = 0;
+	volatile bool invalid_input = false, read_failed = false;
+	LELAError read_error ("");
+
+	A.reset ();
+
+	num_current = _read_batch<Ring> (A, current);
+
+	while (num_current > 0) {
+#pragma omp parallel sections num_threads(2)
+		{
+#pragma omp section
+			try {
+				num_next = _read_batch<Ring> (A, next);
+			}
+			catch (const InvalidMatrixInput &) {
+				invalid_input = true;
+			}
+			catch (const LELAError &e) {
+				read_error = e;
+				read_failed = true;
+			}
+
+#pragma omp section
+			for (size_t k = 0; k < num_current && !invalid_input && !read_failed; ++k)
+				op (start + k, current[k]);
+		}
+
+		if (invalid_input)
+			throw InvalidMatrixInput ();
+
+		if (read_failed)
+			throw read_error;
+
+		start += num_current;
+		current.swap (next);
+		num_current = num_next;
+	}
+}
+
+template <class Ring, class Modules, class Vector1, class Vector2>
+class _gemv_stream_op
+{
+	Context<Ring, Modules> &_ctx;
+	const typename Ring::Element &_a, &_b;
+	const Vector1 &_x;
+	Vector2 &_y;
+
+    public:
+	_gemv_stream_op (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Vector1 &x, const typename Ring::Element &b, Vector2 &y)
+		: _ctx (ctx), _a (a), _b (b), _x (x), _y (y) {}
+
+	template <class Row>
+	void operator () (size_t i, const Row &row)
+	{
+		typename Ring::Element t, yi;
+
+		_ctx.F.copy (t, _ctx.F.zero ());
+		_ctx.F.copy (yi, _ctx.F.zero ());
+
+		BLAS1::dot (_ctx, t, row, _x);
+		_ctx.F.mulin (t, _a);
+		VectorUtils::getEntry (_y, yi, i);
+		_ctx.F.axpyin (t, _b, yi);
+		_y[i] = t;
+	}
+};
+
+template <class Ring, class Modules, class Vector1, class Vector2>
+class _gemv_stream_transposed_op
+{
+	Context<Ring, Modules> &_ctx;
+	const typename Ring::Element &_a;
+	const Vector1 &_x;
+	Vector2 &_y;
+
+    public:
+	_gemv_stream_transposed_op (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Vector1 &x, Vector2 &y)
+		: _ctx (ctx), _a (a), _x (x), _y (y) {}
+
+	template <class Row>
+	void operator () (size_t i, const Row &row)
+	{
+		typename Ring::Element xi, t;
+
+		_ctx.F.copy (xi, _ctx.F.zero ());
+		_ctx.F.copy (t, _ctx.F.zero ());
+
+		if (VectorUtils::getEntry (_x, xi, i) && !_ctx.F.isZero (xi)) {
+			_ctx.F.mul (t, _a, xi);
+			BLAS1::axpy (_ctx, t, row, _y);
+		}
+	}
+};
+
+/** General matrix-vector multiply, y <- a Ax + by, where the rows of
+ * A are read from a stream
+ *
+ * The stream is reset and then read to its end, so it must be
+ * finite. Each row is read once and discarded after use. When
+ * compiled with OpenMP, the next batch of rows is read in a second
+ * thread while the current one is processed, so the cost is dominated
+ * by that of reading the stream when it is backed by a file (see @ref
+ * DumasFileStream). Otherwise batches are read and processed in turn.
+ *
+ * @param a Ring::Element scalar a
+ * @param A Stream of the rows of A
+ * @param x Vector x
+ * @param b Ring::Element scalar b
+ * @param y Vector y, to be replaced by result of calculation. Must
+ * be dense and have dimension A.size ()
+ * @returns Reference to y
+ */
+template <class Ring, class Modules, class Row, class Vector1, class Vector2>
+Vector2 &gemv_stream (Context<Ring, Modules>       &ctx,
+		      const typename Ring::Element &a,
+		      VectorStream<Row>            &A,
+		      const Vector1                &x,
+		      const typename Ring::Element &b,
+		      Vector2                      &y)
+{
+	lela_check (VectorUtils::hasDim<Ring> (x, A.dim ()));
+	lela_check (VectorUtils::hasDim<Ring> (y, A.size ()));
+
+	_gemv_stream_op<Ring, Modules, Vector1, Vector2> op (ctx, a, x, b, y);
+	_for_each_row<Ring> (A, op);
+
+	return y;
+}
+
+/** Transposed matrix-vector multiply, y <- a A^T x + by, where the
+ * rows of A are read from a stream
+ *
+ * As @ref gemv_stream, but y may have any representation supported
+ * by BLAS1::axpy with the rows of A.
+ *
+ * @param a Ring::Element scalar a
+ * @param A Stream of the rows of A
+ * @param x Vector x, of dimension A.size ()
+ * @param b Ring::Element scalar b
+ * @param y Vector y, of dimension A.dim (), to be replaced by result
+ * of calculation
+ * @returns Reference to y
+ */
+template <class Ring, class Modules, class Row, class Vector1, class Vector2>
+Vector2 &gemv_stream_transposed (Context<Ring, Modules>       &ctx,
+				 const typename Ring::Element &a,
+				 VectorStream<Row>            &A,
+				 const Vector1                &x,
+				 const typename Ring::Element &b,
+				 Vector2                      &y)
+{
+	lela_check (VectorUtils::hasDim<Ring> (x, A.size ()));
+	lela_check (VectorUtils::hasDim<Ring> (y, A.dim ()));
+
+	BLAS1::scal (ctx, b, y);
+
+	_gemv_stream_transposed_op<Ring, Modules, Vector1, Vector2> op (ctx, a, x, y);
+	_for_each_row<Ring> (A, op);
+
+	return y;
+}
+
+} // namespace BLAS2
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL2_STREAM_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -56,8 +56,18 @@ Vector2 &gemv (Context<Ring, Modules>       &ctx,
  *
  * A must be square.
  *
- * x must have a dense or dense 0-1 representation. This function is
- * not available for sparse or hybrid vectors.
+ * x may have a dense, dense 0-1, or sparse representation. This
+ * function is not available for sparse 0-1 or hybrid vectors.
+ *
+ * If x is sparse and A provides sparse columns (e.g. a
+ * TransposeMatrix of a SparseMatrix), the Gilbert-Peierls algorithm
+ * is used: a depth-first search over the graph of A first determines
+ * which entries of the result may be nonzero, so that only the
+ * corresponding columns of A are visited. Apart from clearing a
+ * workspace of the dimension of A, which is allocated for each call,
+ * the time taken is proportional to the number of
+ * arithmetic-operations. For other matrices, the solve is done on a
+ * dense copy of x.
  *
  * @param A Matrix A
  * @param x Vector x
@@ -0,0 +1,264 @@
+/* lela/blas/level3-async.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Asynchronous BLAS Level 3 interface
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_ASYNC_H
+#define __BLAS_LEVEL3_ASYNC_H
+
+#include "lela/blas/context.h"
+#include "lela/blas/level3.h"
+#include "lela/util/executor.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+/** Asynchronous versions of the level 3 BLAS
+ *
+ * Each routine takes the same arguments as the corresponding routine
+ * in BLAS3, with the @ref Executor on which to queue the operation
+ * after the context and an optional @ref Future after which it is to
+ * run at the end, and returns a Future for its result. The operation
+ * runs when a Future of that executor is waited on; independent
+ * operations may then run in parallel (see @ref Executor). copy,
+ * scal, and axpy are submitted as serial operations, while gemm,
+ * trmm, and trsm keep their share of the threads.
+ *
+ * Each operation runs with its own copy of the context, taken when it
+ * is submitted, so that operations in parallel do not share
+ * workspace. Scalars are copied; matrices are taken by reference and
+ * must remain valid and otherwise untouched until the operation has
+ * completed. Operations which write to the same matrix, or where one
+ * reads a matrix which the other writes, must be ordered by passing
+ * the Future of the first to the second.
+ *
+ * \ingroup blas
+ */
+namespace async
+{
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+class _copy
+{
+	Context<Ring, Modules> _ctx;
+	const Matrix1 &_A;
+	Matrix2 &_B;
+
+public:
+	_copy (const Context<Ring, Modules> &ctx, const Matrix1 &A, Matrix2 &B)
+		: _ctx (ctx), _A (A), _B (B) {}
+
+	void operator () ()
+		{ BLAS3::copy (_ctx, _A, _B); }
+};
+
+template <class Ring, class Modules, class Matrix>
+class _scal
+{
+	Context<Ring, Modules> _ctx;
+	typename Ring::Element _a;
+	Matrix &_A;
+
+public:
+	_scal (const Context<Ring, Modules> &ctx, const typename Ring::Element &a, Matrix &A)
+		: _ctx (ctx), _a (a), _A (A) {}
+
+	void operator () ()
+		{ BLAS3::scal (_ctx, _a, _A); }
+};
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+class _axpy
+{
+	Context<Ring, Modules> _ctx;
+	typename Ring::Element _a;
+	const Matrix1 &_A;
+	Matrix2 &_B;
+
+public:
+	_axpy (const Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B)
+		: _ctx (ctx), _a (a), _A (A), _B (B) {}
+
+	void operator () ()
+		{ BLAS3::axpy (_ctx, _a, _A, _B); }
+};
+
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+class _gemm
+{
+	Context<Ring, Modules> _ctx;
+	typename Ring::Element _a, _b;
+	const Matrix1 &_A;
+	const Matrix2 &_B;
+	Matrix3 &_C;
+
+public:
+	_gemm (const Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B,
+	       const typename Ring::Element &b, Matrix3 &C)
+		: _ctx (ctx), _a (a), _b (b), _A (A), _B (B), _C (C) {}
+
+	void operator () ()
+		{ BLAS3::gemm (_ctx, _a, _A, _B, _b, _C); }
+};
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+class _trmm
+{
+	Context<Ring, Modules> _ctx;
+	typename Ring::Element _a;
+	const Matrix1 &_A;
+	Matrix2 &_B;
+	TriangularMatrixType _type;
+	bool _diagIsOne;
+
+public:
+	_trmm (const Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B,
+	       TriangularMatrixType type, bool diagIsOne)
+		: _ctx (ctx), _a (a), _A (A), _B (B), _type (type), _diagIsOne (diagIsOne) {}
+
+	void operator () ()
+		{ BLAS3::trmm (_ctx, _a, _A, _B, _type, _diagIsOne); }
+};
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+class _trsm
+{
+	Context<Ring, Modules> _ctx;
+	typename Ring::Element _a;
+	const Matrix1 &_A;
+	Matrix2 &_B;
+	TriangularMatrixType _type;
+	bool _diagIsOne;
+
+public:
+	_trsm (const Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B,
+	       TriangularMatrixType type, bool diagIsOne)
+		: _ctx (ctx), _a (a), _A (A), _B (B), _type (type), _diagIsOne (diagIsOne) {}
+
+	void operator () ()
+		{ BLAS3::trsm (_ctx, _a, _A, _B, _type, _diagIsOne); }
+};
+
+/** Copy A into B asynchronously
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param A Origin matrix
+ * @param B Destination matrix
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+Future copy (Context<Ring, Modules> &ctx, Executor &executor, const Matrix1 &A, Matrix2 &B, const Future &after = Future ())
+	{ return executor.submit ("copy", AsyncTask::SERIAL, _copy<Ring, Modules, Matrix1, Matrix2> (ctx, A, B), after); }
+
+/** A <- a * A asynchronously
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param a Scalar
+ * @param A Matrix
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix>
+Future scal (Context<Ring, Modules> &ctx, Executor &executor, const typename Ring::Element &a, Matrix &A, const Future &after = Future ())
+	{ return executor.submit ("scal", AsyncTask::SERIAL, _scal<Ring, Modules, Matrix> (ctx, a, A), after); }
+
+/** B <- a * A + B asynchronously
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param a Scalar
+ * @param A Input matrix
+ * @param B Output matrix
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+Future axpy (Context<Ring, Modules> &ctx, Executor &executor, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, const Future &after = Future ())
+	{ return executor.submit ("axpy", AsyncTask::SERIAL, _axpy<Ring, Modules, Matrix1, Matrix2> (ctx, a, A, B), after); }
+
+/** C <- a * A * B + b * C asynchronously
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param a Scalar a
+ * @param A Matrix A
+ * @param B Matrix B
+ * @param b Scalar b
+ * @param C Matrix C, which must not be A or B
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2, class Matrix3>
+Future gemm (Context<Ring, Modules> &ctx, Executor &executor, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B,
+	     const typename Ring::Element &b, Matrix3 &C, const Future &after = Future ())
+	{ return executor.submit ("gemm", AsyncTask::PARALLEL, _gemm<Ring, Modules, Matrix1, Matrix2, Matrix3> (ctx, a, A, B, b, C), after); }
+
+/** B <- a * A * B asynchronously, where A is triangular
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param a Scalar a
+ * @param A Triangular matrix A
+ * @param B Matrix B
+ * @param type Whether A is upper or lower triangular
+ * @param diagIsOne Whether the diagonal of A is assumed to be all ones
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+Future trmm (Context<Ring, Modules> &ctx, Executor &executor, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B,
+	     TriangularMatrixType type, bool diagIsOne, const Future &after = Future ())
+	{ return executor.submit ("trmm", AsyncTask::PARALLEL, _trmm<Ring, Modules, Matrix1, Matrix2> (ctx, a, A, B, type, diagIsOne), after); }
+
+/** B <- a * A^-1 * B asynchronously, where A is triangular
+ *
+ * @param ctx @ref Context object for calculation
+ * @param executor @ref Executor on which to queue the operation
+ * @param a Scalar a
+ * @param A Triangular matrix A
+ * @param B Matrix B
+ * @param type Whether A is upper or lower triangular
+ * @param diagIsOne Whether the diagonal of A is assumed to be all ones
+ * @param after Operation after which to run, if any
+ * @returns Future for the operation
+ */
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+Future trsm (Context<Ring, Modules> &ctx, Executor &executor, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B,
+	     TriangularMatrixType type, bool diagIsOne, const Future &after = Future ())
+	{ return executor.submit ("trsm", AsyncTask::PARALLEL, _trsm<Ring, Modules, Matrix1, Matrix2> (ctx, a, A, B, type, diagIsOne), after); }
+
+} // namespace async
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_ASYNC_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
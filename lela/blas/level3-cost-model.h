@@ -0,0 +1,310 @@
+/* lela/blas/level3-cost-model.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Module which chooses the algorithm for each matrix-multiplication
+ * by means of a cost-model
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_COST_MODEL_H
+#define __BLAS_LEVEL3_COST_MODEL_H
+
+#include <algorithm>
+
+#include "lela/util/atomic.h"
+#include "lela/blas/context.h"
+#include "lela/blas/level3-ll.h"
+#include "lela/vector/traits.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/dense.h"
+
+namespace LELA
+{
+
+/** Algorithms among which CostModelModule chooses
+ *
+ * \ingroup blas
+ */
+enum GemmAlgorithm {
+	GEMM_CLASSICAL,   ///< Classical multiplication by the parent of the fast module
+	GEMM_FAST,        ///< The fast module, e.g. Strassen-Winograd or M4RI
+	GEMM_SPARSE,      ///< Some operand is not dense and the classical (sparse) kernels are used
+	GEMM_DENSE_COPY,  ///< Some input is not dense and is copied into a dense matrix first
+	GEMM_ALGORITHMS
+};
+
+/** Cost-model for matrix-multiplication
+ *
+ * Estimates the time needed by the classical and the fast algorithm
+ * to compute an m x k by k x n product. The classical algorithm is
+ * charged a fixed time per multiply-add. The fast algorithm is
+ * charged a (possibly different) time per multiply-add, reduced by the
+ * factor recursion for each level of recursion, plus a fixed time per
+ * entry of the three operands for conversions and temporaries. As in
+ * StrassenWinograd, which recurses as long as all dimensions are at
+ * least its cutoff, the number of levels of recursion is the number
+ * of times the smallest dimension is at least cutoff when it is
+ * halved repeatedly.
+ *
+ * A product with a sparse input may either be done by the classical
+ * sparse kernels, which are charged a time per multiply-add actually
+ * done, i.e. scaled by the densities of the inputs, or by copying the
+ * sparse inputs into dense matrices and proceeding as for a dense
+ * product, which is charged the time of the copy in addition.
+ *
+ * The default constants are in units of one classical multiply-add
+ * and describe Strassen-Winograd with its default cutoff and the
+ * sparse kernels of ZpModule, as measured for Modular<uint32> and
+ * Modular<uint16>. They may be replaced by measured values with
+ * CostModelModule::calibrate.
+ *
+ * \ingroup blas
+ */
+struct GemmCostModel
+{
+	/// Time per multiply-add of the classical algorithm
+	double classical;
+
+	/// Time per multiply-add of the fast algorithm before recursion
+	double fast;
+
+	/// Factor by which one level of recursion reduces the work of the fast algorithm
+	double recursion;
+
+	/// Smallest dimension at which the fast algorithm recurses
+	size_t cutoff;
+
+	/// Time per entry of the operands spent by the fast algorithm
+	/// on conversions and temporaries
+	double overhead;
+
+	/// Time per multiply-add of the classical algorithm with a sparse input
+	double sparse;
+
+	/// Time per entry to copy a sparse input into a dense matrix
+	double copy;
+
+	GemmCostModel ()
+		: classical (1.0), fast (1.0), recursion (0.875), cutoff (2048), overhead (1.0), sparse (0.5), copy (0.15) {}
+
+	/// Estimated time of the classical algorithm
+	double classicalCost (size_t m, size_t k, size_t n) const
+		{ return classical * (double) m * (double) k * (double) n; }
+
+	/// Estimated time of the fast algorithm
+	double fastCost (size_t m, size_t k, size_t n) const
+	{
+		size_t d = std::min (m, std::min (k, n));
+		double work = fast * (double) m * (double) k * (double) n;
+
+		for (; d >= cutoff && cutoff > 0; d /= 2)
+			work *= recursion;
+
+		return work + overhead * ((double) m * (double) k + (double) k * (double) n + (double) m * (double) n);
+	}
+
+	/// Estimated time of the classical algorithm where the inputs
+	/// have the given proportions of nonzero entries
+	double sparseCost (size_t m, size_t k, size_t n, double density_A, double density_B) const
+		{ return sparse * density_A * density_B * (double) m * (double) k * (double) n; }
+
+	/// Estimated time to copy the sparse inputs into dense matrices
+	double copyCost (size_t m, size_t k, size_t n, bool copy_A, bool copy_B) const
+		{ return copy * ((copy_A ? (double) m * (double) k : 0.0) + (copy_B ? (double) k * (double) n : 0.0)); }
+};
+
+template <class Ring, class FastModule>
+struct CostModelModuleTag { typedef typename FastModule::Tag Parent; };
+
+/** Module which chooses the algorithm for each matrix-multiplication
+ *
+ * The module wraps a module implementing a fast algorithm for gemm,
+ * such as StrassenModule<Modular<Element>, ZpModule<Element> > or
+ * M4RIModule. Whatever the parent of that module does is taken to be
+ * the classical algorithm. On each call to gemm, the module estimates
+ * the costs of both with a GemmCostModel from the dimensions of the
+ * operands and calls the cheaper one. If an input is not dense, the
+ * module counts its nonzero entries and estimates whether the sparse
+ * kernels or a dense product of copies of the inputs is cheaper. If
+ * the output is not dense, the call goes directly to the classical
+ * (sparse) kernels. All other operations are passed on to the fast
+ * module unchanged.
+ *
+ * Each decision is counted, and if log_decisions is set, reported
+ * with the estimated costs to the commentator, so that the choices
+ * can be audited.
+ *
+ * \ingroup blas
+ */
+template <class Ring, class FastModule>
+struct CostModelModule : public FastModule
+{
+	typedef CostModelModuleTag<Ring, FastModule> Tag;
+
+	/// Constants used for the decision
+	GemmCostModel gemm_cost;
+
+	/// Whether to report each decision to the commentator
+	bool log_decisions;
+
+	/// Number of calls to gemm for which each GemmAlgorithm was
+	/// chosen. The counts are updated atomically, since products in
+	/// parallel regions share the module.
+	mutable size_t decisions[GEMM_ALGORITHMS];
+
+	CostModelModule (const Ring &R) : FastModule (R), log_decisions (false)
+		{ clearDecisions (); }
+
+	/// Reset the counts of decisions
+	void clearDecisions () const
+		{ for (int alg = 0; alg < GEMM_ALGORITHMS; ++alg) Atomic::store (decisions[alg], (size_t) 0); }
+
+	/// Choose the algorithm for a dense m x k by k x n product and
+	/// record the decision
+	GemmAlgorithm chooseGemm (size_t m, size_t k, size_t n) const;
+
+	/// Choose between the sparse kernels (GEMM_SPARSE) and a dense
+	/// copy (GEMM_DENSE_COPY) for an m x k by k x n product of
+	/// inputs with the given proportions of nonzero entries, of
+	/// which those indicated by copy_A and copy_B are not dense,
+	/// and record the decision
+	GemmAlgorithm chooseSparseGemm (size_t m, size_t k, size_t n, double density_A, double density_B, bool copy_A, bool copy_B) const;
+
+	/// Record that a product with a non-dense output was passed
+	/// to the classical kernels
+	void recordSparseGemm (size_t m, size_t k, size_t n) const;
+
+	/** Measure the constants of the cost-model
+	 *
+	 * Times the classical and the fast algorithm on random dense
+	 * n x n matrices, and the classical algorithm and a copy on a
+	 * sparse matrix with the same entries, and sets
+	 * gemm_cost.classical, gemm_cost.fast, gemm_cost.sparse and
+	 * gemm_cost.copy accordingly. The overhead is scaled so that
+	 * its ratio to the classical time per multiply-add is
+	 * unchanged. n should be large enough that the timings are
+	 * meaningful but need not exceed the cutoff.
+	 */
+	void calibrate (const Ring &F, size_t n);
+};
+
+namespace BLAS3
+{
+
+template <class Ring, class FastModule>
+class _gemm<Ring, CostModelModuleTag<Ring, FastModule> >
+{
+	typedef typename FastModule::Tag FastTag;
+	typedef typename FastModule::Tag::Parent ClassicalTag;
+
+	// Proportion of entries of A which are stored, i.e. of nonzero
+	// entries if A is sparse
+	template <class Matrix>
+	static double density (const Matrix &A, MatrixIteratorTypes::Row)
+	{
+		double nonzeros = 0.0;
+
+		for (typename Matrix::ConstRowIterator i = A.rowBegin (); i != A.rowEnd (); ++i)
+			nonzeros += i->size ();
+
+		return nonzeros / ((double) A.rowdim () * (double) A.coldim ());
+	}
+
+	template <class Matrix>
+	static double density (const Matrix &A, MatrixIteratorTypes::Col)
+	{
+		double nonzeros = 0.0;
+
+		for (typename Matrix::ConstColIterator i = A.colBegin (); i != A.colEnd (); ++i)
+			nonzeros += i->size ();
+
+		return nonzeros / ((double) A.rowdim () * (double) A.coldim ());
+	}
+
+	template <class Matrix>
+	static double density (const Matrix &A, MatrixIteratorTypes::RowCol)
+		{ return density (A, MatrixIteratorTypes::Row ()); }
+
+	template <class Matrix>
+	static double density (const Matrix &A)
+	{
+		if (DenseRepresentation<Ring>::isDense (A) || A.rowdim () == 0 || A.coldim () == 0)
+			return 1.0;
+		else
+			return std::min (density (A, typename Matrix::IteratorType ()), 1.0);
+	}
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_dense (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		const CostModelModule<Ring, FastModule> &CM = static_cast<const CostModelModule<Ring, FastModule> &> (M);
+
+		if (CM.chooseGemm (A.rowdim (), A.coldim (), B.coldim ()) == GEMM_FAST)
+			return _gemm<Ring, FastTag>::op (F, M, a, A, B, b, C);
+		else
+			return _gemm<Ring, ClassicalTag>::op (F, M, a, A, B, b, C);
+	}
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_copy_B (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		if (DenseRepresentation<Ring>::isDense (B))
+			return gemm_dense (F, M, a, A, B, b, C);
+
+		DenseMatrix<typename Ring::Element> B_dense (B.rowdim (), B.coldim ());
+		_copy<Ring, typename Modules::Tag>::op (F, M, B, B_dense);
+		return gemm_dense (F, M, a, A, B_dense, b, C);
+	}
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_copy (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		if (DenseRepresentation<Ring>::isDense (A))
+			return gemm_copy_B (F, M, a, A, B, b, C);
+
+		DenseMatrix<typename Ring::Element> A_dense (A.rowdim (), A.coldim ());
+		_copy<Ring, typename Modules::Tag>::op (F, M, A, A_dense);
+		return gemm_copy_B (F, M, a, A_dense, B, b, C);
+	}
+
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		const CostModelModule<Ring, FastModule> &CM = static_cast<const CostModelModule<Ring, FastModule> &> (M);
+
+		if (!DenseRepresentation<Ring>::isDense (C)) {
+			CM.recordSparseGemm (A.rowdim (), A.coldim (), B.coldim ());
+			return _gemm<Ring, ClassicalTag>::op (F, M, a, A, B, b, C);
+		}
+		else if (DenseRepresentation<Ring>::isDense (A) && DenseRepresentation<Ring>::isDense (B))
+			return gemm_dense (F, M, a, A, B, b, C);
+		else if (CM.chooseSparseGemm (A.rowdim (), A.coldim (), B.coldim (), density (A), density (B),
+					      !DenseRepresentation<Ring>::isDense (A), !DenseRepresentation<Ring>::isDense (B)) == GEMM_DENSE_COPY)
+			return gemm_copy (F, M, a, A, B, b, C);
+		else
+			return _gemm<Ring, ClassicalTag>::op (F, M, a, A, B, b, C);
+	}
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#include "lela/blas/level3-cost-model.tcc"
+
+#endif // __BLAS_LEVEL3_COST_MODEL_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,166 @@
+/* lela/blas/level3-cost-model.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Module which chooses the algorithm for each matrix-multiplication
+ * by means of a cost-model
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_COST_MODEL_TCC
+#define __BLAS_LEVEL3_COST_MODEL_TCC
+
+#include "lela/blas/level3-cost-model.h"
+#include "lela/util/commentator.h"
+#include "lela/util/timer.h"
+#include "lela/matrix/dense.h"
+#include "lela/matrix/sparse.h"
+#include "lela/vector/stream.h"
+
+namespace LELA
+{
+
+template <class Ring, class FastModule>
+GemmAlgorithm CostModelModule<Ring, FastModule>::chooseGemm (size_t m, size_t k, size_t n) const
+{
+	double classical = gemm_cost.classicalCost (m, k, n), fast = gemm_cost.fastCost (m, k, n);
+	GemmAlgorithm alg = (fast < classical) ? GEMM_FAST : GEMM_CLASSICAL;
+
+	Atomic::fetchAdd (decisions[alg], (size_t) 1);
+
+	if (log_decisions)
+		commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION)
+			<< "gemm " << m << "x" << k << " by " << k << "x" << n << ": estimated cost classical " << classical
+			<< ", fast " << fast << "; using " << ((alg == GEMM_FAST) ? "fast" : "classical") << " algorithm" << std::endl;
+
+	return alg;
+}
+
+template <class Ring, class FastModule>
+GemmAlgorithm CostModelModule<Ring, FastModule>::chooseSparseGemm (size_t m, size_t k, size_t n, double density_A, double density_B, bool copy_A, bool copy_B) const
+{
+	double sparse = gemm_cost.sparseCost (m, k, n, density_A, density_B);
+	double dense = gemm_cost.copyCost (m, k, n, copy_A, copy_B)
+		+ std::min (gemm_cost.classicalCost (m, k, n), gemm_cost.fastCost (m, k, n));
+	GemmAlgorithm alg = (dense < sparse) ? GEMM_DENSE_COPY : GEMM_SPARSE;
+
+	Atomic::fetchAdd (decisions[alg], (size_t) 1);
+
+	if (log_decisions)
+		commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION)
+			<< "gemm " << m << "x" << k << " by " << k << "x" << n << " with densities " << density_A << ", " << density_B
+			<< ": estimated cost sparse " << sparse << ", dense copy " << dense << "; using "
+			<< ((alg == GEMM_DENSE_COPY) ? "dense copy" : "sparse kernels") << std::endl;
+
+	return alg;
+}
+
+template <class Ring, class FastModule>
+void CostModelModule<Ring, FastModule>::recordSparseGemm (size_t m, size_t k, size_t n) const
+{
+	Atomic::fetchAdd (decisions[GEMM_SPARSE], (size_t) 1);
+
+	if (log_decisions)
+		commentator.report (Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION)
+			<< "gemm " << m << "x" << k << " by " << k << "x" << n << ": output not dense; using classical algorithm" << std::endl;
+}
+
+template <class Ring, class FastModule>
+void CostModelModule<Ring, FastModule>::calibrate (const Ring &F, size_t n)
+{
+	lela_check (n > 0);
+
+	typedef DenseMatrix<typename Ring::Element> Matrix;
+	typedef SparseMatrix<typename Ring::Element> Sparse;
+
+	// Repeat each product until the total time is measurable
+	static const double min_time = 0.1;
+
+	RandomDenseStream<Ring, typename Matrix::Row> A_stream (F, n, n), B_stream (F, n, n);
+	Matrix A (A_stream), B (B_stream), C (n, n);
+	Sparse A_sparse (n, n);
+
+	BLAS3::_copy<Ring, typename FastModule::Tag>::op (F, *this, A, A_sparse);
+
+	double nonzeros = 0.0;
+
+	for (typename Sparse::ConstRowIterator i = A_sparse.rowBegin (); i != A_sparse.rowEnd (); ++i)
+		nonzeros += i->size ();
+
+	UserTimer timer;
+	size_t reps;
+	double t_classical, t_fast, t_sparse, t_copy;
+
+	for (reps = 0, t_classical = 0.0; t_classical < min_time; ++reps) {
+		timer.start ();
+		BLAS3::_gemm<Ring, typename FastModule::Tag::Parent>::op (F, *this, F.one (), A, B, F.zero (), C);
+		timer.stop ();
+		t_classical += timer.time ();
+	}
+
+	t_classical /= reps;
+
+	for (reps = 0, t_fast = 0.0; t_fast < min_time; ++reps) {
+		timer.start ();
+		BLAS3::_gemm<Ring, typename FastModule::Tag>::op (F, *this, F.one (), A, B, F.zero (), C);
+		timer.stop ();
+		t_fast += timer.time ();
+	}
+
+	t_fast /= reps;
+
+	for (reps = 0, t_sparse = 0.0; t_sparse < min_time; ++reps) {
+		timer.start ();
+		BLAS3::_gemm<Ring, typename FastModule::Tag::Parent>::op (F, *this, F.one (), A_sparse, B, F.zero (), C);
+		timer.stop ();
+		t_sparse += timer.time ();
+	}
+
+	t_sparse /= reps;
+
+	for (reps = 0, t_copy = 0.0; t_copy < min_time; ++reps) {
+		timer.start ();
+		BLAS3::_copy<Ring, typename FastModule::Tag>::op (F, *this, A_sparse, C);
+		timer.stop ();
+		t_copy += timer.time ();
+	}
+
+	t_copy /= reps;
+
+	double mkn = (double) n * (double) n * (double) n;
+	double ratio = gemm_cost.overhead / gemm_cost.classical;
+
+	gemm_cost.classical = t_classical / mkn;
+	gemm_cost.sparse = (nonzeros > 0.0) ? t_sparse / (nonzeros * (double) n) : gemm_cost.classical;
+	gemm_cost.copy = t_copy / ((double) n * (double) n);
+	gemm_cost.overhead = ratio * gemm_cost.classical;
+
+	// Take out the overhead and the gain from recursion, so that
+	// what remains is the time per multiply-add at the base
+	double base = std::max (t_fast - gemm_cost.overhead * 3.0 * (double) n * (double) n, 0.0);
+	double gain = gemm_cost.fastCost (n, n, n) - gemm_cost.overhead * 3.0 * (double) n * (double) n;
+
+	gemm_cost.fast = (gain > 0.0) ? base / gain * gemm_cost.fast : gemm_cost.classical;
+
+	commentator.report (Commentator::LEVEL_NORMAL, INTERNAL_DESCRIPTION)
+		<< "Calibrated gemm cost-model at n = " << n << ": classical " << gemm_cost.classical
+		<< "s, fast " << gemm_cost.fast << "s, sparse " << gemm_cost.sparse << "s per multiply-add; copy "
+		<< gemm_cost.copy << "s per entry" << std::endl;
+}
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_COST_MODEL_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,99 @@
+/* lela/blas/level3-counting.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Level 3 BLAS over CountingRing, passed to the modules of the
+ * underlying ring
+ * ------------------------------------
+ * 
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_COUNTING_H
+#define __BLAS_LEVEL3_COUNTING_H
+
+#include "lela/blas/context.h"
+#include "lela/ring/counting.h"
+#include "lela/blas/level3-ll.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+template <class Ring>
+class _gemm<CountingRing<Ring>, CountingModuleTag<Ring> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &op (const CountingRing<Ring> &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		if (!CountingModule<Ring>::isDenseMatrix (A) || !CountingModule<Ring>::isDenseMatrix (B) || !CountingModule<Ring>::isDenseMatrix (C))
+			return _gemm<CountingRing<Ring>, typename CountingModuleTag<Ring>::Parent>::op (F, M, a, A, B, b, C);
+
+		OperationCounts c;
+		c.muls = c.adds = (unsigned long long) A.rowdim () * A.coldim () * B.coldim ();
+		F.countOperations (c);
+
+		return _gemm<Ring, typename AllModules<Ring>::Tag>::op (F.ring (), M.forward (), a, A, B, b, C);
+	}
+};
+
+template <class Ring>
+class _trmm<CountingRing<Ring>, CountingModuleTag<Ring> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const CountingRing<Ring> &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+	{
+		if (!CountingModule<Ring>::isDenseMatrix (A) || !CountingModule<Ring>::isDenseMatrix (B))
+			return _trmm<CountingRing<Ring>, typename CountingModuleTag<Ring>::Parent>::op (F, M, a, A, B, type, diagIsOne);
+
+		unsigned long long m = A.rowdim (), n = B.coldim ();
+		OperationCounts c;
+		c.adds = m * (m - 1) / 2 * n;
+		c.muls = c.adds + (diagIsOne ? 0 : m * n);
+		F.countOperations (c);
+
+		return _trmm<Ring, typename AllModules<Ring>::Tag>::op (F.ring (), M.forward (), a, A, B, type, diagIsOne);
+	}
+};
+
+template <class Ring>
+class _trsm<CountingRing<Ring>, CountingModuleTag<Ring> >
+{
+public:
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &op (const CountingRing<Ring> &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+	{
+		if (!CountingModule<Ring>::isDenseMatrix (A) || !CountingModule<Ring>::isDenseMatrix (B))
+			return _trsm<CountingRing<Ring>, typename CountingModuleTag<Ring>::Parent>::op (F, M, a, A, B, type, diagIsOne);
+
+		unsigned long long m = A.rowdim (), n = B.coldim ();
+		OperationCounts c;
+		c.adds = m * (m - 1) / 2 * n;
+		c.muls = c.adds + (diagIsOne ? 0 : m * n);
+		c.invs = diagIsOne ? 0 : m;
+		F.countOperations (c);
+
+		return _trsm<Ring, typename AllModules<Ring>::Tag>::op (F.ring (), M.forward (), a, A, B, type, diagIsOne);
+	}
+};
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_COUNTING_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,521 @@
+/* lela/blas/level3-expr.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Lazy matrix-expressions for the BLAS Level 3
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_EXPR_H
+#define __BLAS_LEVEL3_EXPR_H
+
+#include <vector>
+#include <algorithm>
+
+#include "lela/blas/context.h"
+#include "lela/matrix/traits.h"
+#include "lela/matrix/dense.h"
+#include "lela/blas/level1.h"
+#include "lela/blas/level3.h"
+#include "lela/util/debug.h"
+
+namespace LELA
+{
+
+namespace BLAS3
+{
+
+/** @name Lazy matrix-expressions
+ *
+ * A matrix wrapped with @ref lazy may be combined with others by +,
+ * - and * and with scalars into a small expression which is only
+ * evaluated by @ref assign. The expression is then mapped onto as few
+ * passes over memory as possible: a product is evaluated by gemm
+ * with the accumulation into the destination included, and scaling,
+ * addition, and permutation of rows are carried out row by row while
+ * each row is in the cache, instead of by a separate pass of scal,
+ * axpy, or permute_rows over the whole matrix. For example
+ *
+ *   BLAS3::assign (ctx, D, lazy (D) - lazy (C) * lazy (B));
+ *   BLAS3::assign (ctx, Y, a * lazy (X) + b * lazy (Y));
+ *   BLAS3::assign (ctx, B, permuted_rows (P.begin (), P.end (), lazy (A)));
+ *
+ * are one call to gemm, one pass over X and Y, and one pass copying
+ * A into B, respectively.
+ *
+ * An expression is a sum of at most two terms, each of which is a
+ * matrix, a product of two matrices, or a matrix with permuted rows,
+ * optionally negated or multiplied by one scalar. Other expressions
+ * do not compile.
+ *
+ * Expressions hold references to their matrices, so they should be
+ * passed directly to assign rather than stored. The destination may
+ * appear anywhere in the expression. Where it would be read after it
+ * has been overwritten, e.g. as a factor of a product, the affected
+ * term or the whole expression is first evaluated into a temporary
+ * dense matrix. Only the identity of the matrix-objects is checked,
+ * so no other matrix sharing storage with the destination, such as
+ * a submatrix of it, may appear in the expression.
+ *
+ * \ingroup blas
+ */
+//@{
+
+/// Any expression
+template <class Derived>
+struct Expression
+{
+	const Derived &derived () const
+		{ return static_cast<const Derived &> (*this); }
+};
+
+/// Expression which may be scaled: a matrix, product, or matrix with permuted rows
+template <class Derived>
+struct BaseExpression : public Expression<Derived> {};
+
+/// A matrix as an expression
+template <class Matrix>
+class MatrixExpression : public BaseExpression<MatrixExpression<Matrix> >
+{
+	const Matrix &_A;
+
+public:
+	typedef typename Matrix::Element Element;
+
+	MatrixExpression (const Matrix &A) : _A (A) {}
+
+	const Matrix &matrix () const { return _A; }
+};
+
+/// The product of two matrices as an expression
+template <class Matrix1, class Matrix2>
+class ProductExpression : public BaseExpression<ProductExpression<Matrix1, Matrix2> >
+{
+	const Matrix1 &_A;
+	const Matrix2 &_B;
+
+public:
+	typedef typename Matrix1::Element Element;
+
+	ProductExpression (const Matrix1 &A, const Matrix2 &B) : _A (A), _B (B) {}
+
+	const Matrix1 &left () const { return _A; }
+	const Matrix2 &right () const { return _B; }
+};
+
+/// A matrix with rows permuted as by permute_rows as an expression
+template <class Iterator, class Matrix>
+class RowPermutedExpression : public BaseExpression<RowPermutedExpression<Iterator, Matrix> >
+{
+	Iterator _P_begin, _P_end;
+	const Matrix &_A;
+
+public:
+	typedef typename Matrix::Element Element;
+
+	RowPermutedExpression (Iterator P_begin, Iterator P_end, const Matrix &A)
+		: _P_begin (P_begin), _P_end (P_end), _A (A) {}
+
+	Iterator P_begin () const { return _P_begin; }
+	Iterator P_end () const { return _P_end; }
+	const Matrix &matrix () const { return _A; }
+};
+
+/// A term of a sum: an expression multiplied by a scalar, possibly negated
+template <class Base>
+class ScaledExpression : public Expression<ScaledExpression<Base> >
+{
+public:
+	typedef typename Base::Element Element;
+
+	ScaledExpression (const Base &base)
+		: _base (base), _has_scalar (false), _negated (false) {}
+
+	ScaledExpression (const Base &base, const Element &a)
+		: _base (base), _a (a), _has_scalar (true), _negated (false) {}
+
+	ScaledExpression operator - () const
+		{ ScaledExpression e (*this); e._negated = !e._negated; return e; }
+
+	const Base &base () const { return _base; }
+
+	/// The scalar by which the base is multiplied
+	template <class Ring>
+	typename Ring::Element &scalar (const Ring &F, typename Ring::Element &c) const
+	{
+		F.copy (c, _has_scalar ? _a : F.one ());
+
+		if (_negated)
+			F.negin (c);
+
+		return c;
+	}
+
+private:
+	Base _base;
+	Element _a;
+	bool _has_scalar;
+	bool _negated;
+};
+
+/// The sum of two terms
+template <class Term1, class Term2>
+class SumExpression : public Expression<SumExpression<Term1, Term2> >
+{
+	Term1 _t1;
+	Term2 _t2;
+
+public:
+	SumExpression (const Term1 &t1, const Term2 &t2) : _t1 (t1), _t2 (t2) {}
+
+	const Term1 &first () const { return _t1; }
+	const Term2 &second () const { return _t2; }
+};
+
+/// Conversion of an operand of a sum to a term
+template <class X>
+struct AsTerm
+{
+	typedef ScaledExpression<X> Type;
+	static Type convert (const X &x) { return Type (x); }
+};
+
+template <class Base>
+struct AsTerm<ScaledExpression<Base> >
+{
+	typedef ScaledExpression<Base> Type;
+	static Type convert (const Type &x) { return x; }
+};
+
+/** Wrap a matrix so that it may be used in an expression
+ *
+ * @param A Matrix, which must outlive the expression
+ * @returns Expression
+ */
+template <class Matrix>
+MatrixExpression<Matrix> lazy (const Matrix &A)
+	{ return MatrixExpression<Matrix> (A); }
+
+/** The matrix of an expression with its rows permuted
+ *
+ * @param P_begin Beginning of permutation, as for permute_rows
+ * @param P_end End of permutation
+ * @param A Expression of the matrix
+ * @returns Expression
+ */
+template <class Iterator, class Matrix>
+RowPermutedExpression<Iterator, Matrix> permuted_rows (Iterator P_begin, Iterator P_end, const MatrixExpression<Matrix> &A)
+	{ return RowPermutedExpression<Iterator, Matrix> (P_begin, P_end, A.matrix ()); }
+
+template <class Matrix1, class Matrix2>
+ProductExpression<Matrix1, Matrix2> operator * (const MatrixExpression<Matrix1> &A, const MatrixExpression<Matrix2> &B)
+	{ return ProductExpression<Matrix1, Matrix2> (A.matrix (), B.matrix ()); }
+
+template <class Base>
+ScaledExpression<Base> operator * (const typename Base::Element &a, const BaseExpression<Base> &e)
+	{ return ScaledExpression<Base> (e.derived (), a); }
+
+template <class Base>
+ScaledExpression<Base> operator - (const BaseExpression<Base> &e)
+	{ return -ScaledExpression<Base> (e.derived ()); }
+
+template <class X, class Y>
+SumExpression<typename AsTerm<X>::Type, typename AsTerm<Y>::Type> operator + (const Expression<X> &x, const Expression<Y> &y)
+{
+	return SumExpression<typename AsTerm<X>::Type, typename AsTerm<Y>::Type>
+		(AsTerm<X>::convert (x.derived ()), AsTerm<Y>::convert (y.derived ()));
+}
+
+template <class X, class Y>
+SumExpression<typename AsTerm<X>::Type, typename AsTerm<Y>::Type> operator - (const Expression<X> &x, const Expression<Y> &y)
+{
+	return SumExpression<typename AsTerm<X>::Type, typename AsTerm<Y>::Type>
+		(AsTerm<X>::convert (x.derived ()), -AsTerm<Y>::convert (y.derived ()));
+}
+
+/// Row-indices of the matrix after applying the permutation: row i of P A is row source[i] of A
+template <class Iterator>
+void _permutation_sources (Iterator P_begin, Iterator P_end, size_t rowdim, std::vector<size_t> &source)
+{
+	source.resize (rowdim);
+
+	for (size_t i = 0; i < rowdim; ++i)
+		source[i] = i;
+
+	for (; P_begin != P_end; ++P_begin)
+		std::swap (source[P_begin->first], source[P_begin->second]);
+}
+
+/// Whether A and X are the same matrix
+template <class Matrix1, class Matrix2>
+bool _same_matrix (const Matrix1 &A, const Matrix2 &X)
+	{ return (const void *) &A == (const void *) &X; }
+
+/// Whether the base of a term is the matrix X by itself
+template <class Base, class Matrix>
+bool _is_matrix (const Base &, const Matrix &)
+	{ return false; }
+
+template <class Matrix1, class Matrix2>
+bool _is_matrix (const MatrixExpression<Matrix1> &e, const Matrix2 &X)
+	{ return _same_matrix (e.matrix (), X); }
+
+/// Whether the base of a term reads the matrix X, as the matrix itself or as an operand
+template <class Matrix1, class Matrix>
+bool _refers_to (const MatrixExpression<Matrix1> &e, const Matrix &X)
+	{ return _same_matrix (e.matrix (), X); }
+
+template <class Matrix1, class Matrix2, class Matrix>
+bool _refers_to (const ProductExpression<Matrix1, Matrix2> &e, const Matrix &X)
+	{ return _same_matrix (e.left (), X) || _same_matrix (e.right (), X); }
+
+template <class Iterator, class Matrix1, class Matrix>
+bool _refers_to (const RowPermutedExpression<Iterator, Matrix1> &e, const Matrix &X)
+	{ return _same_matrix (e.matrix (), X); }
+
+/// X <- a A, row by row
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+void _copy_scal (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &X,
+		 MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+{
+	typename Matrix1::ConstRowIterator i_A;
+	typename Matrix2::RowIterator i_X;
+
+	for (i_A = A.rowBegin (), i_X = X.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_X) {
+		BLAS1::copy (ctx, *i_A, *i_X);
+
+		if (!ctx.F.isOne (a))
+			BLAS1::scal (ctx, a, *i_X);
+	}
+}
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+void _copy_scal (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &X,
+		 MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic)
+{
+	BLAS3::copy (ctx, A, X);
+
+	if (!ctx.F.isOne (a))
+		BLAS3::scal (ctx, a, X);
+}
+
+/// X <- b X + a A, row by row
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+void _axpby (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, const typename Ring::Element &b, Matrix2 &X,
+	     MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+{
+	typename Matrix1::ConstRowIterator i_A;
+	typename Matrix2::RowIterator i_X;
+
+	for (i_A = A.rowBegin (), i_X = X.rowBegin (); i_A != A.rowEnd (); ++i_A, ++i_X) {
+		if (!ctx.F.isOne (b))
+			BLAS1::scal (ctx, b, *i_X);
+
+		BLAS1::axpy (ctx, a, *i_A, *i_X);
+	}
+}
+
+template <class Ring, class Modules, class Matrix1, class Matrix2>
+void _axpby (Context<Ring, Modules> &ctx, const typename Ring::Element &a, const Matrix1 &A, const typename Ring::Element &b, Matrix2 &X,
+	     MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic)
+{
+	if (!ctx.F.isOne (b))
+		BLAS3::scal (ctx, b, X);
+
+	BLAS3::axpy (ctx, a, A, X);
+}
+
+/// X <- b X + a P A, or X <- a P A if b is zero, row by row
+template <class Ring, class Modules, class Iterator, class Matrix1, class Matrix2>
+void _permuted_axpby (Context<Ring, Modules> &ctx, const typename Ring::Element &a, Iterator P_begin, Iterator P_end, const Matrix1 &A,
+		      const typename Ring::Element &b, Matrix2 &X,
+		      MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+{
+	std::vector<size_t> source;
+	typename Matrix2::RowIterator i_X;
+	size_t i;
+
+	_permutation_sources (P_begin, P_end, A.rowdim (), source);
+
+	for (i = 0, i_X = X.rowBegin (); i_X != X.rowEnd (); ++i, ++i_X) {
+		if (ctx.F.isZero (b)) {
+			BLAS1::copy (ctx, *(A.rowBegin () + source[i]), *i_X);
+
+			if (!ctx.F.isOne (a))
+				BLAS1::scal (ctx, a, *i_X);
+		} else {
+			if (!ctx.F.isOne (b))
+				BLAS1::scal (ctx, b, *i_X);
+
+			BLAS1::axpy (ctx, a, *(A.rowBegin () + source[i]), *i_X);
+		}
+	}
+}
+
+template <class Ring, class Modules, class Iterator, class Matrix1, class Matrix2>
+void _permuted_axpby (Context<Ring, Modules> &ctx, const typename Ring::Element &a, Iterator P_begin, Iterator P_end, const Matrix1 &A,
+		      const typename Ring::Element &b, Matrix2 &X,
+		      MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic)
+{
+	DenseMatrix<typename Ring::Element> T (A.rowdim (), A.coldim ());
+
+	BLAS3::copy (ctx, A, T);
+	BLAS3::permute_rows (ctx, P_begin, P_end, T);
+	_axpby (ctx, a, T, b, X, MatrixIteratorTypes::Generic (), MatrixIteratorTypes::Generic ());
+}
+
+/// X <- b X + t, for each kind of term t
+template <class Ring, class Modules, class Matrix, class Matrix1>
+void _accumulate (Context<Ring, Modules> &ctx, Matrix &X, const typename Ring::Element &b, const ScaledExpression<MatrixExpression<Matrix1> > &t)
+{
+	typename Ring::Element a;
+
+	t.scalar (ctx.F, a);
+
+	if (_refers_to (t.base (), X)) {
+		// X <- (a + b) X; scaling X row by row before adding it
+		// would add the scaled row
+		ctx.F.addin (a, b);
+		BLAS3::scal (ctx, a, X);
+	} else
+		_axpby (ctx, a, t.base ().matrix (), b, X, typename Matrix1::IteratorType (), typename Matrix::IteratorType ());
+}
+
+template <class Ring, class Modules, class Matrix, class Matrix1, class Matrix2>
+void _accumulate (Context<Ring, Modules> &ctx, Matrix &X, const typename Ring::Element &b, const ScaledExpression<ProductExpression<Matrix1, Matrix2> > &t)
+{
+	typename Ring::Element a;
+
+	t.scalar (ctx.F, a);
+
+	if (_refers_to (t.base (), X)) {
+		// gemm would overwrite its own input
+		DenseMatrix<typename Ring::Element> T (X.rowdim (), X.coldim ());
+
+		BLAS3::gemm (ctx, a, t.base ().left (), t.base ().right (), ctx.F.zero (), T);
+		_axpby (ctx, ctx.F.one (), T, b, X,
+			typename DenseMatrix<typename Ring::Element>::IteratorType (), typename Matrix::IteratorType ());
+	} else
+		BLAS3::gemm (ctx, a, t.base ().left (), t.base ().right (), b, X);
+}
+
+template <class Ring, class Modules, class Matrix, class Iterator, class Matrix1>
+void _accumulate (Context<Ring, Modules> &ctx, Matrix &X, const typename Ring::Element &b, const ScaledExpression<RowPermutedExpression<Iterator, Matrix1> > &t)
+{
+	typename Ring::Element a;
+
+	t.scalar (ctx.F, a);
+
+	if (_refers_to (t.base (), X)) {
+		// The rows of X would be read after they have been
+		// overwritten
+		DenseMatrix<typename Ring::Element> T (X.rowdim (), X.coldim ());
+
+		BLAS3::copy (ctx, X, T);
+		_permuted_axpby (ctx, a, t.base ().P_begin (), t.base ().P_end (), T, b, X,
+				 typename DenseMatrix<typename Ring::Element>::IteratorType (), typename Matrix::IteratorType ());
+	} else
+		_permuted_axpby (ctx, a, t.base ().P_begin (), t.base ().P_end (), t.base ().matrix (), b, X,
+				 typename Matrix1::IteratorType (), typename Matrix::IteratorType ());
+}
+
+/// X <- t, for each kind of expression t
+template <class Ring, class Modules, class Matrix, class Matrix1>
+void _assign (Context<Ring, Modules> &ctx, Matrix &X, const ScaledExpression<MatrixExpression<Matrix1> > &t)
+{
+	typename Ring::Element a;
+
+	t.scalar (ctx.F, a);
+
+	if (_is_matrix (t.base (), X))
+		BLAS3::scal (ctx, a, X);
+	else
+		_copy_scal (ctx, a, t.base ().matrix (), X, typename Matrix1::IteratorType (), typename Matrix::IteratorType ());
+}
+
+template <class Ring, class Modules, class Matrix, class Matrix1, class Matrix2>
+void _assign (Context<Ring, Modules> &ctx, Matrix &X, const ScaledExpression<ProductExpression<Matrix1, Matrix2> > &t)
+	{ _accumulate (ctx, X, ctx.F.zero (), t); }
+
+template <class Ring, class Modules, class Matrix, class Iterator, class Matrix1>
+void _assign (Context<Ring, Modules> &ctx, Matrix &X, const ScaledExpression<RowPermutedExpression<Iterator, Matrix1> > &t)
+{
+	typename Ring::Element a;
+
+	t.scalar (ctx.F, a);
+
+	if (_is_matrix (MatrixExpression<Matrix1> (t.base ().matrix ()), X)) {
+		BLAS3::permute_rows (ctx, t.base ().P_begin (), t.base ().P_end (), X);
+
+		if (!ctx.F.isOne (a))
+			BLAS3::scal (ctx, a, X);
+	} else
+		_accumulate (ctx, X, ctx.F.zero (), t);
+}
+
+template <class Ring, class Modules, class Matrix, class Base>
+void _assign (Context<Ring, Modules> &ctx, Matrix &X, const BaseExpression<Base> &e)
+	{ _assign (ctx, X, ScaledExpression<Base> (e.derived ())); }
+
+template <class Ring, class Modules, class Matrix, class Term1, class Term2>
+void _assign (Context<Ring, Modules> &ctx, Matrix &X, const SumExpression<Term1, Term2> &e)
+{
+	typename Ring::Element b;
+
+	// A term which reads X must be evaluated before X is
+	// overwritten by the other term
+	if (_is_matrix (e.second ().base (), X))
+		_accumulate (ctx, X, e.second ().scalar (ctx.F, b), e.first ());
+	else if (_is_matrix (e.first ().base (), X))
+		_accumulate (ctx, X, e.first ().scalar (ctx.F, b), e.second ());
+	else if (!_refers_to (e.first ().base (), X)) {
+		_assign (ctx, X, e.second ());
+		_accumulate (ctx, X, ctx.F.one (), e.first ());
+	}
+	else if (!_refers_to (e.second ().base (), X)) {
+		_assign (ctx, X, e.first ());
+		_accumulate (ctx, X, ctx.F.one (), e.second ());
+	}
+	else {
+		DenseMatrix<typename Ring::Element> T (X.rowdim (), X.coldim ());
+
+		_assign (ctx, T, e);
+		BLAS3::copy (ctx, T, X);
+	}
+}
+
+/** Evaluate an expression into a matrix
+ *
+ * @param ctx @ref Context object for calculation
+ * @param X Destination-matrix, which must have the dimensions of
+ * the expression
+ * @param e Expression, constructed from matrices wrapped by @ref lazy
+ * @returns Reference to X
+ */
+template <class Ring, class Modules, class Matrix, class Expr>
+Matrix &assign (Context<Ring, Modules> &ctx, Matrix &X, const Expression<Expr> &e)
+{
+	_assign (ctx, X, e.derived ());
+	return X;
+}
+
+//@} Lazy matrix-expressions
+
+} // namespace BLAS3
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_EXPR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
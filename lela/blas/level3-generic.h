@@ -17,6 +17,7 @@
 #include "lela/matrix/traits.h"
 #include "lela/matrix/io.h"
 #include "lela/blas/level3-ll.h"
+#include "lela/blas/level3-kernels.h"
 
 namespace LELA
 {
@@ -144,15 +145,75 @@ public:
 template <class Ring>
 class _gemm<Ring, typename GenericModule<Ring>::Tag>
 {
+	// Number of rows of C handled at once by one thread in the
+	// products with sparse operands
+	static const size_t scatter_rows_per_block = 64;
+
+	// y <- y + a * x^T B, where x is a row of A and y a row of C
+	template <class Modules, class Vector1, class Matrix, class Vector2>
+	static Vector2 &scatter_row (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Matrix &B, Vector2 &y,
+				     VectorRepresentationTypes::Dense);
+
+	template <class Modules, class Vector1, class Matrix, class Vector2>
+	static Vector2 &scatter_row (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Matrix &B, Vector2 &y,
+				     VectorRepresentationTypes::Sparse);
+
+	// y <- a * x^T B + b * y, accumulating directly in y if it is
+	// dense and in acc otherwise
+	template <class Modules, class Vector1, class Matrix, class Vector2>
+	static Vector2 &gemm_row (const Ring &F, Modules &M,
+				  const typename Ring::Element &a, const Vector1 &x, const Matrix &B, const typename Ring::Element &b, Vector2 &y,
+				  typename Vector<Ring>::Dense &acc, VectorRepresentationTypes::Dense);
+
+	template <class Modules, class Vector1, class Matrix, class Vector2>
+	static Vector2 &gemm_row (const Ring &F, Modules &M,
+				  const typename Ring::Element &a, const Vector1 &x, const Matrix &B, const typename Ring::Element &b, Vector2 &y,
+				  typename Vector<Ring>::Dense &acc, VectorRepresentationTypes::Generic);
+
+	// Row-iterated products, specialised on the representation of
+	// the rows of B
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_rows (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Generic);
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_rows (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Sparse);
+
+	// C_i <- C_i + a * x_i * y for the nonzero entries x_i of the
+	// sparse column x with start <= i < end
+	template <class Modules, class Vector1, class Vector2, class Iterator>
+	static void scatter_col (const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Vector2 &y,
+				 Iterator C_rows, size_t start, size_t end);
+
+	// Column-iterated products, specialised on the representation
+	// of the columns of A and on whether B and C have rows
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_cols (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Generic, MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic);
+
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_cols (const Ring &F, Modules &M,
+				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+				   VectorRepresentationTypes::Sparse, MatrixIteratorTypes::Row, MatrixIteratorTypes::Row);
+
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
 				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
-				   MatrixIteratorTypes::Row, MatrixIteratorTypes::Row, MatrixIteratorTypes::Row);
+				   MatrixIteratorTypes::Row, MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+		{ return gemm_rows (F, M, a, A, B, b, C, typename VectorTraits<Ring, typename Matrix2::Row>::RepresentationType ()); }
 
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
 				   const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
-				   MatrixIteratorTypes::Col, MatrixIteratorTypes::Col, MatrixIteratorTypes::Col);
+				   MatrixIteratorTypes::Col, MatrixIteratorTypes::Col, MatrixIteratorTypes::Col)
+		{ return gemm_cols (F, M, a, A, B, b, C,
+				    typename VectorTraits<Ring, typename Matrix1::Col>::RepresentationType (),
+				    typename Matrix2::IteratorType (),
+				    typename Matrix3::IteratorType ()); }
 
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M,
@@ -185,21 +246,36 @@ class _trmm<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
 
+	// Recursion which lands on the fixed-size kernels
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &trmm_dense (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
+
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
-				   MatrixIteratorTypes::Row)
+				   VectorRepresentationTypes::Generic)
 		{ return trmm_impl (F, M, a, A, B, type, diagIsOne); }
 
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   VectorRepresentationTypes::Dense)
+#ifndef __LELA_BLAS_NO_FIXED_SIZE_KERNELS
+		{ return FixedSizeKernels::useKernels (A.rowdim (), B.coldim ())
+			? trmm_dense (F, M, a, A, B, type, diagIsOne)
+			: trmm_impl (F, M, a, A, B, type, diagIsOne); }
+#else
 		{ return trmm_impl (F, M, a, A, B, type, diagIsOne); }
+#endif
 
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   VectorRepresentationTypes::Dense01)
 		{ return trmm_impl (F, M, a, A, B, type, diagIsOne); }
 
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
+				   MatrixIteratorTypes::Row)
+		{ return trmm_impl (F, M, a, A, B, type, diagIsOne, typename VectorTraits<Ring, typename Matrix2::Row>::RepresentationType ()); }
+
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trmm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   MatrixIteratorTypes::Col)
@@ -222,21 +298,36 @@ class _trsm<Ring, typename GenericModule<Ring>::Tag>
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
 
+	// Recursion which lands on the fixed-size kernels
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &trsm_dense (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
+
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
-				   MatrixIteratorTypes::Row)
+				   VectorRepresentationTypes::Generic)
 		{ return trsm_impl (F, M, a, A, B, type, diagIsOne); }
 
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   VectorRepresentationTypes::Dense)
+#ifndef __LELA_BLAS_NO_FIXED_SIZE_KERNELS
+		{ return FixedSizeKernels::useKernels (A.rowdim (), B.coldim ())
+			? trsm_dense (F, M, a, A, B, type, diagIsOne)
+			: trsm_impl (F, M, a, A, B, type, diagIsOne); }
+#else
 		{ return trsm_impl (F, M, a, A, B, type, diagIsOne); }
+#endif
 
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   VectorRepresentationTypes::Dense01)
 		{ return trsm_impl (F, M, a, A, B, type, diagIsOne); }
 
+	template <class Modules, class Matrix1, class Matrix2>
+	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
+				   MatrixIteratorTypes::Row)
+		{ return trsm_impl (F, M, a, A, B, type, diagIsOne, typename VectorTraits<Ring, typename Matrix2::Row>::RepresentationType ()); }
+
 	template <class Modules, class Matrix1, class Matrix2>
 	static Matrix2 &trsm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne,
 				   MatrixIteratorTypes::Col)
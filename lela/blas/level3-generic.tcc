@@ -84,7 +84,7 @@ void _copy<Ring, typename GenericModule<Ring>::Tag>::append_entries_spec (const
 
 	for (i_v = v.begin (); i_v != v.end (); ++i_v) {
 		for (t = Vector::Endianness::e_0, t_idx = 0; t != 0; t = Vector::Endianness::shift_right (t, 1), ++t_idx) {
-			Iterator j = begin + (i_v->first << WordTraits<typename Vector::word_type>::logof_size) + t_idx;
+			Iterator j = begin + ((size_t) i_v->first << WordTraits<typename Vector::word_type>::logof_size) + t_idx;
 
 			if (j == end)
 				break;
@@ -242,10 +242,10 @@ Matrix2 &_axpy<Ring, typename GenericModule<Ring>::Tag>::axpy_impl
 
 template <class Ring>
 template <class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
+Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_rows
 	(const Ring &F, Modules &M,
 	 const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
-	 MatrixIteratorTypes::Row, MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+	 VectorRepresentationTypes::Generic)
 {
 	lela_check (A.coldim () == B.rowdim ());
 	lela_check (A.rowdim () == C.rowdim ());
@@ -256,18 +256,20 @@ Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
 
 	TransposeMatrix<const Matrix2> BT (B);
 
-	for (; i != A.rowEnd (); ++i, ++j)
+	for (; i != A.rowEnd (); ++i, ++j) {
+		M.checkCancelled ();
 		BLAS2::_gemv<Ring, typename Modules::Tag>::op (F, M, a, BT, *i, b, *j);
+	}
 
 	return C;
 }
 
 template <class Ring>
 template <class Modules, class Matrix1, class Matrix2, class Matrix3>
-Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
+Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_cols
 	(const Ring &F, Modules &M,
 	 const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
-	 MatrixIteratorTypes::Col, MatrixIteratorTypes::Col, MatrixIteratorTypes::Col)
+	 VectorRepresentationTypes::Generic, MatrixIteratorTypes::Generic, MatrixIteratorTypes::Generic)
 {
 	lela_check (A.coldim () == B.rowdim ());
 	lela_check (A.rowdim () == C.rowdim ());
@@ -276,8 +278,205 @@ Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
 	typename Matrix2::ConstColIterator i = B.colBegin ();
 	typename Matrix3::ColIterator j = C.colBegin ();
 
-	for (; i != B.colEnd (); ++i, ++j)
+	for (; i != B.colEnd (); ++i, ++j) {
+		M.checkCancelled ();
 		BLAS2::_gemv<Ring, typename Modules::Tag>::op (F, M, a, A, *i, b, *j);
+	}
+
+	return C;
+}
+
+template <class Ring>
+template <class Modules, class Vector1, class Matrix, class Vector2>
+Vector2 &_gemm<Ring, typename GenericModule<Ring>::Tag>::scatter_row
+	(const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Matrix &B, Vector2 &y,
+	 VectorRepresentationTypes::Dense)
+{
+	lela_check (VectorUtils::hasDim<Ring> (x, B.rowdim ()));
+
+	typename Vector1::const_iterator i_x;
+	typename Matrix::ConstRowIterator i_B;
+	typename Ring::Element d;
+
+	for (i_x = x.begin (), i_B = B.rowBegin (); i_x != x.end (); ++i_x, ++i_B) {
+		if (!F.isZero (*i_x)) {
+			F.mul (d, a, *i_x);
+			BLAS1::_axpy<Ring, typename Modules::Tag>::op (F, M, d, *i_B, y);
+		}
+	}
+
+	return y;
+}
+
+template <class Ring>
+template <class Modules, class Vector1, class Matrix, class Vector2>
+Vector2 &_gemm<Ring, typename GenericModule<Ring>::Tag>::scatter_row
+	(const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Matrix &B, Vector2 &y,
+	 VectorRepresentationTypes::Sparse)
+{
+	lela_check (VectorUtils::hasDim<Ring> (x, B.rowdim ()));
+
+	typename Vector1::const_iterator i_x;
+	typename Ring::Element d;
+
+	for (i_x = x.begin (); i_x != x.end (); ++i_x) {
+		F.mul (d, a, i_x->second);
+		BLAS1::_axpy<Ring, typename Modules::Tag>::op (F, M, d, *(B.rowBegin () + i_x->first), y);
+	}
+
+	return y;
+}
+
+template <class Ring>
+template <class Modules, class Vector1, class Matrix, class Vector2>
+Vector2 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_row
+	(const Ring &F, Modules &M,
+	 const typename Ring::Element &a, const Vector1 &x, const Matrix &B, const typename Ring::Element &b, Vector2 &y,
+	 typename Vector<Ring>::Dense &acc, VectorRepresentationTypes::Dense)
+{
+	BLAS1::_scal<Ring, typename Modules::Tag>::op (F, M, b, y);
+
+	return scatter_row (F, M, a, x, B, y, typename VectorTraits<Ring, Vector1>::RepresentationType ());
+}
+
+template <class Ring>
+template <class Modules, class Vector1, class Matrix, class Vector2>
+Vector2 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_row
+	(const Ring &F, Modules &M,
+	 const typename Ring::Element &a, const Vector1 &x, const Matrix &B, const typename Ring::Element &b, Vector2 &y,
+	 typename Vector<Ring>::Dense &acc, VectorRepresentationTypes::Generic)
+{
+	// Adding rows of B to a sparse y one after the other would
+	// merge the whole of y each time, so they are accumulated in
+	// dense form and y is only written once
+	if (F.isZero (b))
+		BLAS1::_scal<Ring, typename Modules::Tag>::op (F, M, F.zero (), acc);
+	else {
+		BLAS1::_copy<Ring, typename Modules::Tag>::op (F, M, y, acc);
+		BLAS1::_scal<Ring, typename Modules::Tag>::op (F, M, b, acc);
+	}
+
+	scatter_row (F, M, a, x, B, acc, typename VectorTraits<Ring, Vector1>::RepresentationType ());
+
+	return BLAS1::_copy<Ring, typename Modules::Tag>::op (F, M, acc, y);
+}
+
+template <class Ring>
+template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_rows
+	(const Ring &F, Modules &M,
+	 const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+	 VectorRepresentationTypes::Sparse)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	// Each row of C is a linear combination of the rows of B with
+	// coefficients from the corresponding row of A, so blocks of
+	// rows of C are independent
+	long num_blocks = (C.rowdim () + scatter_rows_per_block - 1) / scatter_rows_per_block;
+	volatile bool cancelled = false;
+
+#pragma omp parallel if (num_blocks > 1)
+	{
+		Modules thread_M (M);
+		typename Vector<Ring>::Dense acc (C.coldim ());
+
+#pragma omp for schedule(dynamic)
+		for (long p = 0; p < num_blocks; ++p) {
+			if (cancelled)
+				continue;
+
+			size_t start = p * scatter_rows_per_block, end = std::min<size_t> (start + scatter_rows_per_block, C.rowdim ());
+
+			typename Matrix1::ConstRowIterator i_A = A.rowBegin () + start;
+			typename Matrix3::RowIterator i_C = C.rowBegin () + start;
+
+			try {
+				thread_M.checkCancelled ();
+
+				for (size_t i = start; i < end; ++i, ++i_A, ++i_C)
+					gemm_row (F, thread_M, a, *i_A, B, b, *i_C, acc,
+						  typename VectorTraits<Ring, typename Matrix3::Row>::RepresentationType ());
+			}
+			catch (const Cancelled &) {
+				cancelled = true;
+			}
+		}
+	}
+
+	// Exceptions may not leave a parallel region, so cancellation
+	// is rethrown here
+	if (cancelled)
+		M.checkCancelled ();
+
+	return C;
+}
+
+template <class Ring>
+template <class Modules, class Vector1, class Vector2, class Iterator>
+void _gemm<Ring, typename GenericModule<Ring>::Tag>::scatter_col
+	(const Ring &F, Modules &M, const typename Ring::Element &a, const Vector1 &x, const Vector2 &y, Iterator C_rows, size_t start, size_t end)
+{
+	typename Vector1::const_iterator i_x = std::lower_bound (x.begin (), x.end (), start, VectorUtils::FindSparseEntryLB ());
+	typename Ring::Element d;
+
+	for (; i_x != x.end () && i_x->first < end; ++i_x) {
+		F.mul (d, a, i_x->second);
+		BLAS1::_axpy<Ring, typename Modules::Tag>::op (F, M, d, y, *(C_rows + i_x->first));
+	}
+}
+
+template <class Ring>
+template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_cols
+	(const Ring &F, Modules &M,
+	 const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
+	 VectorRepresentationTypes::Sparse, MatrixIteratorTypes::Row, MatrixIteratorTypes::Row)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == C.rowdim ());
+	lela_check (B.coldim () == C.coldim ());
+
+	// Each nonzero entry (i, k) of A adds a multiple of row k of B
+	// to row i of C. Every thread takes a block of rows of C and
+	// visits only the entries of A in those rows.
+	long num_blocks = (C.rowdim () + scatter_rows_per_block - 1) / scatter_rows_per_block;
+	volatile bool cancelled = false;
+
+#pragma omp parallel if (num_blocks > 1)
+	{
+		Modules thread_M (M);
+
+#pragma omp for schedule(dynamic)
+		for (long p = 0; p < num_blocks; ++p) {
+			if (cancelled)
+				continue;
+
+			size_t start = p * scatter_rows_per_block, end = std::min<size_t> (start + scatter_rows_per_block, C.rowdim ());
+
+			typename Matrix1::ConstColIterator i_A;
+			typename Matrix2::ConstRowIterator i_B;
+			typename Matrix3::RowIterator i_C = C.rowBegin () + start;
+
+			try {
+				thread_M.checkCancelled ();
+
+				for (size_t i = start; i < end; ++i, ++i_C)
+					BLAS1::_scal<Ring, typename Modules::Tag>::op (F, thread_M, b, *i_C);
+
+				for (i_A = A.colBegin (), i_B = B.rowBegin (); i_A != A.colEnd (); ++i_A, ++i_B)
+					scatter_col (F, thread_M, a, *i_A, *i_B, C.rowBegin (), start, end);
+			}
+			catch (const Cancelled &) {
+				cancelled = true;
+			}
+		}
+	}
+
+	if (cancelled)
+		M.checkCancelled ();
 
 	return C;
 }
@@ -299,6 +498,8 @@ Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
 	size_t row, col;
 
 	for (i = A.rowBegin (), row = 0; i != A.rowEnd (); ++i, ++row) {
+		M.checkCancelled ();
+
 		for (j = B.colBegin (), col = 0; j != B.colEnd (); ++j, ++col) {
 			BLAS1::_dot<Ring, typename Modules::Tag>::op (F, M, d, *i, *j);
 
@@ -337,8 +538,10 @@ Matrix3 &_gemm<Ring, typename GenericModule<Ring>::Tag>::gemm_impl
 
 	_scal<Ring, typename Modules::Tag>::op (F, M, b, C);
 
-	for (i = A.colBegin (), j = B.rowBegin (); i != A.colEnd (); ++i, ++j)
+	for (i = A.colBegin (), j = B.rowBegin (); i != A.colEnd (); ++i, ++j) {
+		M.checkCancelled ();
 		BLAS2::_ger<Ring, typename Modules::Tag>::op (F, M, a, *i, *j, C);
+	}
 
 	return C;
 }
@@ -418,6 +621,50 @@ Matrix2 &_trmm<Ring, typename GenericModule<Ring>::Tag>::trmm_impl
 	}
 }
 
+template <class Ring>
+template <class Modules, class Matrix1, class Matrix2>
+Matrix2 &_trmm<Ring, typename GenericModule<Ring>::Tag>::trmm_dense
+	(const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == B.rowdim ());
+
+	if (F.isZero (a))
+		return trmm_impl (F, M, a, A, B, type, diagIsOne);
+
+	switch (A.rowdim ()) {
+	case 4:  return FixedSizeKernel<Ring, 4>::trmm (F, a, A, B, type, diagIsOne);
+	case 8:  return FixedSizeKernel<Ring, 8>::trmm (F, a, A, B, type, diagIsOne);
+	case 16: return FixedSizeKernel<Ring, 16>::trmm (F, a, A, B, type, diagIsOne);
+	case 32: return FixedSizeKernel<Ring, 32>::trmm (F, a, A, B, type, diagIsOne);
+	}
+
+	if (A.rowdim () < FixedSizeKernels::min_size)
+		return trmm_impl (F, M, a, A, B, type, diagIsOne);
+
+	size_t l = FixedSizeKernels::split (A.rowdim ());
+	typename Matrix1::ConstSubmatrixType A11 (A, 0, 0, l, l);
+	typename Matrix1::ConstSubmatrixType A22 (A, l, l, A.rowdim () - l, A.coldim () - l);
+
+	typename Matrix2::AlignedSubmatrixType B1 (B, 0, 0, l, B.coldim ());
+	typename Matrix2::AlignedSubmatrixType B2 (B, l, 0, B.rowdim () - l, B.coldim ());
+
+	if (type == LowerTriangular) {
+		typename Matrix1::ConstSubmatrixType A21 (A, l, 0, A.rowdim () - l, l);
+		_trmm<Ring, typename Modules::Tag>::op (F, M, a, A22, B2, type, diagIsOne);
+		_gemm<Ring, typename Modules::Tag>::op (F, M, a, A21, B1, F.one (), B2);
+		_trmm<Ring, typename Modules::Tag>::op (F, M, a, A11, B1, type, diagIsOne);
+	}
+	else if (type == UpperTriangular) {
+		typename Matrix1::ConstSubmatrixType A12 (A, 0, l, l, A.coldim () - l);
+		_trmm<Ring, typename Modules::Tag>::op (F, M, a, A11, B1, type, diagIsOne);
+		_gemm<Ring, typename Modules::Tag>::op (F, M, a, A12, B2, F.one (), B1);
+		_trmm<Ring, typename Modules::Tag>::op (F, M, a, A22, B2, type, diagIsOne);
+	}
+
+	return B;
+}
+
 template <class Ring>
 template <class Modules, class Matrix1, class Matrix2>
 Matrix2 &_trsm<Ring, typename GenericModule<Ring>::Tag>::trsm_impl
@@ -434,7 +681,7 @@ Matrix2 &_trsm<Ring, typename GenericModule<Ring>::Tag>::trsm_impl
 		return _scal<Ring, typename Modules::Tag>::op (F, M, a, B);
 	else if (A.rowdim () == 1) {
 		if (diagIsOne)
-			return _scal<Ring, typename Modules::Tag>::op (F, M, a, B);
+			return F.isOne (a) ? B : _scal<Ring, typename Modules::Tag>::op (F, M, a, B);
 		else {
 			typename Ring::Element ai;
 
@@ -493,6 +740,50 @@ Matrix2 &_trsm<Ring, typename GenericModule<Ring>::Tag>::trsm_impl
 	}
 }
 
+template <class Ring>
+template <class Modules, class Matrix1, class Matrix2>
+Matrix2 &_trsm<Ring, typename GenericModule<Ring>::Tag>::trsm_dense
+	(const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+{
+	lela_check (A.coldim () == B.rowdim ());
+	lela_check (A.rowdim () == B.rowdim ());
+
+	if (F.isZero (a))
+		return trsm_impl (F, M, a, A, B, type, diagIsOne);
+
+	switch (A.rowdim ()) {
+	case 4:  return FixedSizeKernel<Ring, 4>::trsm (F, a, A, B, type, diagIsOne);
+	case 8:  return FixedSizeKernel<Ring, 8>::trsm (F, a, A, B, type, diagIsOne);
+	case 16: return FixedSizeKernel<Ring, 16>::trsm (F, a, A, B, type, diagIsOne);
+	case 32: return FixedSizeKernel<Ring, 32>::trsm (F, a, A, B, type, diagIsOne);
+	}
+
+	if (A.rowdim () < FixedSizeKernels::min_size)
+		return trsm_impl (F, M, a, A, B, type, diagIsOne);
+
+	size_t l = FixedSizeKernels::split (A.rowdim ());
+	typename Matrix1::ConstSubmatrixType A11 (A, 0, 0, l, l);
+	typename Matrix1::ConstSubmatrixType A22 (A, l, l, A.rowdim () - l, A.coldim () - l);
+
+	typename Matrix2::AlignedSubmatrixType B1 (B, 0, 0, l, B.coldim ());
+	typename Matrix2::AlignedSubmatrixType B2 (B, l, 0, B.rowdim () - l, B.coldim ());
+
+	if (type == LowerTriangular) {
+		typename Matrix1::ConstSubmatrixType A21 (A, l, 0, A.rowdim () - l, l);
+		_trsm<Ring, typename Modules::Tag>::op (F, M, a, A11, B1, type, diagIsOne);
+		_gemm<Ring, typename Modules::Tag>::op (F, M, F.minusOne (), A21, B1, a, B2);
+		_trsm<Ring, typename Modules::Tag>::op (F, M, F.one (), A22, B2, type, diagIsOne);
+	}
+	else if (type == UpperTriangular) {
+		typename Matrix1::ConstSubmatrixType A12 (A, 0, l, l, A.coldim () - l);
+		_trsm<Ring, typename Modules::Tag>::op (F, M, a, A22, B2, type, diagIsOne);
+		_gemm<Ring, typename Modules::Tag>::op (F, M, F.minusOne (), A12, B2, a, B1);
+		_trsm<Ring, typename Modules::Tag>::op (F, M, F.one (), A11, B1, type, diagIsOne);
+	}
+
+	return B;
+}
+
 template <class Ring>
 template <class Modules, class Iterator, class Matrix>
 Matrix &_permute_rows<Ring, typename GenericModule<Ring>::Tag>::permute_rows_impl
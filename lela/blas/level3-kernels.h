@@ -0,0 +1,155 @@
+/* lela/blas/level3-kernels.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Fixed-size kernels for the base-cases of recursive level 3 BLAS
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_KERNELS_H
+#define __BLAS_LEVEL3_KERNELS_H
+
+#include "lela/blas/context.h"
+#include "lela/matrix/traits.h"
+
+namespace LELA
+{
+
+/** Sizes of the fixed-size kernels and how recursions reach them
+ *
+ * \ingroup blas
+ */
+struct FixedSizeKernels
+{
+	/// Smallest dimension for which there is a kernel
+	static const size_t min_size = 4;
+
+	/// Largest dimension for which there is a kernel
+	static const size_t max_size = 32;
+
+	/** Minimal ratio of the column-dimension of the other operand
+	 * to the dimension of the triangular matrix for which the
+	 * kernels are used
+	 *
+	 * The kernels only pay off when the base-cases are a large part
+	 * of the work. For Modular<uint32>, with right-hand sides at
+	 * least eight times as wide as the triangular matrix, they are
+	 * 20-35% faster for a triangular matrix of dimension 32 and
+	 * 5-10% faster for dimension 128. On square problems, where the
+	 * updates with gemm dominate, they are no faster.
+	 */
+	static const size_t min_width_ratio = 8;
+
+	/// Whether there is a kernel of dimension n
+	static bool isKernelSize (size_t n)
+		{ return n == 4 || n == 8 || n == 16 || n == 32; }
+
+	/// Whether to use the kernels for a triangular matrix of
+	/// dimension n and another operand with the given column-dimension
+	static bool useKernels (size_t n, size_t width)
+		{ return width >= min_width_ratio * n; }
+
+	/** Dimension of the leading block when splitting a problem of
+	 * dimension n
+	 *
+	 * Above max_size, the leading block is about half of the
+	 * problem and a multiple of max_size; below, it is the largest
+	 * kernel-size less than n. Either way, every block of the
+	 * recursion other than the trailing one has a kernel-size.
+	 */
+	static size_t split (size_t n)
+	{
+		if (n > max_size)
+			return max_size * ((n / max_size + 1) / 2);
+
+		size_t l = max_size;
+
+		while (l >= n)
+			l /= 2;
+
+		return l;
+	}
+};
+
+/** Kernels for triangular blocks of fixed dimension N
+ *
+ * The triangular matrix is loaded into an N x N array, with the
+ * diagonal inverted for trsm, and the other operand is processed in
+ * tiles of N columns, so that all loops but the one over the tiles
+ * have a length known at compile-time and may be unrolled. The other
+ * operand must have a dense representation; the triangular matrix is
+ * read with getEntry and so may be of any type.
+ *
+ * \ingroup blas
+ */
+template <class Ring, size_t N>
+class FixedSizeKernel
+{
+	typedef typename Ring::Element Element;
+
+	// The arrays are allocated on the heap, since N^2 elements may
+	// be too large for the stack when elements are large
+	struct Tile { Element e[N][N]; };
+
+	template <class Matrix>
+	static void loadTriangular (const Ring &F, Element T[N][N], const Matrix &A, TriangularMatrixType type, bool diagIsOne, bool invert);
+
+	template <class Matrix>
+	static void loadTile (const Ring &F, Element X[N][N], const Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Row);
+
+	template <class Matrix>
+	static void loadTile (const Ring &F, Element X[N][N], const Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Col);
+
+	template <class Matrix>
+	static void loadTile (const Ring &F, Element X[N][N], const Matrix &B, size_t j, size_t w, MatrixIteratorTypes::RowCol)
+		{ loadTile (F, X, B, j, w, MatrixIteratorTypes::Row ()); }
+
+	template <class Matrix>
+	static void storeTile (const Ring &F, const Element X[N][N], Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Row);
+
+	template <class Matrix>
+	static void storeTile (const Ring &F, const Element X[N][N], Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Col);
+
+	template <class Matrix>
+	static void storeTile (const Ring &F, const Element X[N][N], Matrix &B, size_t j, size_t w, MatrixIteratorTypes::RowCol)
+		{ storeTile (F, X, B, j, w, MatrixIteratorTypes::Row ()); }
+
+	// X <- T^-1 X resp. X <- T X on one tile
+	static void solveTile (const Ring &F, const Element T[N][N], Element X[N][N], TriangularMatrixType type, bool diagIsOne);
+	static void mulTile (const Ring &F, const Element T[N][N], Element X[N][N], TriangularMatrixType type, bool diagIsOne);
+
+	// X <- a X
+	static void scalTile (const Ring &F, const Element &a, Element X[N][N]);
+
+public:
+	/** B <- a A^-1 B, where A is N x N triangular
+	 *
+	 * Throws DiagonalEntryNotInvertible if diagIsOne is false and
+	 * some diagonal entry of A is not invertible.
+	 */
+	template <class Matrix1, class Matrix2>
+	static Matrix2 &trsm (const Ring &F, const Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
+
+	/** B <- a A B, where A is N x N triangular */
+	template <class Matrix1, class Matrix2>
+	static Matrix2 &trmm (const Ring &F, const Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne);
+};
+
+} // namespace LELA
+
+#include "lela/blas/level3-kernels.tcc"
+
+#endif // __BLAS_LEVEL3_KERNELS_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,247 @@
+/* lela/blas/level3-kernels.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Fixed-size kernels for the base-cases of recursive level 3 BLAS
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __BLAS_LEVEL3_KERNELS_TCC
+#define __BLAS_LEVEL3_KERNELS_TCC
+
+#include <vector>
+
+#include "lela/blas/level3-kernels.h"
+#include "lela/util/error.h"
+#include "lela/util/debug.h"
+
+namespace LELA
+{
+
+template <class Ring, size_t N>
+template <class Matrix>
+void FixedSizeKernel<Ring, N>::loadTriangular (const Ring &F, Element T[N][N], const Matrix &A, TriangularMatrixType type, bool diagIsOne, bool invert)
+{
+	lela_check (A.rowdim () == N);
+	lela_check (A.coldim () == N);
+
+	size_t i, l;
+
+	for (i = 0; i < N; ++i) {
+		for (l = 0; l < N; ++l) {
+			if ((type == LowerTriangular && l > i) || (type == UpperTriangular && l < i) || (l == i && diagIsOne) || !A.getEntry (T[i][l], i, l))
+				F.copy (T[i][l], F.zero ());
+			else if (invert && l != i)
+				F.negin (T[i][l]);
+		}
+
+		if (invert && !diagIsOne && !F.invin (T[i][i]))
+			throw DiagonalEntryNotInvertible ();
+	}
+}
+
+template <class Ring, size_t N>
+template <class Matrix>
+void FixedSizeKernel<Ring, N>::loadTile (const Ring &F, Element X[N][N], const Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Row)
+{
+	typename Matrix::ConstRowIterator i_B;
+	size_t i, c;
+
+	for (i_B = B.rowBegin (), i = 0; i < N; ++i_B, ++i) {
+		for (c = 0; c < w; ++c)
+			F.copy (X[i][c], (*i_B)[j + c]);
+
+		for (; c < N; ++c)
+			F.copy (X[i][c], F.zero ());
+	}
+}
+
+template <class Ring, size_t N>
+template <class Matrix>
+void FixedSizeKernel<Ring, N>::loadTile (const Ring &F, Element X[N][N], const Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Col)
+{
+	typename Matrix::ConstColIterator i_B;
+	size_t i, c;
+
+	for (i_B = B.colBegin () + j, c = 0; c < w; ++i_B, ++c)
+		for (i = 0; i < N; ++i)
+			F.copy (X[i][c], (*i_B)[i]);
+
+	for (; c < N; ++c)
+		for (i = 0; i < N; ++i)
+			F.copy (X[i][c], F.zero ());
+}
+
+template <class Ring, size_t N>
+template <class Matrix>
+void FixedSizeKernel<Ring, N>::storeTile (const Ring &F, const Element X[N][N], Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Row)
+{
+	typename Matrix::RowIterator i_B;
+	size_t i, c;
+
+	for (i_B = B.rowBegin (), i = 0; i < N; ++i_B, ++i)
+		for (c = 0; c < w; ++c)
+			F.copy ((*i_B)[j + c], X[i][c]);
+}
+
+template <class Ring, size_t N>
+template <class Matrix>
+void FixedSizeKernel<Ring, N>::storeTile (const Ring &F, const Element X[N][N], Matrix &B, size_t j, size_t w, MatrixIteratorTypes::Col)
+{
+	typename Matrix::ColIterator i_B;
+	size_t i, c;
+
+	for (i_B = B.colBegin () + j, c = 0; c < w; ++i_B, ++c)
+		for (i = 0; i < N; ++i)
+			F.copy ((*i_B)[i], X[i][c]);
+}
+
+template <class Ring, size_t N>
+void FixedSizeKernel<Ring, N>::solveTile (const Ring &F, const Element T[N][N], Element X[N][N], TriangularMatrixType type, bool diagIsOne)
+{
+	size_t i, l, c;
+
+	// T holds the negated off-diagonal entries and the inverted
+	// diagonal
+
+	if (type == LowerTriangular) {
+		for (i = 0; i < N; ++i) {
+			for (l = 0; l < i; ++l)
+				if (!F.isZero (T[i][l]))
+					for (c = 0; c < N; ++c)
+						F.axpyin (X[i][c], T[i][l], X[l][c]);
+
+			if (!diagIsOne)
+				for (c = 0; c < N; ++c)
+					F.mulin (X[i][c], T[i][i]);
+		}
+	}
+	else if (type == UpperTriangular) {
+		for (i = N; i-- > 0;) {
+			for (l = i + 1; l < N; ++l)
+				if (!F.isZero (T[i][l]))
+					for (c = 0; c < N; ++c)
+						F.axpyin (X[i][c], T[i][l], X[l][c]);
+
+			if (!diagIsOne)
+				for (c = 0; c < N; ++c)
+					F.mulin (X[i][c], T[i][i]);
+		}
+	}
+}
+
+template <class Ring, size_t N>
+void FixedSizeKernel<Ring, N>::mulTile (const Ring &F, const Element T[N][N], Element X[N][N], TriangularMatrixType type, bool diagIsOne)
+{
+	size_t i, l, c;
+
+	// Each row of the result depends only on rows of X not yet
+	// overwritten: those above it for lower triangular T and those
+	// below it for upper triangular T
+
+	if (type == LowerTriangular) {
+		for (i = N; i-- > 0;) {
+			if (!diagIsOne)
+				for (c = 0; c < N; ++c)
+					F.mulin (X[i][c], T[i][i]);
+
+			for (l = 0; l < i; ++l)
+				if (!F.isZero (T[i][l]))
+					for (c = 0; c < N; ++c)
+						F.axpyin (X[i][c], T[i][l], X[l][c]);
+		}
+	}
+	else if (type == UpperTriangular) {
+		for (i = 0; i < N; ++i) {
+			if (!diagIsOne)
+				for (c = 0; c < N; ++c)
+					F.mulin (X[i][c], T[i][i]);
+
+			for (l = i + 1; l < N; ++l)
+				if (!F.isZero (T[i][l]))
+					for (c = 0; c < N; ++c)
+						F.axpyin (X[i][c], T[i][l], X[l][c]);
+		}
+	}
+}
+
+template <class Ring, size_t N>
+void FixedSizeKernel<Ring, N>::scalTile (const Ring &F, const Element &a, Element X[N][N])
+{
+	size_t i, c;
+
+	for (i = 0; i < N; ++i)
+		for (c = 0; c < N; ++c)
+			F.mulin (X[i][c], a);
+}
+
+template <class Ring, size_t N>
+template <class Matrix1, class Matrix2>
+Matrix2 &FixedSizeKernel<Ring, N>::trsm (const Ring &F, const Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+{
+	lela_check (B.rowdim () == N);
+
+	std::vector<Tile> tiles (2);
+	Element (&T)[N][N] = tiles[0].e, (&X)[N][N] = tiles[1].e;
+	size_t j, w;
+
+	loadTriangular (F, T, A, type, diagIsOne, true);
+
+	for (j = 0; j < B.coldim (); j += N) {
+		w = std::min (N, B.coldim () - j);
+
+		loadTile (F, X, B, j, w, typename Matrix2::IteratorType ());
+
+		if (!F.isOne (a))
+			scalTile (F, a, X);
+
+		solveTile (F, T, X, type, diagIsOne);
+		storeTile (F, X, B, j, w, typename Matrix2::IteratorType ());
+	}
+
+	return B;
+}
+
+template <class Ring, size_t N>
+template <class Matrix1, class Matrix2>
+Matrix2 &FixedSizeKernel<Ring, N>::trmm (const Ring &F, const Element &a, const Matrix1 &A, Matrix2 &B, TriangularMatrixType type, bool diagIsOne)
+{
+	lela_check (B.rowdim () == N);
+
+	std::vector<Tile> tiles (2);
+	Element (&T)[N][N] = tiles[0].e, (&X)[N][N] = tiles[1].e;
+	size_t j, w;
+
+	loadTriangular (F, T, A, type, diagIsOne, false);
+
+	for (j = 0; j < B.coldim (); j += N) {
+		w = std::min (N, B.coldim () - j);
+
+		loadTile (F, X, B, j, w, typename Matrix2::IteratorType ());
+		mulTile (F, T, X, type, diagIsOne);
+
+		if (!F.isOne (a))
+			scalTile (F, a, X);
+
+		storeTile (F, X, B, j, w, typename Matrix2::IteratorType ());
+	}
+
+	return B;
+}
+
+} // namespace LELA
+
+#endif // __BLAS_LEVEL3_KERNELS_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
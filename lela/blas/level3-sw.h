@@ -12,6 +12,7 @@
 #define __BLAS_LEVEL3_SW_H
 
 #include "lela/blas/context.h"
+#include "lela/matrix/traits.h"
 #include "lela/blas/level3-ll.h"
 #include "lela/algorithms/strassen-winograd.h"
 
@@ -25,6 +26,18 @@ namespace BLAS3
 template <class Ring, class ParentModule>
 class _gemm<Ring, StrassenModuleTag<Ring, ParentModule> >
 {
+	// Strassen-Winograd would convert sparse inputs into dense
+	// temporaries, so products with a sparse input are left to the
+	// parent module, which has kernels for them
+	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
+	static Matrix3 &gemm_dense (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C)
+	{
+		if (DenseRepresentation<Ring>::isDense (A) && DenseRepresentation<Ring>::isDense (B))
+			return ((StrassenModule<Ring, ParentModule> &) M).sw.gemm (F, M, a, A, B, b, C);
+		else
+			return _gemm<Ring, typename ParentModule::Tag>::op (F, M, a, A, B, b, C);
+	}
+
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
 				   VectorRepresentationTypes::Generic)
@@ -33,12 +46,12 @@ class _gemm<Ring, StrassenModuleTag<Ring, ParentModule> >
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
 				   VectorRepresentationTypes::Dense)
-		{ return ((StrassenModule<Ring, ParentModule> &) M).sw.gemm (F, M, a, A, B, b, C); }
+		{ return gemm_dense (F, M, a, A, B, b, C); }
 
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
 				   VectorRepresentationTypes::Dense01)
-		{ return ((StrassenModule<Ring, ParentModule> &) M).sw.gemm (F, M, a, A, B, b, C); }
+		{ return gemm_dense (F, M, a, A, B, b, C); }
 
 	template <class Modules, class Matrix1, class Matrix2, class Matrix3>
 	static Matrix3 &gemm_impl (const Ring &F, Modules &M, const typename Ring::Element &a, const Matrix1 &A, const Matrix2 &B, const typename Ring::Element &b, Matrix3 &C,
@@ -42,6 +42,12 @@ class _dot<Modular<Element>, typename ZpModule<Element>::Tag>
 	static Element &dot_impl (const Modular<Element> &F, ZpModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
 				  VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	// Other representations, e.g. adaptive vectors, are left to the parent module
+	template <class Vector1, class Vector2>
+	static Element &dot_impl (const Modular<Element> &F, ZpModule<Element> &M, Element &res, const Vector1 &x, const Vector2 &y,
+				  VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _dot<Modular<Element>, typename ZpModule<Element>::Tag::Parent>::op (F, M, res, x, y); }
+
 public:
 	template <class Modules, class reference, class Vector1, class Vector2>
 	static reference &op (const Modular<Element> &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y)
@@ -76,6 +82,12 @@ class _dot<Modular<uint32>, ZpModule<uint32>::Tag>
 	static uint32 &dot_impl (const Modular<uint32> &F, ZpModule<uint32> &M, uint32 &res, const Vector1 &x, const Vector2 &y,
 				 VectorRepresentationTypes::Sparse, VectorRepresentationTypes::Sparse);
 
+	// Other representations, e.g. adaptive vectors, are left to the parent module
+	template <class Vector1, class Vector2>
+	static uint32 &dot_impl (const Modular<uint32> &F, ZpModule<uint32> &M, uint32 &res, const Vector1 &x, const Vector2 &y,
+				 VectorRepresentationTypes::Generic, VectorRepresentationTypes::Generic)
+		{ return _dot<Modular<uint32>, ZpModule<uint32>::Tag::Parent>::op (F, M, res, x, y); }
+
 public:
 	template <class Modules, class reference, class Vector1, class Vector2>
 	static reference &op (const Modular<uint32> &F, Modules &M, reference &res, const Vector1 &x, const Vector2 &y)
@@ -218,7 +218,7 @@ class Dense01Matrix
 
 	///
 	Dense01Matrix (const Dense01Matrix &M)
-		: _rep (M._rep), _rows (M._rows), _cols (M._cols), _disp (M._disp), _begin (M._begin)
+		: _rep (M._rep), _rows (M._rows), _cols (M._cols), _disp (M._disp), _begin (M._rep.empty () ? M._begin : _rep.word_begin ())
 	{}
 
 	~Dense01Matrix(){}
@@ -229,6 +229,20 @@ class Dense01Matrix
 		(*this)._rows = M._rows;
 		(*this)._cols = M._cols;
 		(*this)._disp  = M._disp;
+
+		if (!_rep.empty ())
+			_begin = _rep.word_begin ();
+
+		return (*this);
+	}
+
+	///
+	Dense01Matrix& operator= (const Dense01Matrix& M) {
+		(*this)._rep  = M._rep;
+		(*this)._rows = M._rows;
+		(*this)._cols = M._cols;
+		(*this)._disp  = M._disp;
+		(*this)._begin = _rep.empty () ? M._begin : _rep.word_begin ();
 		return (*this);
 	}
 
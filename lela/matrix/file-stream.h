@@ -0,0 +1,123 @@
+/* lela/matrix/file-stream.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Stream of the rows of a matrix stored in a file
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_FILE_STREAM_H
+#define __LELA_MATRIX_FILE_STREAM_H
+
+#include <fstream>
+#include <vector>
+
+#include "lela/blas/context.h"
+#include "lela/vector/stream.h"
+#include "lela/matrix/io.h"
+
+// Default size of the buffer through which the file is read
+#ifndef FILE_STREAM_BUFFER_SIZE
+#  define FILE_STREAM_BUFFER_SIZE (1 << 20)
+#endif // FILE_STREAM_BUFFER_SIZE
+
+namespace LELA
+{
+
+/** Stream of the rows of a matrix in a file in Dumas-format
+ *
+ * Reads the rows of the matrix one at a time as they are requested,
+ * so that the matrix is never held in memory as a whole. Together
+ * with the streaming routines in lela/blas/level2-stream.h, this
+ * permits matrix-vector products with matrices larger than the
+ * available memory.
+ *
+ * The entries in the file must be ordered by row; the order within a
+ * row is that in which they are appended to the vector, so it must
+ * be increasing for sparse vectors. A row out of order causes
+ * InvalidMatrixInput to be thrown.
+ *
+ * \ingroup matrix
+ */
+template <class Ring, class _Vector>
+class DumasFileStream : public VectorStream<_Vector>
+{
+    public:
+	typedef _Vector Vector;
+	typedef DumasFileStream<Ring, Vector> Self_t;
+
+	/** Constructor
+	 *
+	 * @param F Ring over which the matrix is defined
+	 * @param filename Name of the file to be read
+	 * @param buffer_size Size in bytes of the buffer through which
+	 * the file is read
+	 */
+	DumasFileStream (const Ring &F, const char *filename, size_t buffer_size = FILE_STREAM_BUFFER_SIZE);
+
+	/** Read the next row of the matrix
+	 * @param v Vector into which to store the row
+	 * @return Reference to v
+	 */
+	Vector &get (Vector &v);
+
+	/** Extraction operator form
+	 */
+	Self_t &operator >> (Vector &v)
+		{ get (v); return *this; }
+
+	/** Row-dimension of the matrix
+	 */
+	size_t size () const { return _m; }
+
+	/** Number of rows read so far
+	 */
+	size_t pos () const { return _i; }
+
+	/** Column-dimension of the matrix
+	 */
+	size_t dim () const { return _n; }
+
+	/** Check whether there are rows left to read
+	 */
+	operator bool () const { return _i < _m; }
+
+	/** Return to the first row of the matrix
+	 */
+	void reset ();
+
+    private:
+	// Read the next entry into _next_row, _next_col, and
+	// _next_entry; _next_row is 0 once the entries are exhausted
+	void readEntry ();
+
+	Context<Ring> _ctx;
+	std::vector<char> _buffer;
+	std::ifstream _is;
+	std::streampos _start;
+
+	size_t _m, _n, _i;
+
+	size_t _next_row, _next_col;
+	typename Ring::Element _next_entry;
+};
+
+} // namespace LELA
+
+#include "lela/matrix/file-stream.tcc"
+
+#endif // __LELA_MATRIX_FILE_STREAM_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,111 @@
+/* lela/matrix/file-stream.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Stream of the rows of a matrix stored in a file
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_FILE_STREAM_TCC
+#define __LELA_MATRIX_FILE_STREAM_TCC
+
+#include "lela/matrix/file-stream.h"
+#include "lela/blas/level1.h"
+#include "lela/util/error.h"
+
+namespace LELA
+{
+
+template <class Ring, class Vector>
+DumasFileStream<Ring, Vector>::DumasFileStream (const Ring &F, const char *filename, size_t buffer_size)
+	: _ctx (F), _buffer (buffer_size), _m (0), _n (0), _i (0), _next_row (0), _next_col (0)
+{
+	// The buffer must be installed before the file is opened
+	if (!_buffer.empty ())
+		_is.rdbuf ()->pubsetbuf (&_buffer[0], _buffer.size ());
+
+	_is.open (filename);
+
+	if (!_is)
+		throw LELAError ("Could not open matrix-file");
+
+	char c;
+
+	_is >> _m >> _n >> c;
+
+	if (!_is || c != 'M')
+		throw InvalidMatrixInput ();
+
+	if (_n > VectorUtils::maxDim<Ring, Vector> ())
+		throw IndexOverflow ("Column-dimension exceeds capacity of row-indices");
+
+	_start = _is.tellg ();
+
+	_ctx.F.copy (_next_entry, _ctx.F.zero ());
+
+	readEntry ();
+}
+
+template <class Ring, class Vector>
+void DumasFileStream<Ring, Vector>::readEntry ()
+{
+	if (!(_is >> _next_row) || _next_row == 0 || _next_row == (size_t) -1) {
+		_next_row = 0;
+		return;
+	}
+
+	_is >> _next_col;
+	_ctx.F.read (_is, _next_entry);
+
+	if (!_is || _next_row > _m || _next_col == 0 || _next_col > _n)
+		throw InvalidMatrixInput ();
+}
+
+template <class Ring, class Vector>
+Vector &DumasFileStream<Ring, Vector>::get (Vector &v)
+{
+	VectorUtils::ensureDim<Ring, Vector> (v, _n);
+	BLAS1::scal (_ctx, _ctx.F.zero (), v);
+
+	if (_next_row != 0 && _next_row <= _i)
+		throw InvalidMatrixInput ();
+
+	while (_next_row == _i + 1) {
+		if (!_ctx.F.isZero (_next_entry))
+			VectorUtils::appendEntry (_ctx.F, v, _next_entry, _next_col - 1);
+
+		readEntry ();
+	}
+
+	++_i;
+
+	return v;
+}
+
+template <class Ring, class Vector>
+void DumasFileStream<Ring, Vector>::reset ()
+{
+	_is.clear ();
+	_is.seekg (_start);
+	_i = 0;
+
+	readEntry ();
+}
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_FILE_STREAM_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
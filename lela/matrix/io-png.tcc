@@ -255,7 +255,7 @@ void MatrixWriter<Ring>::copyToPNGDataSpecialised (png_bytep data, const Vector
 	std::fill (data, data + (width + WordTraits<png_byte>::bits - 1) / WordTraits<png_byte>::bits, (png_byte) -1);
 
 	for (i = v.begin (); i != v.end (); ++i) {
-		idx = i->first << WordTraits<typename Vector::word_type>::logof_size;
+		idx = (size_t) i->first << WordTraits<typename Vector::word_type>::logof_size;
 
 		for (t = Vector::Endianness::e_0; t != 0 && idx < width; t = Vector::Endianness::shift_right (t, 1), ++idx) {
 			if (i->second & t)
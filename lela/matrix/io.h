@@ -13,6 +13,9 @@
 #define __LELA_MATRIX_IO_H
 
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "lela/lela-config.h"
 
@@ -20,8 +23,10 @@
 #  include <png.h>
 #endif
 
+#include "lela/util/index.h"
 #include "lela/vector/traits.h"
 #include "lela/matrix/traits.h"
+#include "lela/util/output-buffer.h"
 
 namespace LELA
 {
@@ -90,6 +95,24 @@ private:
 	template <class Matrix>
 	std::istream &readPretty (std::istream &is, Matrix &A) const;
 
+	// Throw IndexOverflow if a matrix of type Matrix cannot have
+	// dimensions m x n
+	template <class Matrix>
+	static void checkDimsSpecialised (size_t m, size_t n, MatrixIteratorTypes::Row)
+		{ if (n > VectorUtils::maxDim<Ring, typename Matrix::Row> ()) throw IndexOverflow ("Column-dimension exceeds capacity of row-indices"); }
+
+	template <class Matrix>
+	static void checkDimsSpecialised (size_t m, size_t n, MatrixIteratorTypes::Col)
+		{ if (m > VectorUtils::maxDim<Ring, typename Matrix::Col> ()) throw IndexOverflow ("Row-dimension exceeds capacity of column-indices"); }
+
+	template <class Matrix>
+	static void checkDimsSpecialised (size_t m, size_t n, MatrixIteratorTypes::RowCol)
+		{ checkDimsSpecialised<Matrix> (m, n, MatrixIteratorTypes::Row ()); }
+
+	template <class Matrix>
+	static void checkDims (size_t m, size_t n)
+		{ checkDimsSpecialised<Matrix> (m, n, typename Matrix::IteratorType ()); }
+
 	static bool isDumas (char *buf, std::streamsize n);
 	static bool isTurner (char *buf, std::streamsize n);
 	static bool isMaple (char *buf, std::streamsize n);
@@ -169,16 +192,94 @@ private:
 	void appendEntrySpecialised (Vector &v, size_t index, const typename Ring::Element &a, VectorRepresentationTypes::Hybrid01) const;
 };
 
-/// Class for writing a matrix to a stream
-///
-/// \ingroup matrix
+template <class _Element> class Modular;
+class GF2;
+
+/** Formats ring-elements into an OutputBuffer
+ *
+ * The generic version passes each element through Ring::write into a
+ * reused string-stream. Rings whose elements are machine-integers
+ * are specialised below to format directly into the buffer.
+ *
+ * One formatter should be used by one thread only.
+ *
+ * \ingroup matrix
+ */
+template <class Ring>
+class ElementFormatter {
+	const Ring &_F;
+	std::ostringstream _os;
+
+public:
+	ElementFormatter (const Ring &F) : _F (F) {}
+
+	void format (OutputBuffer &buf, const typename Ring::Element &a)
+	{
+		_os.str ("");
+		_F.write (_os, a);
+		const std::string &s = _os.str ();
+		buf.put (s.data (), s.size ());
+	}
+};
+
+template <>
+class ElementFormatter<Modular<uint8> > {
+public:
+	ElementFormatter (const Modular<uint8> &) {}
+	void format (OutputBuffer &buf, uint8 a) { buf.putUnsigned (a); }
+};
+
+template <>
+class ElementFormatter<Modular<uint16> > {
+public:
+	ElementFormatter (const Modular<uint16> &) {}
+	void format (OutputBuffer &buf, uint16 a) { buf.putUnsigned (a); }
+};
+
+template <>
+class ElementFormatter<Modular<uint32> > {
+public:
+	ElementFormatter (const Modular<uint32> &) {}
+	void format (OutputBuffer &buf, uint32 a) { buf.putUnsigned (a); }
+};
+
+template <>
+class ElementFormatter<GF2> {
+public:
+	ElementFormatter (const GF2 &) {}
+	void format (OutputBuffer &buf, bool a) { buf.put (a ? '1' : '0'); }
+};
+
+/** Class for writing a matrix to a stream
+ *
+ * Output is formatted into OutputBuffers rather than directly into
+ * the stream. If LELA is compiled with OpenMP, batches of rows
+ * (respectively of nonzero entries for the sparse formats) are
+ * formatted in parallel, one buffer per thread, and the buffers are
+ * then written to the stream in order.
+ *
+ * \ingroup matrix
+ */
 template <class Ring>
 class MatrixWriter {
 	const Ring &_F;
+	int _threads;
+
+	// Number of nonzero entries collected before they are formatted in one batch
+	static const size_t entry_batch_size = 1 << 16;
+
+	// Number of rows formatted in one batch by the dense output-formats
+	static const size_t row_batch_size = 256;
 
 public:
-	/// Construct a new MatrixWriter using the ring F for element-output
-	MatrixWriter (const Ring &F) : _F (F) {}
+	/** Construct a new MatrixWriter using the ring F for element-output
+	 *
+	 * @param F Ring
+	 * @param threads Number of parts into which the output is divided
+	 * to be formatted in parallel. The output does not depend on
+	 * this. If zero, the maximum number of OpenMP-threads is used.
+	 */
+	MatrixWriter (const Ring &F, int threads = 0) : _F (F), _threads (threads) {}
 
 	template <class Matrix>
 	std::ostream &write (std::ostream &os, const Matrix &A, FileFormatTag format = FORMAT_PRETTY) const;
@@ -205,6 +306,35 @@ private:
 	template <class Matrix>
 	std::ostream &writePretty (std::ostream &os, const Matrix &A) const;
 
+	// Number of parts into which output is divided
+	int threads () const;
+
+	// Write the nonzero entries of A as lines "i j a", adding offset to the indices
+	template <class Matrix>
+	std::ostream &writeEntries (std::ostream &os, const Matrix &A, size_t offset) const;
+
+	std::ostream &formatEntries (std::ostream &os,
+				     const std::vector<std::pair<size_t, size_t> > &indices,
+				     const std::vector<typename Ring::Element> &values,
+				     size_t offset) const;
+
+	// Format all rows of A with formatRow and write them to os in order
+	template <class Matrix>
+	std::ostream &writeRows (std::ostream &os, const Matrix &A,
+				 void (MatrixWriter::*formatRow) (OutputBuffer &, ElementFormatter<Ring> &, const Matrix &, size_t) const) const;
+
+	template <class Matrix>
+	void formatMapleRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const;
+
+	template <class Matrix>
+	void formatMatlabRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const;
+
+	template <class Matrix>
+	void formatSageRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const;
+
+	template <class Matrix>
+	void formatPrettyRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const;
+
 #ifdef __LELA_HAVE_LIBPNG
 	static void PNGWriteData (png_structp png_ptr, png_bytep data, png_size_t length);
 	static void PNGFlush (png_structp png_ptr);
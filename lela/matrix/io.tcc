@@ -18,6 +18,10 @@
 
 #include <regex.h>
 
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
 #include "lela/lela-config.h"
 #include "lela/util/error.h"
 #include "lela/util/commentator.h"
@@ -223,6 +227,8 @@ std::istream &MatrixReader<Ring>::readDumas (std::istream &is, Matrix &A) const
 	if (c != 'M')
 		throw InvalidMatrixInput ();
 
+	checkDims<Matrix> (m, n);
+
 	A.resize (m, n);
 
 	Context<Ring> ctx (_F);
@@ -463,47 +469,128 @@ std::ostream &MatrixWriter<Ring>::write (std::ostream &os, const Matrix &A, File
 	return os;
 }
 
+template <class Ring>
+int MatrixWriter<Ring>::threads () const
+{
+	if (_threads > 0)
+		return _threads;
+
+#ifdef _OPENMP
+	return omp_get_max_threads ();
+#else
+	return 1;
+#endif
+}
+
 template <class Ring>
 template <class Matrix>
-std::ostream &MatrixWriter<Ring>::writeTurner (std::ostream &os, const Matrix &A) const
+std::ostream &MatrixWriter<Ring>::writeEntries (std::ostream &os, const Matrix &A, size_t offset) const
 {
 	typename Matrix::ConstRawIterator i_elt;
 	typename Matrix::ConstRawIndexedIterator i_idx;
 
+	std::vector<std::pair<size_t, size_t> > indices;
+	std::vector<typename Ring::Element> values;
+
+	indices.reserve (entry_batch_size);
+	values.reserve (entry_batch_size);
+
 	for (i_idx = A.rawIndexedBegin (), i_elt = A.rawBegin (); i_idx != A.rawIndexedEnd (); ++i_idx, ++i_elt) {
 		if (!_F.isZero (*i_elt)) {
-			os << i_idx->first << ' ' << i_idx->second << ' ';
-			_F.write (os, *i_elt) << std::endl;
+			indices.push_back (std::pair<size_t, size_t> (i_idx->first, i_idx->second));
+			values.push_back (*i_elt);
+
+			if (indices.size () == entry_batch_size) {
+				formatEntries (os, indices, values, offset);
+				indices.clear ();
+				values.clear ();
+			}
 		}
 	}
 
-	os << "-1" << std::endl;
+	return formatEntries (os, indices, values, offset);
+}
+
+template <class Ring>
+std::ostream &MatrixWriter<Ring>::formatEntries (std::ostream &os,
+						 const std::vector<std::pair<size_t, size_t> > &indices,
+						 const std::vector<typename Ring::Element> &values,
+						 size_t offset) const
+{
+	long num_parts = std::min<long> (threads (), indices.size () / 1024 + 1);
+	std::vector<OutputBuffer> bufs (num_parts);
+
+#pragma omp parallel for schedule(static)
+	for (long p = 0; p < num_parts; ++p) {
+		ElementFormatter<Ring> fmt (_F);
+		OutputBuffer &buf = bufs[p];
+		size_t end = indices.size () * (p + 1) / num_parts;
+
+		for (size_t k = indices.size () * p / num_parts; k < end; ++k) {
+			buf.putUnsigned (indices[k].first + offset);
+			buf.put (' ');
+			buf.putUnsigned (indices[k].second + offset);
+			buf.put (' ');
+			fmt.format (buf, values[k]);
+			buf.put ('\n');
+		}
+	}
+
+	for (long p = 0; p < num_parts; ++p)
+		bufs[p].writeTo (os);
 
 	return os;
 }
 
 template <class Ring>
 template <class Matrix>
-std::ostream &MatrixWriter<Ring>::writeOneBased (std::ostream &os, const Matrix &A) const
+std::ostream &MatrixWriter<Ring>::writeRows (std::ostream &os, const Matrix &A,
+					     void (MatrixWriter::*formatRow) (OutputBuffer &, ElementFormatter<Ring> &, const Matrix &, size_t) const) const
 {
-	typename Matrix::ConstRawIterator i_elt;
-	typename Matrix::ConstRawIndexedIterator i_idx;
+	long num_parts = threads ();
+	std::vector<OutputBuffer> bufs (num_parts);
 
-	for (i_idx = A.rawIndexedBegin (), i_elt = A.rawBegin (); i_idx != A.rawIndexedEnd (); ++i_idx, ++i_elt) {
-		if (!_F.isZero (*i_elt)) {
-			os << i_idx->first + 1 << ' ' << i_idx->second + 1 << ' ';
-			_F.write (os, *i_elt) << std::endl;
+	for (size_t start = 0; start < A.rowdim (); start += row_batch_size * num_parts) {
+		size_t rows = std::min<size_t> (row_batch_size * num_parts, A.rowdim () - start);
+
+#pragma omp parallel for schedule(static)
+		for (long p = 0; p < num_parts; ++p) {
+			ElementFormatter<Ring> fmt (_F);
+			size_t end = start + rows * (p + 1) / num_parts;
+
+			for (size_t i = start + rows * p / num_parts; i < end; ++i)
+				(this->*formatRow) (bufs[p], fmt, A, i);
 		}
+
+		for (long p = 0; p < num_parts; ++p)
+			bufs[p].writeTo (os);
 	}
 
 	return os;
 }
 
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeTurner (std::ostream &os, const Matrix &A) const
+{
+	writeEntries (os, A, 0);
+	os << "-1" << std::endl;
+
+	return os;
+}
+
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeOneBased (std::ostream &os, const Matrix &A) const
+{
+	return writeEntries (os, A, 1);
+}
+
 template <class Ring>
 template <class Matrix>
 std::ostream &MatrixWriter<Ring>::writeDumas (std::ostream &os, const Matrix &A) const
 {
-	os << A.rowdim () << ' ' << A.coldim () << " M" << std::endl;
+	os << A.rowdim () << ' ' << A.coldim () << " M\n";
 	writeOneBased (os, A);
 	os << "0 0 0" << std::endl;
 	return os;
@@ -511,152 +598,160 @@ std::ostream &MatrixWriter<Ring>::writeDumas (std::ostream &os, const Matrix &A)
 
 template <class Ring>
 template <class Matrix>
-std::ostream &MatrixWriter<Ring>::writeMaple (std::ostream &os, const Matrix &A) const
+void MatrixWriter<Ring>::formatMapleRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const
 {
-	size_t i, j;
-
 	typename Ring::Element a;
 
+	buf.put ('[');
+
+	for (size_t j = 0; j < A.coldim (); ++j) {
+		if (A.getEntry (a, i, j))
+			fmt.format (buf, a);
+		else
+			buf.put ('0');
+
+		if (j < A.coldim () - 1)
+			buf.put (", ", 2);
+	}
+
+	if (i < A.rowdim () - 1)
+		buf.put ("], ", 3);
+	else
+		buf.put ("] ]\n", 4);
+}
+
+template <class Ring>
+template <class Matrix>
+std::ostream &MatrixWriter<Ring>::writeMaple (std::ostream &os, const Matrix &A) const
+{
 	if (A.rowdim () == 0) {
 		os << "[]";
 		return os;
 	}
 
 	os << "[ ";
+	writeRows (os, A, &MatrixWriter::template formatMapleRow<Matrix>);
 
-	for (i = 0; i < A.rowdim (); ++i) {
-		os << "[";
-
-		for (j = 0; j < A.coldim (); ++j) {
-			if (A.getEntry (a, i, j))
-				_F.write (os, a);
-			else
-				os << "0";
+	return os << std::flush;
+}
 
-			if (j < A.coldim () - 1)
-				os << ", ";
-		}
+template <class Ring>
+template <class Matrix>
+void MatrixWriter<Ring>::formatMatlabRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const
+{
+	typename Ring::Element a;
 
-		if (i < A.rowdim () - 1)
-			os << "], ";
+	for (size_t j = 0; j < A.coldim (); ++j) {
+		if (A.getEntry (a, i, j))
+			fmt.format (buf, a);
 		else
-			os << "] ]" << std::endl;
+			buf.put ('0');
+
+		if (j < A.coldim () - 1)
+			buf.put (", ", 2);
 	}
 
-	return os;
+	if (i < A.rowdim () - 1)
+		buf.put ("; ", 2);
 }
 
 template <class Ring>
 template <class Matrix>
 std::ostream &MatrixWriter<Ring>::writeMatlab (std::ostream &os, const Matrix &A) const
 {
-	size_t i, j;
-
-	typename Ring::Element a;
-
 	if (A.rowdim () == 0) {
 		os << "[]";
 		return os;
 	}
 
 	os << "[ ";
+	writeRows (os, A, &MatrixWriter::template formatMatlabRow<Matrix>);
+	os << "]" << std::endl;
 
-	for (i = 0; i < A.rowdim (); ++i) {
-		for (j = 0; j < A.coldim (); ++j) {
-			if (A.getEntry (a, i, j))
-				_F.write (os, a);
-			else
-				os << "0";
+	return os;
+}
 
-			if (j < A.coldim () - 1)
-				os << ", ";
-		}
+template <class Ring>
+template <class Matrix>
+void MatrixWriter<Ring>::formatSageRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const
+{
+	typename Ring::Element a;
 
-		if (i < A.rowdim () - 1)
-			os << "; ";
-	}
+	if (i == 0)
+		buf.put ("[ ", 2);
+	else
+		buf.put ("         [ ", 11);
 
-	os << "]" << std::endl;
+	for (size_t j = 0; j < A.coldim (); ++j) {
+		if (A.getEntry (a, i, j))
+			fmt.format (buf, a);
+		else
+			buf.put ('0');
 
-	return os;
+		if (j < A.coldim () - 1)
+			buf.put (", ", 2);
+	}
+
+	if (i < A.rowdim () - 1)
+		buf.put (" ],\n", 4);
+	else
+		buf.put (" ] ])\n", 6);
 }
 
 template <class Ring>
 template <class Matrix>
 std::ostream &MatrixWriter<Ring>::writeSage (std::ostream &os, const Matrix &A) const
 {
-	size_t i, j;
-
 	if (A.rowdim () == 0) {
 		os << "matrix([])" << std::endl;
 		return os;
 	}
 
 	os << "matrix([ ";
+	writeRows (os, A, &MatrixWriter::template formatSageRow<Matrix>);
+
+	return os << std::flush;
+}
+
+template <class Ring>
+template <class Matrix>
+void MatrixWriter<Ring>::formatPrettyRow (OutputBuffer &buf, ElementFormatter<Ring> &fmt, const Matrix &A, size_t i) const
+{
+	size_t col_width = _F.elementWidth ();
 
 	typename Ring::Element a;
 
-	for (i = 0; i < A.rowdim (); ++i) {
-		if (i == 0)
-			os << "[ ";
-		else
-			os << "         [ ";
+	buf.put ("  [ ", 4);
 
-		for (j = 0; j < A.coldim (); ++j) {
-			if (A.getEntry (a, i, j))
-				_F.write (os, a);
-			else
-				os << "0";
+	for (size_t j = 0; j < A.coldim (); ++j) {
+		if (!A.getEntry (a, i, j) || _F.isZero (a)) {
+			if (col_width > 1)
+				buf.put (' ', col_width - 1);
 
-			if (j < A.coldim () - 1)
-				os << ", ";
+			buf.put (". ", 2);
+		} else {
+			size_t start = buf.size ();
+			fmt.format (buf, a);
+			buf.justify (start, col_width);
+			buf.put (' ');
 		}
-
-		if (i < A.rowdim () - 1)
-			os << " ]," << std::endl;
-		else
-			os << " ] ])" << std::endl;
 	}
 
-	return os;
+	buf.put ("]\n", 2);
 }
 
 template <class Ring>
 template <class Matrix>
 std::ostream &MatrixWriter<Ring>::writePretty (std::ostream &os, const Matrix &A) const
 {
-	integer c;
-
-	unsigned col_width = _F.elementWidth ();
-
-	typename Ring::Element a;
-
-	size_t i, j;
-
 	if (A.rowdim () == 0 || A.coldim () == 0) {
 		os << "(empty " << A.rowdim () << "x" << A.coldim () << " matrix)" << std::endl;
 		return os;
 	}
 
-	for (i = 0; i < A.rowdim (); ++i) {
-		os << "  [ ";
-
-		for (j = 0; j < A.coldim (); ++j) {
-			if (!A.getEntry (a, i, j) || _F.isZero (a)) {
-				for (unsigned t = 0; t < col_width - 1; ++t)
-					os << ' ';
+	writeRows (os, A, &MatrixWriter::template formatPrettyRow<Matrix>);
 
-				os << ". ";
-			} else {
-				os.width (col_width);
-				_F.write (os, a) << " ";
-			}
-		}
-
-		os << "]" << std::endl;
-	}
-
-	return os;
+	return os << std::flush;
 }
 
 } // namespace LELA
@@ -0,0 +1,220 @@
+/* lela/matrix/profile.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Structural profile of a matrix: leading columns, row- and
+ * column-weights, and density-histograms
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_PROFILE_H
+#define __LELA_MATRIX_PROFILE_H
+
+#include <vector>
+#include <limits>
+
+#include "lela/blas/context.h"
+#include "lela/vector/traits.h"
+#include "lela/util/index.h"
+
+namespace LELA
+{
+
+/** Structural profile of a matrix
+ *
+ * Records, for each row, the column of its leading (leftmost)
+ * nonzero entry and its number of nonzero entries, for each column
+ * its number of nonzero entries, the lists of empty rows and columns,
+ * and histograms of the row- and column-weights. All of this is
+ * computed in a single pass over the matrix, split by rows over the
+ * available OpenMP-threads, so that algorithms which need several of
+ * these quantities need not each scan the matrix again. The splicer
+ * in @ref FaugereLachartre takes its pivot-rows from a profile, and
+ * Elimination hands the profile of a sparse input to the
+ * SparsePartialPivotStrategy, which uses it to cut its search short.
+ *
+ * The profile is a snapshot: it is not updated when the matrix
+ * changes. Note however that row-operations never introduce nonzero
+ * entries into a column which is zero, so the list of empty columns
+ * remains valid throughout elimination.
+ *
+ * The matrix must have row-iterators supporting random access.
+ *
+ * \ingroup matrix
+ */
+class MatrixProfile
+{
+public:
+	/// Column-index, or -1 for none
+	typedef DefaultIndexPolicy::SignedIndex SignedIndex;
+
+	/// Construct an empty profile
+	MatrixProfile () : _rowdim (0), _coldim (0), _nonzero (0) {}
+
+	/** Construct the profile of the matrix A
+	 *
+	 * Throws IndexOverflow if the leading columns of A cannot be
+	 * stored in a SignedIndex, i.e. if A has 2^31 or more columns
+	 * under the narrow index-policy.
+	 *
+	 * @param ctx Context-object
+	 * @param A Matrix to be profiled
+	 */
+	template <class Ring, class Modules, class Matrix>
+	MatrixProfile (Context<Ring, Modules> &ctx, const Matrix &A)
+		{ compute (ctx, A); }
+
+	/** Recompute the profile for the matrix A
+	 *
+	 * @param ctx Context-object
+	 * @param A Matrix to be profiled
+	 * @returns Reference to this profile
+	 */
+	template <class Ring, class Modules, class Matrix>
+	MatrixProfile &compute (Context<Ring, Modules> &ctx, const Matrix &A);
+
+	/// Row-dimension of the profiled matrix
+	size_t rowdim () const { return _rowdim; }
+
+	/// Column-dimension of the profiled matrix
+	size_t coldim () const { return _coldim; }
+
+	/// Total number of nonzero entries
+	size_t nonzero () const { return _nonzero; }
+
+	/// Proportion of entries which are nonzero
+	double density () const
+		{ return (_rowdim == 0 || _coldim == 0) ? 0.0 : (double) _nonzero / ((double) _rowdim * (double) _coldim); }
+
+	/// Column of the leading entry of row i, or -1 if the row is zero
+	SignedIndex leadingColumn (size_t i) const { return _leading_column[i]; }
+
+	/// Number of nonzero entries in row i
+	size_t rowWeight (size_t i) const { return _row_weight[i]; }
+
+	/// Number of nonzero entries in column j
+	size_t columnWeight (size_t j) const { return _column_weight[j]; }
+
+	/// Leading columns of all rows, -1 for rows which are zero
+	const std::vector<SignedIndex> &leadingColumns () const { return _leading_column; }
+
+	/// Weights of all rows
+	const std::vector<size_t> &rowWeights () const { return _row_weight; }
+
+	/// Weights of all columns
+	const std::vector<size_t> &columnWeights () const { return _column_weight; }
+
+	/// Indices of zero rows, in increasing order
+	const std::vector<size_t> &emptyRows () const { return _empty_rows; }
+
+	/// Indices of zero columns, in increasing order
+	const std::vector<size_t> &emptyColumns () const { return _empty_columns; }
+
+	/// First column at or after j which is not zero, or coldim () if there is none
+	size_t nextNonemptyColumn (size_t j) const
+	{
+		while (j < _coldim && _column_weight[j] == 0)
+			++j;
+
+		return j;
+	}
+
+	/** Histogram of row-weights
+	 *
+	 * Entry 0 is the number of zero rows; entry b > 0 is the number
+	 * of rows with at least 2^(b-1) and fewer than 2^b nonzero
+	 * entries. Use @ref histogramBucket to find the entry for a given
+	 * weight.
+	 */
+	const std::vector<size_t> &rowHistogram () const { return _row_histogram; }
+
+	/// Histogram of column-weights, with buckets as in @ref rowHistogram
+	const std::vector<size_t> &columnHistogram () const { return _column_histogram; }
+
+	/// Index of the histogram-bucket containing the given weight
+	static size_t histogramBucket (size_t weight)
+	{
+		size_t b = 0;
+
+		while (weight > 0) {
+			weight >>= 1;
+			++b;
+		}
+
+		return b;
+	}
+
+private:
+	// Minimal number of rows handled by each thread
+	static const size_t min_rows_per_thread = 64;
+
+	// Number of threads among which the rows are divided
+	static long threads ();
+
+	template <class Ring, class Vector>
+	static void profileRow (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight)
+		{ profileRow_spec (R, v, column_weight, lead, weight, typename VectorTraits<Ring, Vector>::RepresentationType ()); }
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Dense);
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Sparse);
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Dense01);
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Sparse01);
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Hybrid01);
+
+	template <class Ring, class Vector>
+	static void profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Adaptive);
+
+	// Add the bits of the word w, whose first bit is at column
+	// offset, to the profile of a row
+	template <class Endianness, class word>
+	static void profileWord (word w, size_t offset, size_t *column_weight, SignedIndex &lead, size_t &weight);
+
+	static void fillHistogram (std::vector<size_t> &histogram, const std::vector<size_t> &weights);
+
+	size_t _rowdim;
+	size_t _coldim;
+	size_t _nonzero;
+
+	std::vector<SignedIndex> _leading_column;
+	std::vector<size_t> _row_weight;
+	std::vector<size_t> _column_weight;
+	std::vector<size_t> _empty_rows;
+	std::vector<size_t> _empty_columns;
+	std::vector<size_t> _row_histogram;
+	std::vector<size_t> _column_histogram;
+};
+
+} // namespace LELA
+
+#include "lela/matrix/profile.tcc"
+
+#endif // __LELA_MATRIX_PROFILE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,231 @@
+/* lela/matrix/profile.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Structural profile of a matrix: leading columns, row- and
+ * column-weights, and density-histograms
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_PROFILE_TCC
+#define __LELA_MATRIX_PROFILE_TCC
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+#include "lela/matrix/profile.h"
+#include "lela/vector/bit-iterator.h"
+
+namespace LELA
+{
+
+inline long MatrixProfile::threads ()
+{
+#ifdef _OPENMP
+	return omp_get_max_threads ();
+#else
+	return 1;
+#endif
+}
+
+template <class Ring, class Modules, class Matrix>
+MatrixProfile &MatrixProfile::compute (Context<Ring, Modules> &ctx, const Matrix &A)
+{
+	if (A.coldim () > (size_t) std::numeric_limits<SignedIndex>::max ())
+		throw IndexOverflow ("Column-dimension exceeds capacity of leading columns");
+
+	_rowdim = A.rowdim ();
+	_coldim = A.coldim ();
+
+	_leading_column.assign (_rowdim, -1);
+	_row_weight.assign (_rowdim, 0);
+	_column_weight.assign (_coldim, 0);
+
+	long num_parts = std::min<long> (threads (), _rowdim / min_rows_per_thread + 1);
+
+	// Each thread counts column-weights in its own buffer; the
+	// first thread uses _column_weight directly
+	std::vector<std::vector<size_t> > column_weights (num_parts - 1, std::vector<size_t> (_coldim, 0));
+
+#pragma omp parallel for schedule(static)
+	for (long p = 0; p < num_parts; ++p) {
+		size_t *column_weight = (_coldim == 0) ? NULL : (p == 0) ? &_column_weight[0] : &column_weights[p - 1][0];
+		size_t start = _rowdim * p / num_parts, end = _rowdim * (p + 1) / num_parts;
+
+		typename Matrix::ConstRowIterator i = A.rowBegin () + start;
+
+		for (size_t k = start; k < end; ++k, ++i)
+			profileRow (ctx.F, *i, column_weight, _leading_column[k], _row_weight[k]);
+	}
+
+	for (long p = 1; p < num_parts; ++p)
+		for (size_t j = 0; j < _coldim; ++j)
+			_column_weight[j] += column_weights[p - 1][j];
+
+	_nonzero = 0;
+	_empty_rows.clear ();
+	_empty_columns.clear ();
+
+	for (size_t k = 0; k < _rowdim; ++k) {
+		_nonzero += _row_weight[k];
+
+		if (_row_weight[k] == 0)
+			_empty_rows.push_back (k);
+	}
+
+	for (size_t j = 0; j < _coldim; ++j)
+		if (_column_weight[j] == 0)
+			_empty_columns.push_back (j);
+
+	fillHistogram (_row_histogram, _row_weight);
+	fillHistogram (_column_histogram, _column_weight);
+
+	return *this;
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Dense)
+{
+	typename Vector::const_iterator j;
+	size_t col;
+
+	for (j = v.begin (), col = 0; j != v.end (); ++j, ++col) {
+		if (!R.isZero (*j)) {
+			if (lead == -1)
+				lead = col;
+
+			++weight;
+			++column_weight[col];
+		}
+	}
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Sparse)
+{
+	typename Vector::const_iterator j;
+
+	for (j = v.begin (); j != v.end (); ++j) {
+		if (!R.isZero (j->second)) {
+			if (lead == -1)
+				lead = j->first;
+
+			++weight;
+			++column_weight[j->first];
+		}
+	}
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Dense01)
+{
+	typename Vector::const_word_iterator j;
+	size_t idx;
+
+	for (j = v.word_begin (), idx = 0; j != v.word_end (); ++j, ++idx)
+		if (*j)
+			profileWord<typename Vector::Endianness, typename Vector::word_type> (*j, idx << WordTraits<typename Vector::word_type>::logof_size, column_weight, lead, weight);
+
+	if (v.back_word ())
+		profileWord<typename Vector::Endianness, typename Vector::word_type> (v.back_word (), idx << WordTraits<typename Vector::word_type>::logof_size, column_weight, lead, weight);
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Sparse01)
+{
+	typename Vector::const_iterator j;
+
+	if (!v.empty ())
+		lead = v.front ();
+
+	for (j = v.begin (); j != v.end (); ++j)
+		++column_weight[*j];
+
+	weight = v.size ();
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Hybrid01)
+{
+	typename Vector::const_iterator j;
+
+	for (j = v.begin (); j != v.end (); ++j)
+		profileWord<typename Vector::Endianness, typename Vector::word_type> (j->second, (size_t) j->first << WordTraits<typename Vector::word_type>::logof_size, column_weight, lead, weight);
+}
+
+template <class Ring, class Vector>
+void MatrixProfile::profileRow_spec (const Ring &R, const Vector &v, size_t *column_weight, SignedIndex &lead, size_t &weight,
+				     VectorRepresentationTypes::Adaptive)
+{
+	switch (v.kind ()) {
+	case Vector::SPARSE:
+		profileRow (R, v.sparse (), column_weight, lead, weight);
+		break;
+
+	case Vector::HYBRID:
+		profileRow (R, v.hybrid (), column_weight, lead, weight);
+		break;
+
+	default:
+		profileRow (R, v.dense (), column_weight, lead, weight);
+	}
+}
+
+template <class Endianness, class word>
+void MatrixProfile::profileWord (word w, size_t offset, size_t *column_weight, SignedIndex &lead, size_t &weight)
+{
+	for (size_t k = 0; w != 0 && k < WordTraits<word>::bits; ++k) {
+		word t = Endianness::e_j (k);
+
+		if (w & t) {
+			if (lead == -1)
+				lead = offset + k;
+
+			++weight;
+			++column_weight[offset + k];
+			w &= ~t;
+		}
+	}
+}
+
+inline void MatrixProfile::fillHistogram (std::vector<size_t> &histogram, const std::vector<size_t> &weights)
+{
+	std::vector<size_t>::const_iterator i;
+
+	histogram.clear ();
+
+	for (i = weights.begin (); i != weights.end (); ++i) {
+		size_t b = histogramBucket (*i);
+
+		if (b >= histogram.size ())
+			histogram.resize (b + 1, 0);
+
+		++histogram[b];
+	}
+}
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_PROFILE_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -322,7 +322,7 @@ class MatrixRawIterator<Iterator, VectorRepresentationTypes::Hybrid01>
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.second = _iter->first << WordTraits<typename Vector::word_type>::logof_size;
+			_pos.second = (size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size;
 		}
 	}
 
@@ -355,7 +355,7 @@ class MatrixRawIterator<Iterator, VectorRepresentationTypes::Hybrid01>
 			if (_iter == _rowcol->end ())
 				advance_rowcol ();
 			else
-				_pos.second = _iter->first << WordTraits<typename Vector::word_type>::logof_size;
+				_pos.second = (size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size;
 		}
 
 		return *this;
@@ -394,7 +394,7 @@ class MatrixRawIterator<Iterator, VectorRepresentationTypes::Hybrid01>
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.second = _iter->first << WordTraits<typename Vector::word_type>::logof_size;
+			_pos.second = (size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size;
 		}
 	}
 };
@@ -871,7 +871,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, fa
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.second = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+			_pos.second = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 	}
 
@@ -904,7 +904,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, fa
 			if (_iter == _rowcol->end ()) {
 				advance_rowcol ();
 			} else
-				_pos.second = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+				_pos.second = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 
 		return *this;
@@ -948,7 +948,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, fa
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.second = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+			_pos.second = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 	}
 };
@@ -975,7 +975,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, tr
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.first = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+			_pos.first = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 	}
 
@@ -1008,7 +1008,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, tr
 			if (_iter == _rowcol->end ()) {
 				advance_rowcol ();
 			} else
-				_pos.first = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+				_pos.first = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 
 		return *this;
@@ -1052,7 +1052,7 @@ class MatrixRawIndexedIterator<Iterator, VectorRepresentationTypes::Hybrid01, tr
 
 		if (_rowcol != _rowcol_end) {
 			_iter = _rowcol->begin ();
-			_pos.first = (_iter->first << WordTraits<typename Vector::word_type>::logof_size);
+			_pos.first = ((size_t) _iter->first << WordTraits<typename Vector::word_type>::logof_size);
 		}
 	}
 };
@@ -0,0 +1,137 @@
+/* lela/matrix/sparse-adaptive.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Specialisation of SparseMatrix for rows of adaptive representation
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_SPARSE_ADAPTIVE_H
+#define __LELA_MATRIX_SPARSE_ADAPTIVE_H
+
+#include <vector>
+
+#include "lela/matrix/sparse.h"
+#include "lela/vector/adaptive.h"
+
+namespace LELA {
+
+/* Specialization for adaptive vectors
+ *
+ * Each row chooses its own representation (see @ref AdaptiveVector),
+ * so that rows which fill in during elimination become dense while
+ * the rest of the matrix stays sparse. Submatrices and raw iterators
+ * are not supported, since adaptive vectors do not have subvectors.
+ *
+ * setEntry writes into the current representation of the row; the
+ * row is promoted to a denser representation at the next level 1
+ * BLAS operation which writes to it.
+ */
+
+template <class _Element, class _Row>
+class SparseMatrix<_Element, _Row, VectorRepresentationTypes::Adaptive>
+{
+public:
+
+	typedef _Element Element;
+	typedef _Row Row;
+	typedef SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive> Self_t;
+	typedef const Row ConstRow;
+	typedef std::vector<Row> Rep;
+	typedef MatrixIteratorTypes::Row IteratorType;
+	typedef MatrixStorageTypes::Rows StorageType;
+
+	typedef Self_t ContainerType;
+
+	SparseMatrix () : _m (0), _n (0) {}
+	SparseMatrix (size_t m, size_t n)
+		: _A (m, Row (n)), _m (m), _n (n) {}
+	SparseMatrix (const SparseMatrix &A)
+		: _A (A._A), _m (A._m), _n (A._n) {}
+
+	~SparseMatrix () {}
+
+	size_t rowdim () const { return _m; }
+	size_t coldim () const { return _n; }
+
+	void resize (size_t m, size_t n)
+	{
+		_m = m; _n = n;
+		_A.resize (m, Row (n));
+
+		for (typename Rep::iterator i = _A.begin (); i != _A.end (); ++i)
+			i->resize (n);
+	}
+
+	void setEntry (size_t i, size_t j, const Element &value)
+		{ setEntry_spec (_A[i], j, value); }
+	bool getEntry (Element &x, size_t i, size_t j) const
+		{ return VectorUtils::getEntry (_A[i], x, j); }
+
+	typedef typename Rep::iterator RowIterator;
+	typedef typename Rep::const_iterator ConstRowIterator;
+
+	RowIterator      rowBegin ()       { return _A.begin (); }
+	ConstRowIterator rowBegin () const { return _A.begin (); }
+	RowIterator      rowEnd ()         { return _A.end (); }
+	ConstRowIterator rowEnd () const   { return _A.end (); }
+
+	Row &getRow (size_t i) { return _A[i]; }
+	Row &operator [] (size_t i) { return _A[i]; }
+	ConstRow &operator [] (size_t i) const { return _A[i]; }
+
+	/** Number of rows currently of each representation
+	 *
+	 * @param sparse Set to the number of sparse rows
+	 * @param hybrid Set to the number of hybrid rows
+	 * @param dense Set to the number of dense rows
+	 */
+	void countKinds (size_t &sparse, size_t &hybrid, size_t &dense) const;
+
+protected:
+
+	static void setEntry_spec (Row &v, size_t j, const Element &value);
+
+	template <class Vector>
+	static void setEntry_spec (Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Dense)
+		{ v[j] = value; }
+
+	template <class Vector>
+	static void setEntry_spec (Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Dense01)
+		{ v[j] = value; }
+
+	template <class Vector>
+	static void setEntry_spec (Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Sparse);
+
+	template <class Vector>
+	static void setEntry_spec (Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Sparse01);
+
+	template <class Vector>
+	static void setEntry_spec (Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Hybrid01);
+
+	Rep               _A;
+	size_t            _m;
+	size_t            _n;
+
+	template<class F, class R, class T> friend class SparseMatrix;
+};
+
+} // namespace LELA
+
+#include "lela/matrix/sparse-adaptive.tcc"
+
+#endif // __LELA_MATRIX_SPARSE_ADAPTIVE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,123 @@
+/* lela/matrix/sparse-adaptive.tcc
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Specialisation of SparseMatrix for rows of adaptive representation
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_MATRIX_SPARSE_ADAPTIVE_TCC
+#define __LELA_MATRIX_SPARSE_ADAPTIVE_TCC
+
+#include <algorithm>
+
+#include "lela/matrix/sparse-adaptive.h"
+#include "lela/vector/bit-iterator.h"
+
+namespace LELA
+{
+
+template <class Element, class Row>
+void SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive>::setEntry_spec (Row &v, size_t j, const Element &value)
+{
+	switch (v.kind ()) {
+	case Row::SPARSE:
+		setEntry_spec (v.sparse (), j, value, typename ElementVectorTraits<Element, typename Row::Sparse>::RepresentationType ());
+		break;
+
+	case Row::HYBRID:
+		setEntry_spec (v.hybrid (), j, value, typename ElementVectorTraits<Element, typename Row::Hybrid>::RepresentationType ());
+		break;
+
+	default:
+		setEntry_spec (v.dense (), j, value, typename ElementVectorTraits<Element, typename Row::Dense>::RepresentationType ());
+	}
+}
+
+template <class Element, class Row>
+template <class Vector>
+void SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive>::setEntry_spec
+	(Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Sparse)
+{
+	typedef typename Vector::value_type value_type;
+	typename Vector::iterator iter;
+
+	iter = std::lower_bound (v.begin (), v.end (), j, VectorUtils::FindSparseEntryLB ());
+
+	if (iter == v.end () || iter->first != j)
+		v.insert (iter, value_type (j, value));
+	else
+		iter->second = value;
+}
+
+template <class Element, class Row>
+template <class Vector>
+void SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive>::setEntry_spec
+	(Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Sparse01)
+{
+	typename Vector::iterator iter = std::lower_bound (v.begin (), v.end (), j);
+
+	if (value && (iter == v.end () || *iter != j))
+		v.insert (iter, j);
+	else if (!value && iter != v.end () && *iter == j)
+		v.erase (iter);
+}
+
+template <class Element, class Row>
+template <class Vector>
+void SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive>::setEntry_spec
+	(Vector &v, size_t j, const Element &value, VectorRepresentationTypes::Hybrid01)
+{
+	typename Vector::iterator it;
+
+	typename Vector::word_type m = Vector::Endianness::e_j (j & WordTraits<typename Vector::word_type>::pos_mask);
+
+	it = std::lower_bound (v.begin (), v.end (), j >> WordTraits<typename Vector::word_type>::logof_size, VectorUtils::FindSparseEntryLB ());
+
+	if (it == v.end () || it->first != (j >> WordTraits<typename Vector::word_type>::logof_size)) {
+		if (value)
+			v.insert (it, typename Vector::value_type (j >> WordTraits<typename Vector::word_type>::logof_size, m));
+	}
+	else {
+		if (value)
+			it->second |= m;
+		else {
+			it->second &= ~m;
+
+			if (!it->second)
+				v.erase (it);
+		}
+	}
+}
+
+template <class Element, class Row>
+void SparseMatrix<Element, Row, VectorRepresentationTypes::Adaptive>::countKinds (size_t &sparse, size_t &hybrid, size_t &dense) const
+{
+	sparse = hybrid = dense = 0;
+
+	for (ConstRowIterator i = rowBegin (); i != rowEnd (); ++i) {
+		switch (i->kind ()) {
+		case Row::SPARSE: ++sparse; break;
+		case Row::HYBRID: ++hybrid; break;
+		default:          ++dense;
+		}
+	}
+}
+
+} // namespace LELA
+
+#endif // __LELA_MATRIX_SPARSE_ADAPTIVE_TCC
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -277,6 +277,7 @@ class SparseMatrix<_Element, _Row, VectorRepresentationTypes::Sparse>
 #include "lela/matrix/sparse.tcc"
 
 #include "lela/matrix/sparse-zero-one.h"
+#include "lela/matrix/sparse-adaptive.h"
 
 #endif // __LELA_MATRIX_SPARSE_H
 
@@ -91,7 +91,7 @@ template <class Vector>
 Vector &SparseMatrix<Element, Row, VectorRepresentationTypes::Sparse>
 	::columnDensity (Vector &v) const
 {
-	unsigned int row = 0;
+	size_t row = 0;
 
 	for (ConstRowIterator i = rowBegin (); i != rowEnd (); ++i, ++row) {
 		typename Row::const_iterator j = i.begin ();
@@ -109,7 +109,7 @@ SparseMatrix<Element, Row, VectorRepresentationTypes::Sparse>
 {
 	typename Row::const_iterator j;
 
-	unsigned int row = 0;
+	size_t row = 0;
 
 	for (ConstRowIterator i = rowBegin (); i != rowEnd (); ++i, ++row)
 		for (j = i->begin (); j != i->end (); ++j)
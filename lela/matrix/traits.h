@@ -12,6 +12,8 @@
 #ifndef __LELA_MATRIX_TRAITS_H
 #define __LELA_MATRIX_TRAITS_H
 
+#include "lela/vector/traits.h"
+
 namespace LELA
 {
 
@@ -85,6 +87,51 @@ namespace MatrixStorageTypes
 	struct M4RITranspose : public Generic {};
 }
 
+/** Whether vectors and matrices over Ring store all their entries
+ *
+ * A vector is dense if its representation is
+ * VectorRepresentationTypes::Dense or Dense01, and a matrix is dense
+ * if its rows, or its columns if it has no row-iterators, are dense.
+ * Modules use this to hand only dense operands to kernels which
+ * require them and to leave the others to their parent-module.
+ *
+ * \ingroup matrix
+ */
+template <class Ring>
+struct DenseRepresentation
+{
+	static bool isDenseRep (VectorRepresentationTypes::Generic) { return false; }
+	static bool isDenseRep (VectorRepresentationTypes::Dense) { return true; }
+	static bool isDenseRep (VectorRepresentationTypes::Dense01) { return true; }
+
+	/// Whether the vector v is dense
+	template <class Vector>
+	static bool isDenseVector (const Vector &)
+		{ return isDenseRep (typename VectorTraits<Ring, Vector>::RepresentationType ()); }
+
+	/// Whether the matrix A is dense
+	template <class Matrix>
+	static bool isDense (const Matrix &A)
+		{ return isDense (A, typename Matrix::IteratorType ()); }
+
+private:
+	template <class Matrix>
+	static bool isDense (const Matrix &, MatrixIteratorTypes::Generic)
+		{ return false; }
+
+	template <class Matrix>
+	static bool isDense (const Matrix &, MatrixIteratorTypes::Row)
+		{ return isDenseRep (typename VectorTraits<Ring, typename Matrix::Row>::RepresentationType ()); }
+
+	template <class Matrix>
+	static bool isDense (const Matrix &, MatrixIteratorTypes::Col)
+		{ return isDenseRep (typename VectorTraits<Ring, typename Matrix::Col>::RepresentationType ()); }
+
+	template <class Matrix>
+	static bool isDense (const Matrix &A, MatrixIteratorTypes::RowCol)
+		{ return isDense (A, MatrixIteratorTypes::Row ()); }
+};
+
 } // namespace LELA
 
 #endif // __LELA_MATRIX_TRAITS_H
@@ -46,12 +46,16 @@ class GF2RandIter
 	GF2RandIter (const GF2 &, 
 		     const integer &  = 0 , 
 		     const integer &seed = 0)
+		: _seed (seed.get_si ())
 	{
-		long _seed = seed.get_si ();
 		MT.setSeed (_seed);
 	}
 
-	GF2RandIter (const GF2RandIter &) {}
+	GF2RandIter (const GF2RandIter &r)
+		: _seed (r._seed)
+	{
+		MT.setSeed (_seed);
+	}
 
 	/** Destructor.
 	 * This destructs the random field element generator object.
@@ -62,8 +66,15 @@ class GF2RandIter
 	 * Assigns ModularRandIter object R to generator.
 	 * @param  R ModularRandIter object.
 	 */
-	GF2RandIter &operator = (const GF2RandIter &)
-		{ return *this; }
+	GF2RandIter &operator = (const GF2RandIter &r)
+	{
+		if (this != &r) {
+			_seed = r._seed;
+			MT.setSeed (_seed);
+		}
+
+		return *this;
+	}
  
 	/** Random field element creator.
 	 * This returns a random field element from the information supplied
@@ -103,6 +114,9 @@ class GF2RandIter
 
 	MersenneTwister MT;
 
+	/// Seed, so that copies produce the same sequence
+	long _seed;
+
 }; // class GF2RandIter
 
 } // namespace LELA 
@@ -61,7 +61,7 @@ public:
 	}
 
 	ModularRandIter (const ModularRandIter<Element> &R) 
-		: _F (R._F), _size (R._size), _seed (R._seed) {}
+		: _MT (R._seed), _F (R._F), _size (R._size), _seed (R._seed) {}
 
 	~ModularRandIter () {}
     
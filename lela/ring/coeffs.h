@@ -258,7 +258,7 @@ class CoeffDomain
      * cardinality, and 0 to signify a ring of infinite
      * cardinality.
      */
-    virtual int &cardinality (int &c) const
+    int &cardinality (int &c) const
     {
       return characteristic(c); // TODO: Overwrite it in speciall cases...?
     }
@@ -465,6 +465,18 @@ class CoeffDomain
       
     }
 
+    /** \brief Multiplicative inverse of a sequence of elements.
+     *
+     * Sets x[i] to the inverse of y[i] for each i in [0, y_end - y_begin).
+     *
+     * @return true if all elements are invertible, false if not
+     */
+    template <class Iterator1, class Iterator2>
+    bool invBatch (Iterator1 x, Iterator2 y_begin, Iterator2 y_end) const
+    {
+      return LELA::invEach (*this, x, y_begin, y_end);
+    }
+
     /** \brief Ring element AXPY, r  <-- a * x + y.
      *
      * This function assumes all ring elements have already been 
@@ -811,7 +823,7 @@ class CoeffDomain
      * This can be used to format the output of a matrix in a
      * readable way.
      */
-    virtual size_t elementWidth () const
+    size_t elementWidth () const
         { LELA::integer c; return (cardinality (c) == 0) ? 10 : (size_t) ceil (log (c.get_d ()) / M_LN10); }
     
 
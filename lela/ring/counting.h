@@ -0,0 +1,476 @@
+/* lela/ring/counting.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Ring-adaptor which counts arithmetic-operations
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_RING_COUNTING_H
+#define __LELA_RING_COUNTING_H
+
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+#include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/ring/interface.h"
+#include "lela/util/property.h"
+#include "lela/util/commentator.h"
+#include "lela/util/atomic.h"
+#include "lela/blas/context.h"
+#include "lela/vector/traits.h"
+#include "lela/matrix/traits.h"
+
+// When DISABLE_OPERATION_COUNTS is defined, CountingRing only
+// forwards operations to the underlying ring and counts nothing
+#ifndef DISABLE_OPERATION_COUNTS
+#  define COUNT_OPERATION(kind) _counter->count (&OperationCounts::kind)
+#else
+#  define COUNT_OPERATION(kind)
+#endif
+
+namespace LELA
+{
+
+/** Numbers of arithmetic-operations done in a ring
+ *
+ * \ingroup ring
+ */
+struct OperationCounts
+{
+	/// Additions, subtractions, and negations
+	unsigned long long adds;
+
+	/// Multiplications, including those in axpy and div
+	unsigned long long muls;
+
+	/// Inversions, including those in div
+	unsigned long long invs;
+
+	/// Initialisations of elements from integers or floating
+	/// point numbers, each of which reduces the input into the ring
+	unsigned long long reductions;
+
+	/// Copies of elements
+	unsigned long long copies;
+
+	/// Elements returned by zero (), one (), and minusOne ()
+	unsigned long long constants;
+
+	OperationCounts () : adds (0), muls (0), invs (0), reductions (0), copies (0), constants (0) {}
+
+	OperationCounts &operator += (const OperationCounts &c)
+	{
+		adds += c.adds; muls += c.muls; invs += c.invs;
+		reductions += c.reductions; copies += c.copies; constants += c.constants;
+		return *this;
+	}
+
+	OperationCounts &operator -= (const OperationCounts &c)
+	{
+		adds -= c.adds; muls -= c.muls; invs -= c.invs;
+		reductions -= c.reductions; copies -= c.copies; constants -= c.constants;
+		return *this;
+	}
+};
+
+inline std::ostream &operator << (std::ostream &os, const OperationCounts &c)
+{
+	return os << "adds: " << c.adds << ", muls: " << c.muls << ", invs: " << c.invs
+		  << ", reductions: " << c.reductions << ", copies: " << c.copies
+		  << ", constants: " << c.constants;
+}
+
+/** Per-thread counters of arithmetic-operations
+ *
+ * Each thread which counts operations is given an index on its first
+ * count, which it keeps for its lifetime. The threads with the first
+ * numThreads () indices increment their own counts, so that they
+ * need no synchronisation; all further threads, e.g. those of nested
+ * parallel regions or of an @ref Executor, share one set of counts
+ * which they update atomically. The counts are therefore exact
+ * however many threads count operations.
+ *
+ * \ingroup ring
+ */
+class OperationCounter
+{
+	// Pad the counts of each thread to its own cache-line
+	struct PaddedCounts
+	{
+		OperationCounts c;
+		char pad[64 - sizeof (OperationCounts) % 64];
+	};
+
+	std::vector<PaddedCounts> _counts;
+	OperationCounts _shared;
+	OperationCounts _reported;
+
+	static size_t counterThreads ()
+	{
+#ifdef _OPENMP
+		return omp_get_max_threads ();
+#else
+		return 1;
+#endif
+	}
+
+	// Index of the calling thread, assigned on its first call
+	static size_t threadIndex ()
+	{
+		static size_t next_index = 0;
+		static __thread size_t index = (size_t) -1;
+
+		if (index == (size_t) -1)
+			index = Atomic::fetchAdd (next_index, (size_t) 1);
+
+		return index;
+	}
+
+	static void addShared (OperationCounts &s, const OperationCounts &c)
+	{
+		Atomic::fetchAdd (s.adds, c.adds);
+		Atomic::fetchAdd (s.muls, c.muls);
+		Atomic::fetchAdd (s.invs, c.invs);
+		Atomic::fetchAdd (s.reductions, c.reductions);
+		Atomic::fetchAdd (s.copies, c.copies);
+		Atomic::fetchAdd (s.constants, c.constants);
+	}
+
+    public:
+	OperationCounter () : _counts (counterThreads ()) {}
+
+	/// Add n operations of the given kind, e.g. &OperationCounts::muls, to the counts of the calling thread
+	void count (unsigned long long OperationCounts::*kind, unsigned long long n = 1)
+	{
+		size_t i = threadIndex ();
+
+		if (i < _counts.size ())
+			_counts[i].c.*kind += n;
+		else
+			Atomic::fetchAdd (_shared.*kind, n);
+	}
+
+	/// Add the counts c to those of the calling thread
+	void count (const OperationCounts &c)
+	{
+		size_t i = threadIndex ();
+
+		if (i < _counts.size ())
+			_counts[i].c += c;
+		else
+			addShared (_shared, c);
+	}
+
+	/// Number of threads which have counts of their own
+	size_t numThreads () const { return _counts.size (); }
+
+	/// Counts of the thread with index i
+	const OperationCounts &thread (size_t i) const { return _counts[i].c; }
+
+	/// Counts shared by the threads without counts of their own
+	const OperationCounts &shared () const { return _shared; }
+
+	/// Sum of the counts of all threads. Must not be called while operations are counted.
+	OperationCounts total () const
+	{
+		OperationCounts t = _shared;
+
+		for (std::vector<PaddedCounts>::const_iterator i = _counts.begin (); i != _counts.end (); ++i)
+			t += i->c;
+
+		return t;
+	}
+
+	/// Set all counts to zero. Must not be called while operations are counted.
+	void reset ()
+	{
+		for (std::vector<PaddedCounts>::iterator i = _counts.begin (); i != _counts.end (); ++i)
+			i->c = OperationCounts ();
+
+		_shared = OperationCounts ();
+		_reported = OperationCounts ();
+	}
+
+	/** Report the operations counted since the last report to the
+	 * commentator
+	 *
+	 * Must not be called inside a parallel region.
+	 *
+	 * @param phase Name of the phase of the computation in which the
+	 * operations were done
+	 */
+	void report (const char *phase)
+	{
+		OperationCounts t = total (), d = t;
+
+		d -= _reported;
+		_reported = t;
+
+		commentator.report (Commentator::LEVEL_NORMAL, TIMING_MEASURE)
+			<< "Operations in " << phase << ": " << d << std::endl;
+	}
+};
+
+/** Ring-adaptor which counts arithmetic-operations
+ *
+ * Forwards every operation to the ring Ring, counting it in an @ref
+ * OperationCounter. Elements, and so vectors and matrices, are those
+ * of Ring. This permits algorithms to be compared by the numbers of
+ * operations they do rather than by their running-times.
+ *
+ * The BLAS over this ring use CountingModule, which passes
+ * matrix-multiplication, triangular products and solves, and
+ * matrix-vector products on dense operands to the modules of Ring,
+ * so that these take the same path as over Ring itself. Since those
+ * modules work directly on the representation of elements, their
+ * operations cannot be counted one by one; instead the number of
+ * operations of the classical algorithm is counted for each call.
+ * All other operations are done by the generic modules over this
+ * ring, which count every operation exactly. Ring must be served by
+ * the generic modules, so GF2 is not supported.
+ *
+ * Algorithms call @ref reportOperationCounts at the end of each of
+ * their phases, which for this ring reports the operations counted
+ * in that phase to the commentator.
+ *
+ * \ingroup ring
+ */
+template <class Ring>
+class CountingRing : public RingBase<typename Ring::Element, CountingRing<Ring> >
+{
+	Ring _F;
+	OperationCounter *_counter;
+
+    public:
+	typedef typename Ring::Element Element;
+
+	/// Random iterator, forwarding to that of Ring
+	class RandIter
+	{
+		typename Ring::RandIter _r;
+
+	    public:
+		RandIter (const CountingRing &F, const integer &size = 0, const integer &seed = 0)
+			: _r (F._F, size, seed) {}
+
+		Element &random (Element &x) const
+			{ return _r.random (x); }
+	};
+
+	/** Constructor
+	 *
+	 * @param F Ring to be wrapped
+	 * @param counter Counter in which to count operations; must
+	 * outlive this ring and all copies of it
+	 */
+	CountingRing (const Ring &F, OperationCounter &counter) : _F (F), _counter (&counter) {}
+
+	CountingRing (const CountingRing &F) : _F (F._F), _counter (F._counter) {}
+
+	/// Underlying ring
+	const Ring &ring () const { return _F; }
+
+	/// Counter in which operations are counted
+	OperationCounter &counter () const { return *_counter; }
+
+	template <class T>
+	Element &init (Element &x, const T &y) const
+		{ COUNT_OPERATION (reductions); return _F.init (x, y); }
+
+	template <class Iterator, class Accessor, class T>
+	Element &init (Property<Iterator, Accessor> x, const T &y) const
+		{ return init (x.ref (), y); }
+
+	Element &copy (Element &x, const Element &y) const
+		{ COUNT_OPERATION (copies); return _F.copy (x, y); }
+
+	template <class Iterator, class Accessor>
+	Element &copy (Property<Iterator, Accessor> x, const Element &y) const
+		{ return copy (x.ref (), y); }
+
+	integer &cardinality (integer &c) const
+		{ return _F.cardinality (c); }
+
+	integer &characteristic (integer &c) const
+		{ return _F.characteristic (c); }
+
+	bool areEqual (const Element &x, const Element &y) const
+		{ return _F.areEqual (x, y); }
+
+	bool isZero (const Element &x) const
+		{ return _F.isZero (x); }
+
+	bool isOne (const Element &x) const
+		{ return _F.isOne (x); }
+
+	Element &add (Element &x, const Element &y, const Element &z) const
+		{ COUNT_OPERATION (adds); return _F.add (x, y, z); }
+
+	Element &sub (Element &x, const Element &y, const Element &z) const
+		{ COUNT_OPERATION (adds); return _F.sub (x, y, z); }
+
+	Element &mul (Element &x, const Element &y, const Element &z) const
+		{ COUNT_OPERATION (muls); return _F.mul (x, y, z); }
+
+	bool div (Element &x, const Element &y, const Element &z) const
+		{ COUNT_OPERATION (muls); COUNT_OPERATION (invs); return _F.div (x, y, z); }
+
+	Element &neg (Element &x, const Element &y) const
+		{ COUNT_OPERATION (adds); return _F.neg (x, y); }
+
+	bool inv (Element &x, const Element &y) const
+		{ COUNT_OPERATION (invs); return _F.inv (x, y); }
+
+	template <class Iterator1, class Iterator2>
+	bool invBatch (Iterator1 x, Iterator2 y_begin, Iterator2 y_end) const
+	{
+#ifndef DISABLE_OPERATION_COUNTS
+		_counter->count (&OperationCounts::invs, y_end - y_begin);
+#endif
+		return _F.invBatch (x, y_begin, y_end);
+	}
+
+	Element &axpy (Element &z, const Element &a, const Element &x, const Element &y) const
+		{ COUNT_OPERATION (muls); COUNT_OPERATION (adds); return _F.axpy (z, a, x, y); }
+
+	Element &addin (Element &x, const Element &y) const
+		{ COUNT_OPERATION (adds); return _F.addin (x, y); }
+
+	Element &subin (Element &x, const Element &y) const
+		{ COUNT_OPERATION (adds); return _F.subin (x, y); }
+
+	Element &mulin (Element &x, const Element &y) const
+		{ COUNT_OPERATION (muls); return _F.mulin (x, y); }
+
+	template <class Iterator, class Accessor>
+	Element &mulin (Property<Iterator, Accessor> x, const Element &y) const
+		{ return mulin (x.ref (), y); }
+
+	bool divin (Element &x, const Element &y) const
+		{ COUNT_OPERATION (muls); COUNT_OPERATION (invs); return _F.divin (x, y); }
+
+	Element &negin (Element &x) const
+		{ COUNT_OPERATION (adds); return _F.negin (x); }
+
+	bool invin (Element &x) const
+		{ COUNT_OPERATION (invs); return _F.invin (x); }
+
+	Element &axpyin (Element &y, const Element &a, const Element &x) const
+		{ COUNT_OPERATION (muls); COUNT_OPERATION (adds); return _F.axpyin (y, a, x); }
+
+	std::ostream &write (std::ostream &os) const
+		{ os << "counting "; return _F.write (os); }
+
+	std::istream &read (std::istream &is)
+		{ return _F.read (is); }
+
+	std::ostream &write (std::ostream &os, const Element &x) const
+		{ return _F.write (os, x); }
+
+	std::istream &read (std::istream &is, Element &x) const
+		{ return _F.read (is, x); }
+
+	size_t elementWidth () const
+		{ return _F.elementWidth (); }
+
+	Element zero () const { COUNT_OPERATION (constants); return _F.zero (); }
+	Element one () const { COUNT_OPERATION (constants); return _F.one (); }
+	Element minusOne () const { COUNT_OPERATION (constants); return _F.minusOne (); }
+
+	/// Add operations done on behalf of this ring without calling
+	/// it, e.g. by the modules of the underlying ring
+	void countOperations (const OperationCounts &c) const
+	{
+#ifndef DISABLE_OPERATION_COUNTS
+		_counter->count (c);
+#endif
+	}
+
+}; // class CountingRing
+
+/// Report the operations done in F since the last report, see @ref OperationCounter::report
+template <class Ring>
+inline void reportOperationCounts (const CountingRing<Ring> &F, const char *phase)
+	{ F.counter ().report (phase); }
+
+template <class Ring>
+struct Vector<CountingRing<Ring> > : public Vector<Ring> {};
+
+template <class Ring>
+struct CountingModuleTag { typedef typename GenericModule<CountingRing<Ring> >::Tag Parent; };
+
+/** Module which passes dense operations to the modules of the wrapped ring
+ *
+ * gemm, trmm, trsm, gemv and trsv on dense operands are done by
+ * AllModules<Ring> over the underlying ring, and the operations of
+ * the classical algorithm are added to the counts. All other
+ * operations, and these on operands which are not dense, go to the
+ * generic modules over CountingRing<Ring>, which count each
+ * operation as it is done.
+ *
+ * \ingroup blas
+ */
+template <class Ring>
+struct CountingModule : public GenericModule<CountingRing<Ring> >
+{
+	typedef CountingModuleTag<Ring> Tag;
+
+	/// Modules of the underlying ring
+	AllModules<Ring> inner;
+
+	CountingModule (const CountingRing<Ring> &R) : GenericModule<CountingRing<Ring> > (R), inner (R.ring ()) {}
+
+	/// Modules of the underlying ring, with the same cancellation-token as this module
+	AllModules<Ring> &forward ()
+		{ inner._cancellation = this->_cancellation; return inner; }
+
+	/// Whether operations on the vector v may be passed to the modules of Ring
+	template <class Vector>
+	static bool isDense (const Vector &v)
+		{ return DenseRepresentation<Ring>::isDenseVector (v); }
+
+	/// Whether operations on the matrix A may be passed to the modules of Ring
+	template <class Matrix>
+	static bool isDenseMatrix (const Matrix &A)
+		{ return DenseRepresentation<Ring>::isDense (A); }
+};
+
+template <class Ring>
+struct AllModules<CountingRing<Ring> > : public CountingModule<Ring>
+{
+	struct Tag { typedef typename CountingModule<Ring>::Tag Parent; };
+
+	AllModules (const CountingRing<Ring> &R) : CountingModule<Ring> (R) {}
+};
+
+} // namespace LELA
+
+#undef COUNT_OPERATION
+
+#include "lela/blas/level1-generic.h"
+#include "lela/blas/level2-generic.h"
+#include "lela/blas/level3-generic.h"
+#include "lela/blas/level2-counting.h"
+#include "lela/blas/level3-counting.h"
+
+#endif // __LELA_RING_COUNTING_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
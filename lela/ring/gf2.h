@@ -20,8 +20,10 @@
 #include "lela/util/debug.h"
 #include "lela/blas/context.h"
 #include "lela/integer.h"
+#include "lela/ring/interface.h"
 #include "lela/vector/bit-vector.h"
 #include "lela/vector/hybrid.h"
+#include "lela/vector/adaptive.h"
 
 #ifdef __LELA_HAVE_M4RI
 #  include "lela/matrix/m4ri-matrix.h"
@@ -45,7 +47,7 @@ class GF2RandIter;
  \ingroup ring
  */
 
-class GF2
+class GF2 : public RingBase<bool, GF2>
 {
     public:
 
@@ -299,8 +301,29 @@ struct RawVector<bool>
 {
     public:
 	typedef BitVector<DefaultEndianness<uint64> > Dense;
-	typedef std::vector<uint32> Sparse;
-	typedef HybridVector<DefaultEndianness<uint64>, uint16, uint64> Hybrid;
+	typedef std::vector<DefaultIndex> Sparse;
+	typedef HybridVector<DefaultEndianness<uint64>, DefaultIndexPolicy::WordIndex, uint64> Hybrid;
+};
+
+// Over GF2 an adaptive vector may also be hybrid. A sparse vector
+// takes four bytes per entry and a hybrid vector ten bytes per
+// nonzero word, so a sparse vector goes hybrid at about one entry per
+// word and a hybrid vector goes dense when about a quarter of its
+// words are nonzero.
+
+template <>
+struct AdaptiveVectorStorage<bool>
+{
+	typedef RawVector<bool>::Dense Dense;
+	typedef RawVector<bool>::Sparse Sparse;
+	typedef RawVector<bool>::Hybrid Hybrid;
+
+	static const bool has_hybrid = true;
+
+	static double sparseMax () { return 1.0 / 64.0; }
+	static double hybridMax () { return 0.25; }
+
+	static size_t words (size_t n) { return (n + WordTraits<uint64>::bits - 1) / WordTraits<uint64>::bits; }
 };
 
 template <>
@@ -309,8 +332,9 @@ struct Vector<GF2>
     public:
 	typedef bool Element;
 	typedef BitVector<DefaultEndianness<uint64> > Dense;
-	typedef std::vector<uint32> Sparse;
-	typedef HybridVector<DefaultEndianness<uint64>, uint16, uint64> Hybrid;
+	typedef std::vector<DefaultIndex> Sparse;
+	typedef HybridVector<DefaultEndianness<uint64>, DefaultIndexPolicy::WordIndex, uint64> Hybrid;
+	typedef AdaptiveVector<bool> Adaptive;
 };
 
 // Calculation-modules
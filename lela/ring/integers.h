@@ -36,7 +36,7 @@ class IntegerRandIter;
  * \ingroup ring
  */
 
-class Integers : RingInterface<integer>
+class Integers : public RingBase<integer, Integers>
 {
 public:
     
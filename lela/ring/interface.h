@@ -27,11 +27,150 @@
 namespace LELA
 {
 
+/** Compile-time check that a ring satisfies the ring-interface
+ *
+ * The function constraints is never called; instantiating it fails to
+ * compile if Ring lacks one of the operations documented in
+ * RingInterface or if one of them cannot be called as documented
+ * there.
+ *
+ * \ingroup ring
+ */
+template <class Ring>
+struct RingInterfaceCheck
+{
+	typedef typename Ring::Element Element;
+
+	static void constraints (const Ring &F, Element &x, const Element &y, integer &c, std::ostream &os, std::istream &is)
+	{
+		bool b;
+		size_t w;
+
+		F.init (x, c);
+		F.copy (x, y);
+		F.cardinality (c);
+		F.characteristic (c);
+
+		b = F.areEqual (x, y);
+		F.add (x, y, y);
+		F.sub (x, y, y);
+		F.mul (x, y, y);
+		b = F.div (x, y, y);
+		F.neg (x, y);
+		b = F.inv (x, y);
+		F.axpy (x, y, y, y);
+
+		b = F.isZero (y);
+		b = F.isOne (y);
+
+		F.addin (x, y);
+		F.subin (x, y);
+		F.mulin (x, y);
+		b = F.divin (x, y);
+		F.negin (x);
+		b = F.invin (x);
+		F.axpyin (x, y, y);
+
+		F.write (os);
+		F.write (os, y);
+		F.read (is, x);
+		w = F.elementWidth ();
+
+		x = F.zero ();
+		x = F.one ();
+		x = F.minusOne ();
+
+		(void) b;
+		(void) w;
+	}
+};
+
+/** Invert a sequence of elements one by one
+ *
+ * This is the default implementation of invBatch, which all rings
+ * share: it sets x[i] to the inverse of y[i] for each i in [0, y_end
+ * - y_begin) with one call to F.inv per element.
+ *
+ * @return true if all elements are invertible; otherwise false, in
+ * which case the contents of x are undefined
+ *
+ * \ingroup ring
+ */
+template <class Ring, class Iterator1, class Iterator2>
+inline bool invEach (const Ring &F, Iterator1 x, Iterator2 y_begin, Iterator2 y_end)
+{
+	for (; y_begin != y_end; ++y_begin, ++x)
+		if (!F.inv (*x, *y_begin))
+			return false;
+
+	return true;
+}
+
+/** Static base-class of rings
+ *
+ * Rings derive from this class, passing themselves as the parameter
+ * Ring, e.g. class Rationals : public RingBase<RationalElement,
+ * Rationals>. It has no virtual methods, so calls to element
+ * arithmetic are resolved at compile-time and may be inlined into the
+ * BLAS inner loops. Its constructor checks, at compile-time, that Ring
+ * provides the operations documented in RingInterface.
+ *
+ * It also provides defaults for those optional operations of
+ * RingInterface which can be expressed through the others. A ring may
+ * override them simply by defining a method of the same name.
+ *
+ * \ingroup ring
+ */
+template <class _Element, class Ring>
+class RingBase
+{
+public:
+	typedef _Element Element;
+
+	/// Multiplicative inverse of a sequence of elements; see RingInterface::invBatch
+	template <class Iterator1, class Iterator2>
+	bool invBatch (Iterator1 x, Iterator2 y_begin, Iterator2 y_end) const
+		{ return invEach (static_cast<const Ring &> (*this), x, y_begin, y_end); }
+
+	/// Increment an element's reference-count
+	void ref (Element &x) const {}
+
+	/// Decrement an element's reference-count and dispose of it if necessary
+	void unref (Element &x) const {}
+
+protected:
+	RingBase ()
+	{
+		void (*check) (const Ring &, Element &, const Element &, integer &, std::ostream &, std::istream &) =
+			&RingInterfaceCheck<Ring>::constraints;
+		(void) check;
+	}
+
+	~RingBase () {}
+};
+
+/** Report the arithmetic-operations done in F since the last report
+ *
+ * Algorithms call this at the end of each of their phases. It does
+ * nothing except for rings which count their operations, such as
+ * CountingRing, for which it reports the counts to the commentator.
+ *
+ * @param F Ring
+ * @param phase Name of the phase which has just ended
+ *
+ * \ingroup ring
+ */
+template <class Ring>
+inline void reportOperationCounts (const Ring &F, const char *phase) {}
+
 /** Ring-interface
  *
  * This class defines the ring-interface. It is an abstract base-class
- * from which rings may be derived, though this is not required
- * provided that a ring satisfy this interface.
+ * with virtual methods and is intended only for callers which really
+ * need to choose the ring at runtime: rings themselves derive from
+ * RingBase, so that element arithmetic is not dispatched through
+ * virtual calls, and are made into a RingInterface by wrapping them
+ * in a RingAdaptor.
  *
  * \ingroup ring
  */
@@ -197,6 +336,20 @@ public:
 	 * @return true if the inverse exists in the ring, false if not
 	 */
 	virtual bool inv (Element &x, const Element &y) const = 0;
+
+	/** \brief Multiplicative inverse of a sequence of elements
+	 *
+	 * Sets x[i] to the inverse of y[i] for each i in [0, y_end -
+	 * y_begin). Rings in which an inversion is much more expensive
+	 * than a multiplication may implement this with a single
+	 * inversion (Montgomery's trick). The ranges may coincide.
+	 *
+	 * @return true if all elements are invertible; otherwise false,
+	 * in which case the contents of x are undefined
+	 */
+	template <class Iterator1, class Iterator2>
+	bool invBatch (Iterator1 x, Iterator2 y_begin, Iterator2 y_end) const
+		{ return invEach (*this, x, y_begin, y_end); }
     
 	/** \brief Ring element AXPY, r  <-- a * x + y.
 	 *
@@ -425,7 +578,69 @@ public:
 	
 	//@}
 }; // class RingInterface
-  
+
+/** Type-erased ring
+ *
+ * This class wraps a copy of a ring of type Ring in the abstract
+ * RingInterface, so that code compiled once against
+ * RingInterface<Element> may operate over any ring with that element
+ * type. Each operation costs an indirect call; where the ring is
+ * known at compile-time it should be used directly.
+ *
+ * \ingroup ring
+ */
+template <class Ring>
+class RingAdaptor : public RingInterface<typename Ring::Element>
+{
+public:
+	typedef typename Ring::Element Element;
+
+	RingAdaptor (const Ring &F)
+		: _F (F), _zero (F.zero ()), _one (F.one ()), _minus_one (F.minusOne ()) {}
+
+	/// Return the wrapped ring
+	const Ring &ring () const { return _F; }
+
+	Element &init (Element &x, const integer &n = 0) const { return _F.init (x, n); }
+	Element &copy (Element &x, const Element &y) const { return _F.copy (x, y); }
+	integer &cardinality (integer &c) const { return _F.cardinality (c); }
+	integer &characteristic (integer &c) const { return _F.characteristic (c); }
+
+	bool areEqual (const Element &x, const Element &y) const { return _F.areEqual (x, y); }
+	Element &add (Element &x, const Element &y, const Element &z) const { return _F.add (x, y, z); }
+	Element &sub (Element &x, const Element &y, const Element &z) const { return _F.sub (x, y, z); }
+	Element &mul (Element &x, const Element &y, const Element &z) const { return _F.mul (x, y, z); }
+	bool div (Element &x, const Element &y, const Element &z) const { return _F.div (x, y, z); }
+	Element &neg (Element &x, const Element &y) const { return _F.neg (x, y); }
+	bool inv (Element &x, const Element &y) const { return _F.inv (x, y); }
+	Element &axpy (Element &r, const Element &a, const Element &x, const Element &y) const { return _F.axpy (r, a, x, y); }
+
+	bool isZero (const Element &x) const { return _F.isZero (x); }
+	bool isOne (const Element &x) const { return _F.isOne (x); }
+
+	Element &addin (Element &x, const Element &y) const { return _F.addin (x, y); }
+	Element &subin (Element &x, const Element &y) const { return _F.subin (x, y); }
+	Element &mulin (Element &x, const Element &y) const { return _F.mulin (x, y); }
+	bool divin (Element &x, const Element &y) const { return _F.divin (x, y); }
+	Element &negin (Element &x) const { return _F.negin (x); }
+	bool invin (Element &x) const { return _F.invin (x); }
+	Element &axpyin (Element &r, const Element &a, const Element &x) const { return _F.axpyin (r, a, x); }
+
+	std::ostream &write (std::ostream &os) const { return _F.write (os); }
+	std::istream &read (std::istream &is) { return _F.read (is); }
+	std::ostream &write (std::ostream &os, const Element &x) const { return _F.write (os, x); }
+	std::istream &read (std::istream &is, Element &x) const { return _F.read (is, x); }
+	size_t elementWidth () const { return _F.elementWidth (); }
+
+	const Element &zero () const { return _zero; }
+	const Element &one () const { return _one; }
+	const Element &minusOne () const { return _minus_one; }
+
+private:
+	Ring _F;
+	Element _zero, _one, _minus_one;
+}; // class RingAdaptor
+
 } // namespace LELA
 
 #endif // __LELA_RING_INTERFACE_H
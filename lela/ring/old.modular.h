@@ -23,11 +23,14 @@
 
 #include "lela/lela-config.h"
 #include "lela/integer.h"
+#include "lela/ring/interface.h"
 #include "lela/util/debug.h"
+#include "lela/util/atomic.h"
 #include "lela/util/property.h"
 #include "lela/blas/context.h"
 #include "lela/randiter/nonzero.h"
 #include "lela/algorithms/strassen-winograd.h"
+#include "lela/blas/level3-cost-model.h"
 #include "lela/ring/type-wrapper.h"
 
 #define FLOAT_MANTISSA 24
@@ -326,12 +329,130 @@ struct ModularTraits<double>
 		{ if (v < 0) return v + modulus; else return v; }
 };
 
+/** Table of inverses modulo n
+ *
+ * This is used by Modular to replace the extended Euclidean algorithm
+ * by a table-lookup where the modulus is small enough that the table
+ * is cheap to build and keep. The generic version holds no table.
+ *
+ * \ingroup ring
+ */
+template <class Element>
+class ModularInverseTable
+{
+public:
+	void init (const Element &modulus) {}
+
+	bool empty () const { return true; }
+
+	bool lookup (Element &x, const Element &y) const { return false; }
+};
+
+/// Inverse-table for moduli which fit into a small word
+///
+/// The tables are shared: there is one per modulus, built by the first
+/// ring with that modulus and kept for the lifetime of the program, so
+/// that copying a ring (e.g. for each thread) copies only a pointer.
+/// Each modulus has a slot holding its table, which is published with
+/// an atomic compare-and-swap, so rings may be constructed from any
+/// number of threads at once.
+///
+/// \ingroup ring
+template <class Element>
+class SmallModularInverseTable
+{
+	typedef std::vector<Element> Table;
+
+	const Table *_table;
+
+	static const Table *&slot (const Element &modulus)
+	{
+		static const Table *slots[1UL << (8 * sizeof (Element))];
+		return slots[modulus];
+	}
+
+	/// Fill the table with the inverses modulo the given modulus; 0 marks a non-invertible element
+	static void build (Table &table, const Element &modulus)
+	{
+		typedef typename ModularTraits<Element>::FatElement FatElement;
+
+		table.assign (modulus, 0);
+
+		if (modulus > 1)
+			table[1] = 1;
+
+		for (FatElement i = 2; i < modulus; ++i) {
+			Element r = modulus % i;
+
+			// modulus = (modulus / i) i + r, so -(modulus / i) r^-1 is
+			// an inverse of i whenever r is invertible
+			if (table[r] != 0) {
+				FatElement t = ((modulus / i) * table[r]) % modulus;
+				table[i] = modulus - t;
+			} else {
+				int a = 1, b = 0, x = i, y = modulus, q, t;
+
+				while (y != 0) {
+					q = x / y;
+					t = x - q * y; x = y; y = t;
+					t = a - q * b; a = b; b = t;
+				}
+
+				if (x == 1)
+					table[i] = (a < 0) ? a + modulus : a;
+			}
+		}
+	}
+
+public:
+	SmallModularInverseTable () : _table (NULL) {}
+
+	/// Use the table for the given modulus, building it if no ring has done so yet
+	void init (const Element &modulus)
+	{
+		const Table *&s = slot (modulus);
+		const Table *existing = Atomic::load (s);
+
+		if (existing == NULL) {
+			Table *table = new Table;
+
+			build (*table, modulus);
+
+			// Another thread may have built the table meanwhile
+			if (Atomic::compareExchange (s, existing, (const Table *) table))
+				existing = table;
+			else
+				delete table;
+		}
+
+		_table = existing;
+	}
+
+	bool empty () const { return _table == NULL || _table->empty (); }
+
+	/// Set x to the inverse of y; returns false if there is no table
+	bool lookup (Element &x, const Element &y) const
+	{
+		if (empty ())
+			return false;
+
+		x = (*_table)[y];
+		return true;
+	}
+};
+
+template <>
+class ModularInverseTable<uint8> : public SmallModularInverseTable<uint8> {};
+
+template <>
+class ModularInverseTable<uint16> : public SmallModularInverseTable<uint16> {};
+
 /** Integers modulo n
  * 
  * \ingroup ring
 */
 template <class _Element>
-class Modular
+class Modular : public RingBase<_Element, Modular<_Element> >
 {
 public:
 
@@ -344,15 +465,19 @@ public:
 	Modular () {}
 
 	Modular (unsigned long modulus) : _modulus (modulus)
-		{ lela_check (ModularTraits<Element>::valid_modulus (integer (modulus))); }
+	{
+		lela_check (ModularTraits<Element>::valid_modulus (integer (modulus)));
+		_inv_table.init (_modulus);
+	}
 
 	Modular (const integer &modulus)
 	{
 		lela_check (ModularTraits<Element>::valid_modulus (modulus));
 		ModularTraits<Element>::init_modulus (_modulus, modulus);
+		_inv_table.init (_modulus);
 	}
 
-	Modular (const Modular<Element> &F) : _modulus (F._modulus) {}
+	Modular (const Modular<Element> &F) : _modulus (F._modulus), _inv_table (F._inv_table) {}
 
 	integer &convert (integer &x, const Element &y) const { return x = y; }
 	double &convert (double &x, const Element &y) const {return  x = (double) y;}
@@ -398,7 +523,7 @@ public:
 	bool isOne (const Element &x) const { return x == 1; }
 
 	std::ostream &write (std::ostream &os) const { os << "ZZ/"; return ModularTraits<Element>::write (os, _modulus); }
-	std::istream &read (std::istream &is) { return is >> _modulus; }
+	std::istream &read (std::istream &is) { is >> _modulus; _inv_table.init (_modulus); return is; }
 
 	std::ostream &write (std::ostream &os, const Element &x) const { return ModularTraits<Element>::write (os, x); }
 
@@ -459,6 +584,9 @@ public:
  
 	bool inv (Element &x, const Element &y) const
 	{
+		if (_inv_table.lookup (x, y))
+			return x != 0;
+
 		typename ModularTraits<Element>::EEAElement ty, tm;
 		typename ModularTraits<Element>::EEAElement gcd;
 
@@ -473,6 +601,50 @@ public:
 			return false;
 	}
 
+	/** Invert a sequence of elements
+	 *
+	 * Sets x[i] to the inverse of y[i] for each i in [0, y_end -
+	 * y_begin). Unless there is an inverse-table, this uses
+	 * Montgomery's trick: one inversion of the product of all
+	 * elements and three multiplications per element. The ranges
+	 * may coincide.
+	 *
+	 * @returns true if all elements are invertible; otherwise
+	 * false, in which case the contents of x are undefined
+	 */
+	template <class Iterator1, class Iterator2>
+	bool invBatch (Iterator1 x, Iterator2 y_begin, Iterator2 y_end) const
+	{
+		size_t i, n = y_end - y_begin;
+
+		if (n == 0)
+			return true;
+
+		if (!_inv_table.empty ())
+			return invEach (*this, x, y_begin, y_end);
+
+		std::vector<Element> prefix (n);
+		Element t, yi;
+
+		prefix[0] = y_begin[0];
+
+		for (i = 1; i < n; ++i)
+			mul (prefix[i], prefix[i - 1], y_begin[i]);
+
+		if (!inv (t, prefix[n - 1]))
+			return false;
+
+		for (i = n - 1; i > 0; --i) {
+			yi = y_begin[i];
+			mul (x[i], t, prefix[i - 1]);
+			mulin (t, yi);
+		}
+
+		x[0] = t;
+
+		return true;
+	}
+
 	Element &axpy (Element &r, const Element &a, const Element &x, const Element &y) const
 	{
 		typename ModularTraits<Element>::FatElement t = a;
@@ -536,6 +708,8 @@ public:
 	Element minusOne () const { Element t = _modulus - 1; return ModularTraits<Element>::shift_down (t, _modulus); }
 
 private:
+	ModularInverseTable<Element> _inv_table;
+
 	// The extended Euclidean algoritm
 	typename ModularTraits<Element>::EEAElement &eea (typename ModularTraits<Element>::EEAElement &gcd,
 							  typename ModularTraits<Element>::EEAElement &a,
@@ -670,11 +844,11 @@ struct ZpModule<double> : public GenericModule<Modular<double> >
 };
 
 template <class Element>
-struct AllModules<Modular<Element> > : public StrassenModule<Modular<Element>, ZpModule<Element> >
+struct AllModules<Modular<Element> > : public CostModelModule<Modular<Element>, StrassenModule<Modular<Element>, ZpModule<Element> > >
 {
-	struct Tag { typedef typename StrassenModule<Modular<Element>, ZpModule<Element> >::Tag Parent; };
+	struct Tag { typedef typename CostModelModule<Modular<Element>, StrassenModule<Modular<Element>, ZpModule<Element> > >::Tag Parent; };
 
-	AllModules (const Modular<Element> &R) : StrassenModule<Modular<Element>, ZpModule<Element> > (R) {}
+	AllModules (const Modular<Element> &R) : CostModelModule<Modular<Element>, StrassenModule<Modular<Element>, ZpModule<Element> > > (R) {}
 };
 
 } // namespace LELA
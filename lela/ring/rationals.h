@@ -36,7 +36,7 @@ class RationalRandIter;
  * \ingroup ring
  */
 
-class Rationals : public RingInterface<RationalElement>
+class Rationals : public RingBase<RationalElement, Rationals>
 {
     private:
 
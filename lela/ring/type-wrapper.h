@@ -21,6 +21,7 @@
 
 #include "lela/lela-config.h"
 #include "lela/integer.h"
+#include "lela/ring/interface.h"
 #include "lela/randiter/type-wrapper.h"
 #include "lela/blas/context.h"
 #include "lela/util/property.h"
@@ -37,7 +38,7 @@ namespace LELA
  */
 
 template <class K>
-class TypeWrapperRing
+class TypeWrapperRing : public RingBase<K, TypeWrapperRing<K> >
 {
 protected:
 	integer _p;
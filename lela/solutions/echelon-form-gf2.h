@@ -59,6 +59,8 @@ public:
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
 
+		ActivityGuard guard;
+
 		commentator.start (str.str ().c_str (), __FUNCTION__);
 
 		size_t rank;
@@ -101,6 +103,8 @@ public:
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
 
+		ActivityGuard guard;
+
 		commentator.start (str.str ().c_str (), __FUNCTION__);
 
 		size_t rank;
@@ -153,7 +157,11 @@ public:
 
 	template <class Matrix>
 	size_t rank (const Matrix &A) const
-		{ return _rank_table[&A]; }
+	{
+		std::map<const void *, size_t>::const_iterator i = _rank_table.find (&A);
+		lela_check (i != _rank_table.end ());
+		return i->second;
+	}
 
 	size_t rank (const DenseMatrix<bool> &A)
 	{
@@ -14,12 +14,15 @@
 #ifndef __LELA_SOLUTIONS_ECHELON_FORM_H
 #define __LELA_SOLUTIONS_ECHELON_FORM_H
 
+#include <map>
+
 #include "lela/blas/context.h"
 #include "lela/algorithms/elimination.h"
 #include "lela/algorithms/gauss-jordan.h"
 #include "lela/algorithms/faugere-lachartre.h"
 #include "lela/matrix/dense.h"
 #include "lela/util/error.h"
+#include "lela/util/debug.h"
 
 namespace LELA
 {
@@ -65,6 +68,8 @@ public:
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
 
+		ActivityGuard guard;
+
 		commentator.start (str.str ().c_str (), __FUNCTION__);
 
 		size_t rank;
@@ -107,6 +112,8 @@ public:
 		std::ostringstream str;
 		str << "Row-echelon form (method: " << method_names[method] << ")" << std::ends;
 
+		ActivityGuard guard;
+
 		commentator.start (str.str ().c_str (), __FUNCTION__);
 
 		size_t rank;
@@ -160,7 +167,11 @@ public:
 	 */
 	template <class Matrix>
 	size_t rank (const Matrix &A) const
-		{ return _rank_table[&A]; }
+	{
+		std::map<const void *, size_t>::const_iterator i = _rank_table.find (&A);
+		lela_check (i != _rank_table.end ());
+		return i->second;
+	}
 };
 
 } // namespace LELA
@@ -0,0 +1,67 @@
+/* lela/util/atomic.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Atomic operations on words shared between threads
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_ATOMIC_H
+#define __LELA_UTIL_ATOMIC_H
+
+namespace LELA
+{
+
+/** Atomic operations on integers and pointers
+ *
+ * These are safe whatever the threads are created by -- OpenMP, the
+ * @ref Executor, or the application -- so they are used for state
+ * which is shared between all copies of a ring or module. They map
+ * to the __atomic builtins of GCC and Clang.
+ *
+ * \ingroup util
+ */
+namespace Atomic
+{
+	/// Read x, seeing all writes made before it was stored
+	template <class T>
+	inline T load (const T &x)
+		{ return __atomic_load_n (&x, __ATOMIC_ACQUIRE); }
+
+	/// Store v in x
+	template <class T>
+	inline void store (T &x, T v)
+		{ __atomic_store_n (&x, v, __ATOMIC_RELEASE); }
+
+	/// Add v to x, returning the previous value
+	template <class T>
+	inline T fetchAdd (T &x, T v)
+		{ return __atomic_fetch_add (&x, v, __ATOMIC_RELAXED); }
+
+	/** Replace x by desired if it equals expected
+	 *
+	 * @returns true if x was replaced; otherwise false, in which
+	 * case expected is set to the value of x
+	 */
+	template <class T>
+	inline bool compareExchange (T &x, T &expected, T desired)
+		{ return __atomic_compare_exchange_n (&x, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); }
+}
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_ATOMIC_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,125 @@
+/* lela/util/cancellation.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Cooperative cancellation of long-running computations
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_CANCELLATION_H
+#define __LELA_UTIL_CANCELLATION_H
+
+#include <sys/time.h>
+#include <csignal>
+
+#include "lela/util/error.h"
+
+namespace LELA
+{
+
+/** Exception thrown when a computation is cancelled
+ *
+ * Thrown from the point at which the cancellation is noticed, so
+ * the matrices on which the computation was operating are left in
+ * an unspecified state. The algorithms stop the activities of the
+ * @ref commentator which they started by means of an @ref
+ * ActivityGuard, so the activity-stack and the trace are as before
+ * the computation.
+ *
+ * \ingroup util
+ */
+class Cancelled : public LELAError
+{
+public:
+	Cancelled (const char *msg) : LELAError (msg) {}
+};
+
+/** Token through which a computation may be cancelled
+ *
+ * A token is attached to a @ref Context with
+ * Context::setCancellationToken. The algorithms and the level 3 BLAS
+ * check it at their progress-points -- once per pivot in elimination,
+ * at each level of recursion in the asymptotically fast algorithms,
+ * once per row of output in matrix-multiplication -- and throw
+ * @ref Cancelled once it has been cancelled or its deadline has
+ * passed.
+ *
+ * A check costs one comparison when no token is attached and one
+ * call to gettimeofday when a deadline is set. cancel () may be
+ * called from another thread or from a signal-handler.
+ *
+ * \ingroup util
+ */
+class CancellationToken
+{
+public:
+	CancellationToken () : _cancelled (0), _has_deadline (false), _deadline (0.0) {}
+
+	/// Request that the computation stop at its next progress-point
+	void cancel () { _cancelled = 1; }
+
+	/** Request that the computation stop once the given time has
+	 * elapsed
+	 *
+	 * @param seconds Time from now, in seconds
+	 */
+	void setDeadline (double seconds)
+	{
+		_deadline = now () + seconds;
+		_has_deadline = true;
+	}
+
+	/// Remove the deadline, if any
+	void clearDeadline () { _has_deadline = false; }
+
+	/// Remove both the request to cancel and the deadline
+	void reset () { _cancelled = 0; _has_deadline = false; }
+
+	/// True if cancel () has been called
+	bool cancelRequested () const { return _cancelled != 0; }
+
+	/// True if a deadline has been set and has passed
+	bool deadlinePassed () const { return _has_deadline && now () >= _deadline; }
+
+	/// Throw Cancelled if the computation should stop
+	void check () const
+	{
+		if (_cancelled)
+			throw Cancelled ("Computation was cancelled");
+
+		if (deadlinePassed ())
+			throw Cancelled ("Computation exceeded its deadline");
+	}
+
+private:
+	static double now ()
+	{
+		struct timeval tv;
+		gettimeofday (&tv, NULL);
+		return (double) tv.tv_sec + (double) tv.tv_usec * 1e-6;
+	}
+
+	// Written by cancel (), which may be called from a
+	// signal-handler, so it must be of this type
+	volatile sig_atomic_t _cancelled;
+	bool _has_deadline;
+	double _deadline;
+};
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_CANCELLATION_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
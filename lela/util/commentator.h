@@ -25,8 +25,10 @@
 #include <streambuf>
 #include <fstream>
 #include <cstring>
+#include <exception>
 
 #include "lela/util/timer.h"
+#include "lela/util/trace.h"
 
 #ifndef MAX
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
@@ -47,6 +49,7 @@
 #define MSG_DONE             "done"
 #define MSG_PASSED           "passed"
 #define MSG_FAILED           "FAILED"
+#define MSG_ABORTED          "aborted"
 
 #define MSG_STATUS(ret) (ret ? MSG_PASSED : MSG_FAILED)
 
@@ -277,6 +280,12 @@ public:
 
 	void restoreActivityState (ActivityState state);
 
+	/** Number of activities which have been started and not
+	 * yet stopped
+	 */
+	size_t activityDepth () const
+		{ return _activities.size (); }
+
 	/** @name Configuration
 	 */
 
@@ -423,7 +432,7 @@ public:
 	 * @return true if stream is the null stream; false otherwise
 	 */
 	bool isNullStream (const std::ostream &str) 
-		{ return &str == &cnull; }
+		{ return &str == &cnull || &str == &_muted_stream; }
 
 	/** Set output stream for brief report
 	 * @param stream Output stream
@@ -447,6 +456,56 @@ public:
 	 */
 	void setDefaultReportFile (const char *filename);
 
+	/** Set the trace sink
+	 *
+	 * Every activity started and stopped from now on is recorded
+	 * in the given TraceSink, independently of the message classes
+	 * and depths configured for the textual reports.
+	 *
+	 * @param sink TraceSink into which to record activities; 0 to
+	 *             stop recording. The commentator does not take
+	 *             ownership.
+	 */
+	void setTraceSink (TraceSink *sink)
+		{ _trace = sink; }
+
+	/** Get the trace sink, or 0 if none is set
+	 */
+	TraceSink *traceSink () const
+		{ return _trace; }
+
+	/** Attach an integer argument, such as a matrix dimension, to
+	 * the current activity in the trace. Has no effect unless a
+	 * trace sink is set.
+	 *
+	 * @param key Name of the argument
+	 * @param value Value of the argument
+	 */
+	void traceArgument (const char *key, long value)
+		{ if (_trace != (TraceSink *) 0 && !_muted) _trace->argument (key, value); }
+
+	/** Suppress all output and activity-tracking
+	 *
+	 * While the commentator is muted, start, stop, and progress
+	 * have no effect, isPrinted returns false, and report returns
+	 * a stream which discards its input. This permits code which
+	 * uses the commentator to run concurrently in several threads,
+	 * since the activity-stack is then never modified. Calls nest;
+	 * each call must be matched by a call to unmute.
+	 */
+	void mute ()
+		{ ++_muted; }
+
+	/** Undo the effect of one call to mute
+	 */
+	void unmute ()
+		{ if (_muted > 0) --_muted; }
+
+	/** Determine whether the commentator is muted
+	 */
+	bool isMuted () const
+		{ return _muted > 0; }
+
 	//@} Configuration
 
 	/** @name Legacy commentator interface
@@ -573,6 +632,11 @@ protected:
 
 	std::string                      _iteration_str;     // String referring to current iteration -- HACK
 
+	TraceSink                       *_trace;             // Sink for the timeline of activities, or 0
+
+	unsigned int                     _muted;             // Number of unmatched calls to mute ()
+	std::ostream                     _muted_stream;      // Stream without buffer returned by report () when muted
+
 	// Functions for the brief report
 	virtual void printActivityReport  (Activity &activity);
 	virtual void updateActivityReport (Activity &activity);
@@ -703,6 +767,34 @@ private:
 // Default global commentator
 extern Commentator commentator;
 
+/** Guard which stops the activities of a scope left by an exception
+ *
+ * A function which starts activities and may throw, e.g. @ref
+ * Cancelled, declares an ActivityGuard before its first call to
+ * Commentator::start. If the scope is left normally, the guard does
+ * nothing. If it is left by an exception, the guard stops all
+ * activities started since its construction with the message
+ * MSG_ABORTED, so that they are reported and their spans in the trace
+ * are ended. Nothing is done while the commentator is muted.
+ *
+ * \ingroup util
+ */
+class ActivityGuard
+{
+public:
+	ActivityGuard () : _depth (commentator.activityDepth ()) {}
+
+	~ActivityGuard ()
+	{
+		if (std::uncaught_exception () && !commentator.isMuted ())
+			while (commentator.activityDepth () > _depth)
+				commentator.stop (MSG_ABORTED);
+	}
+
+private:
+	size_t _depth;
+};
+
 } // namespace LELA
 
 #else //DISABLE_COMMENTATOR
@@ -788,6 +880,13 @@ public:
 	inline void setReportStream (std::ostream &) {}
 	inline void setMessageClassStream (const char *, std::ostream &) {}
 	inline void setDefaultReportFile (const char *) {}
+	inline void setTraceSink (TraceSink *) {}
+	inline TraceSink *traceSink () const { return (TraceSink *) 0; }
+	inline size_t activityDepth () const { return 0; }
+	inline void traceArgument (const char *, long) {}
+	inline void mute () {}
+	inline void unmute () {}
+	inline bool isMuted () const { return false; }
 	inline void start (const char *, const char *, long , const char *) {}
 	inline void stop (const char *, long , const char *, long) {}
 	inline void progress (const char *, long , long , long ) {}
@@ -817,6 +916,13 @@ private:
 extern Commentator commentator;
 //static Commentator commentator;
 
+class ActivityGuard
+{
+public:
+	inline ActivityGuard () {}
+	inline ~ActivityGuard () {}
+};
+
 } // namespace LELA
 
 #endif // DISABLE_COMMENTATOR
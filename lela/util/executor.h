@@ -0,0 +1,286 @@
+/* lela/util/executor.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Deferred execution of independent operations
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_EXECUTOR_H
+#define __LELA_UTIL_EXECUTOR_H
+
+#include <vector>
+#include <string>
+
+#include "lela/util/error.h"
+#include "lela/util/debug.h"
+#include "lela/util/cancellation.h"
+
+namespace LELA
+{
+
+class Executor;
+class Future;
+
+/** Operation submitted to an @ref Executor
+ *
+ * Users normally do not derive from this class directly but submit
+ * a functor with Executor::submit.
+ *
+ * \ingroup util
+ */
+class AsyncTask
+{
+public:
+	/// Whether an operation uses OpenMP itself, see @ref Executor
+	enum Threading { PARALLEL, SERIAL };
+
+	AsyncTask (const char *name = "Asynchronous operation", Threading threading = PARALLEL)
+		: _refs (0), _done (false), _failure (FAILURE_NONE), _name (name), _threading (threading) {}
+	virtual ~AsyncTask ();
+
+	/// Perform the operation; may throw
+	virtual void run () = 0;
+
+private:
+	friend class Future;
+	friend class Executor;
+
+	enum Failure { FAILURE_NONE, FAILURE_CANCELLED, FAILURE_OTHER };
+
+	void acquire () { ++_refs; }
+	static void release (AsyncTask *task) { if (--task->_refs == 0) delete task; }
+
+	bool dependenciesDone () const;
+	void releaseDependencies ();
+
+	// Run the operation unless a dependency failed, recording any
+	// exception rather than letting it escape
+	void execute ();
+
+	unsigned int _refs;
+	bool _done;
+	Failure _failure;
+	std::string _message;
+	std::vector<AsyncTask *> _deps;
+	std::string _name;
+	Threading _threading;
+};
+
+/** Result of an asynchronous operation
+ *
+ * A Future refers to an operation submitted to an @ref Executor. It
+ * may be waited on, which runs the operation and all others pending
+ * on the same executor and rethrows any exception the operation
+ * raised, and further operations may be chained onto it with @ref
+ * then. Futures are cheap to copy; the operation is kept alive as
+ * long as any copy refers to it.
+ *
+ * Futures are not thread-safe: they should be created, copied, and
+ * waited on only by the thread which owns the executor.
+ *
+ * \ingroup util
+ */
+class Future
+{
+public:
+	/// Construct a Future which refers to no operation and is always ready
+	Future () : _task ((AsyncTask *) 0), _executor ((Executor *) 0) {}
+
+	Future (const Future &f) : _task (f._task), _executor (f._executor)
+		{ if (_task != (AsyncTask *) 0) _task->acquire (); }
+
+	~Future ()
+		{ if (_task != (AsyncTask *) 0) AsyncTask::release (_task); }
+
+	Future &operator = (const Future &f)
+	{
+		if (f._task != (AsyncTask *) 0)
+			f._task->acquire ();
+
+		if (_task != (AsyncTask *) 0)
+			AsyncTask::release (_task);
+
+		_task = f._task;
+		_executor = f._executor;
+		return *this;
+	}
+
+	/// True if this Future refers to an operation
+	bool valid () const
+		{ return _task != (AsyncTask *) 0; }
+
+	/// True if the operation has run, successfully or not
+	bool ready () const
+		{ return _task == (AsyncTask *) 0 || _task->_done; }
+
+	/** Wait for the operation to complete
+	 *
+	 * Runs all operations pending on the executor if the operation
+	 * has not yet run.
+	 *
+	 * @throws Cancelled if the operation or one on which it
+	 * depends was cancelled
+	 * @throws LELAError with the original message if the operation
+	 * or one on which it depends threw any other exception
+	 */
+	void wait () const;
+
+	/** Submit an operation to run after this one
+	 *
+	 * The operation is skipped and the returned Future fails with
+	 * the same exception if this one fails.
+	 *
+	 * @param f Functor with an operator () taking no arguments
+	 * @returns Future for the new operation
+	 */
+	template <class F>
+	Future then (const F &f) const;
+
+private:
+	friend class Executor;
+	friend Future whenAll (const Future &f1, const Future &f2);
+
+	Future (AsyncTask *task, Executor *executor) : _task (task), _executor (executor)
+		{ _task->acquire (); }
+
+	AsyncTask *_task;
+	Executor *_executor;
+};
+
+/** Executor of deferred operations
+ *
+ * Operations submitted to an executor are not run immediately but
+ * when one of their futures, or the executor itself, is waited on.
+ * The pending operations then run in rounds: each round consists of
+ * all operations whose dependencies have completed. If LELA is built
+ * with OpenMP and a round contains more than one operation, the
+ * operations of the round run in parallel, one per thread.
+ *
+ * Operations submitted as AsyncTask::SERIAL, which do not use OpenMP
+ * themselves, e.g. copying or splicing, keep only their own thread.
+ * The remaining threads are divided among the other operations of
+ * the round, for which nested parallelism is enabled, so that e.g. a
+ * trsm overlapping with a splice still runs on all but one thread.
+ *
+ * While a round runs in parallel the @ref commentator is muted, since
+ * its activity-stack is shared between threads: the activities,
+ * progress-reports and messages of the operations are then not
+ * reported. If a trace is being recorded (Commentator::setTraceSink),
+ * each operation of the round instead appears in the trace as one
+ * activity, with the name it was submitted under, on the thread which
+ * ran it, so that the overlap is visible.
+ *
+ * Operations running in the same round must therefore not write to
+ * the same data, nor use the same @ref Context; the BLAS-interface in
+ * BLAS3::async takes care of the latter by copying the context.
+ *
+ * The executor waits for all pending operations when destroyed.
+ *
+ * \ingroup util
+ */
+class Executor
+{
+public:
+	Executor () {}
+	~Executor () { wait (); }
+
+	/** Submit an operation
+	 *
+	 * @param f Functor with an operator () taking no arguments,
+	 * which is copied
+	 * @param after1 Operation after which f must run, if any
+	 * @param after2 Further operation after which f must run, if any
+	 * @returns Future for the operation
+	 */
+	template <class F>
+	Future submit (const F &f, const Future &after1 = Future (), const Future &after2 = Future ())
+		{ return submitTask (new FunctorTask<F> (f, "Asynchronous operation", AsyncTask::PARALLEL), after1, after2); }
+
+	/** Submit an operation with a name and threading
+	 *
+	 * @param name Name of the operation in a trace
+	 * @param threading AsyncTask::SERIAL if f does not use OpenMP,
+	 * otherwise AsyncTask::PARALLEL
+	 * @param f Functor with an operator () taking no arguments,
+	 * which is copied
+	 * @param after1 Operation after which f must run, if any
+	 * @param after2 Further operation after which f must run, if any
+	 * @returns Future for the operation
+	 */
+	template <class F>
+	Future submit (const char *name, AsyncTask::Threading threading, const F &f,
+		       const Future &after1 = Future (), const Future &after2 = Future ())
+		{ return submitTask (new FunctorTask<F> (f, name, threading), after1, after2); }
+
+	/// Run all pending operations
+	void wait ();
+
+	/// Number of operations which have been submitted but have not run
+	size_t pending () const
+		{ return _pending.size (); }
+
+private:
+	template <class F>
+	class FunctorTask : public AsyncTask
+	{
+	public:
+		FunctorTask (const F &f, const char *name, Threading threading) : AsyncTask (name, threading), _f (f) {}
+		void run () { _f (); }
+
+	private:
+		F _f;
+	};
+
+	struct Nop { void operator () () const {} };
+
+	friend Future whenAll (const Future &f1, const Future &f2);
+
+	Future submitTask (AsyncTask *task, const Future &after1, const Future &after2);
+	void runRound (std::vector<AsyncTask *> &round);
+
+	// Run a round of more than one operation in parallel, dividing
+	// the threads among the operations
+	void runParallel (std::vector<AsyncTask *> &round);
+
+	// Not copyable
+	Executor (const Executor &);
+	Executor &operator = (const Executor &);
+
+	std::vector<AsyncTask *> _pending;
+};
+
+/** Future which is ready once both of the given ones are
+ *
+ * At least one of f1 and f2 should be valid. If both are valid, they
+ * should belong to the same executor.
+ *
+ * \ingroup util
+ */
+Future whenAll (const Future &f1, const Future &f2);
+
+template <class F>
+Future Future::then (const F &f) const
+{
+	lela_check (_executor != (Executor *) 0);
+
+	return _executor->submit (f, *this);
+}
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_EXECUTOR_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,138 @@
+/* lela/util/index.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Integer-types of row- and column-indices
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_INDEX_H
+#define __LELA_UTIL_INDEX_H
+
+#include <utility>
+
+#include "lela/lela-config.h"
+#include "lela/integer.h"
+#include "lela/util/error.h"
+
+#ifdef LELA_WIDE_INDICES
+#  error "LELA_WIDE_INDICES has been replaced by the configure-option --enable-wide-indices"
+#endif
+
+namespace LELA
+{
+
+/** Exception thrown when a dimension does not fit in the type of the
+ * indices used to address it
+ *
+ * \ingroup util
+ */
+class IndexOverflow : public LELAError
+{
+public:
+	IndexOverflow (const char *msg) : LELAError (msg) {}
+};
+
+/** Policy of integer-types used for row- and column-indices
+ *
+ * Sparse and hybrid vectors, permutations, and matrices which store
+ * indices take their index-types from a policy. The narrow policy
+ * IndexPolicy<uint32> limits dimensions to 2^32 - 1 and is the
+ * default. The wide policy IndexPolicy<uint64> removes the limit at
+ * the cost of twice the memory for each index; it is selected as the
+ * default by configuring LELA with --enable-wide-indices, or may be
+ * used for individual vectors by passing its types as
+ * template-parameters.
+ *
+ * The default is recorded in lela-config.h, so that the library and
+ * every program using it see the same types. Each translation-unit
+ * including this header refers to a symbol which the library only
+ * defines for the default it was built with, so that objects built
+ * with another default fail to link.
+ *
+ * \ingroup util
+ */
+template <class _Index>
+struct IndexPolicy {};
+
+template <>
+struct IndexPolicy<uint32>
+{
+	/// Index of a row or column
+	typedef uint32 Index;
+
+	/// Index of a row or column, or -1 for none, of the same
+	/// width as Index
+	typedef int32 SignedIndex;
+
+	/// Index of a word in a hybrid vector
+	typedef uint16 WordIndex;
+
+	/// Transposition of two rows or columns, as recorded in permutations
+	typedef std::pair<Index, Index> Transposition;
+
+	/// Largest dimension which may be addressed
+	static size_t maxDim () { return (size_t) (uint32) -1; }
+};
+
+template <>
+struct IndexPolicy<uint64>
+{
+	typedef uint64 Index;
+	typedef int64 SignedIndex;
+	typedef uint32 WordIndex;
+	typedef std::pair<Index, Index> Transposition;
+
+	static size_t maxDim () { return (size_t) -1; }
+};
+
+#ifdef __LELA_WIDE_INDICES
+typedef IndexPolicy<uint64> DefaultIndexPolicy;
+#  define __LELA_INDEX_WIDTH_SYMBOL wideIndicesConfigured
+#else // !__LELA_WIDE_INDICES
+typedef IndexPolicy<uint32> DefaultIndexPolicy;
+#  define __LELA_INDEX_WIDTH_SYMBOL narrowIndicesConfigured
+#endif // __LELA_WIDE_INDICES
+
+/// Defined in the library for the default index-policy it was built with
+extern const int __LELA_INDEX_WIDTH_SYMBOL;
+
+namespace {
+	// Reference to the above, which makes the link fail if this
+	// translation-unit does not agree with the library
+	const int *const indexWidthCheck __attribute__ ((used)) = &__LELA_INDEX_WIDTH_SYMBOL;
+}
+
+/// Default type of row- and column-indices
+typedef DefaultIndexPolicy::Index DefaultIndex;
+
+/** Throw IndexOverflow if a dimension cannot be addressed by the
+ * indices of the given policy
+ *
+ * @param n Dimension
+ * @param what Description of the dimension, for the message
+ */
+template <class Policy>
+inline void checkDim (size_t n, const char *what)
+{
+	if (n > Policy::maxDim ())
+		throw IndexOverflow (what);
+}
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_INDEX_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
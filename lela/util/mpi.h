@@ -0,0 +1,230 @@
+/* lela/util/mpi.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Support for distributed computations with MPI
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_MPI_H
+#define __LELA_UTIL_MPI_H
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+#include <mpi.h>
+
+#include "lela/lela-config.h"
+#include "lela/util/error.h"
+
+namespace LELA
+{
+
+/** Exception thrown when an MPI-operation cannot be done
+ *
+ * \ingroup util
+ */
+class MPIError : public LELAError
+{
+public:
+	MPIError (const char *msg) : LELAError (msg) {}
+};
+
+/** Communicator of a distributed computation
+ *
+ * Wraps an MPI-communicator together with the rank of the calling
+ * process and the number of processes. Also provides the partition
+ * of a range of indices among the processes used by the distributed
+ * algorithms: process p owns a contiguous part, the parts differing
+ * in size by at most one.
+ *
+ * MPI must have been initialised by the caller.
+ *
+ * \ingroup util
+ */
+class MPICommunicator
+{
+	MPI_Comm _comm;
+	int _rank, _size;
+
+    public:
+	MPICommunicator (MPI_Comm comm = MPI_COMM_WORLD) : _comm (comm)
+	{
+		int initialised;
+
+		MPI_Initialized (&initialised);
+
+		if (!initialised)
+			throw MPIError ("MPI has not been initialised");
+
+		MPI_Comm_rank (_comm, &_rank);
+		MPI_Comm_size (_comm, &_size);
+	}
+
+	/// Underlying MPI-communicator
+	MPI_Comm comm () const { return _comm; }
+
+	/// Rank of the calling process
+	int rank () const { return _rank; }
+
+	/// Number of processes
+	int size () const { return _size; }
+
+	/// true if the calling process is the root, which holds input and output
+	bool isRoot () const { return _rank == 0; }
+
+	/// First index of the part of [0, n) owned by process p
+	size_t partBegin (size_t n, int p) const
+		{ return (n / _size) * p + std::min<size_t> (p, n % _size); }
+
+	/// One past the last index of the part of [0, n) owned by process p
+	size_t partEnd (size_t n, int p) const
+		{ return partBegin (n, p + 1); }
+};
+
+/** Set of pending nonblocking MPI-operations
+ *
+ * The buffers of the operations must live until wait () returns. The
+ * destructor waits for any operations still pending.
+ *
+ * \ingroup util
+ */
+class MPIRequests
+{
+	std::vector<MPI_Request> _requests;
+
+    public:
+	~MPIRequests () { wait (); }
+
+	void add (MPI_Request r) { _requests.push_back (r); }
+
+	/// Wait for all pending operations to complete
+	void wait ()
+	{
+		if (!_requests.empty ()) {
+			MPI_Waitall (_requests.size (), &_requests[0], MPI_STATUSES_IGNORE);
+			_requests.clear ();
+		}
+	}
+};
+
+/** Transfers of arrays of plain-old-data
+ *
+ * Elements are transferred as raw bytes, so T must be plain
+ * old data with the same representation on all processes. An array
+ * may have at most INT_MAX entries.
+ *
+ * \ingroup util
+ */
+namespace MPITransfer
+{
+	/// Datatype of one entry of type T; must be freed by the caller
+	template <class T>
+	inline MPI_Datatype entryType ()
+	{
+		MPI_Datatype type;
+
+		MPI_Type_contiguous (sizeof (T), MPI_BYTE, &type);
+		MPI_Type_commit (&type);
+
+		return type;
+	}
+
+	inline int count (size_t n)
+	{
+		if (n > (size_t) INT_MAX)
+			throw MPIError ("Array too large for a single message");
+
+		return (int) n;
+	}
+
+	/// Send n entries starting at buf to process dest without blocking
+	template <class T>
+	inline void isend (const MPICommunicator &comm, const T *buf, size_t n, int dest, int tag, MPIRequests &requests)
+	{
+		MPI_Datatype type = entryType<T> ();
+		MPI_Request r;
+
+		MPI_Isend (const_cast<T *> (buf), count (n), type, dest, tag, comm.comm (), &r);
+		MPI_Type_free (&type);
+		requests.add (r);
+	}
+
+	/// Receive n entries into buf from process src without blocking
+	template <class T>
+	inline void irecv (const MPICommunicator &comm, T *buf, size_t n, int src, int tag, MPIRequests &requests)
+	{
+		MPI_Datatype type = entryType<T> ();
+		MPI_Request r;
+
+		MPI_Irecv (buf, count (n), type, src, tag, comm.comm (), &r);
+		MPI_Type_free (&type);
+		requests.add (r);
+	}
+
+	/// Broadcast n entries of buf from process root without blocking
+	template <class T>
+	inline void ibcast (const MPICommunicator &comm, T *buf, size_t n, int root, MPIRequests &requests)
+	{
+		MPI_Datatype type = entryType<T> ();
+		MPI_Request r;
+
+		MPI_Ibcast (buf, count (n), type, root, comm.comm (), &r);
+		MPI_Type_free (&type);
+		requests.add (r);
+	}
+
+	/// Broadcast n entries of buf from process root
+	template <class T>
+	inline void bcast (const MPICommunicator &comm, T *buf, size_t n, int root)
+	{
+		MPI_Datatype type = entryType<T> ();
+
+		MPI_Bcast (buf, count (n), type, root, comm.comm ());
+		MPI_Type_free (&type);
+	}
+
+	/// Send the entries of v to process dest, preceded by their number
+	template <class T>
+	inline void send (const MPICommunicator &comm, const std::vector<T> &v, int dest, int tag)
+	{
+		unsigned long long n = v.size ();
+		MPI_Datatype type = entryType<T> ();
+
+		MPI_Send (&n, 1, MPI_UNSIGNED_LONG_LONG, dest, tag, comm.comm ());
+		MPI_Send (const_cast<T *> (v.empty () ? NULL : &v[0]), count (n), type, dest, tag, comm.comm ());
+		MPI_Type_free (&type);
+	}
+
+	/// Receive into v entries sent by @ref send from process src
+	template <class T>
+	inline void recv (const MPICommunicator &comm, std::vector<T> &v, int src, int tag)
+	{
+		unsigned long long n;
+		MPI_Datatype type = entryType<T> ();
+
+		MPI_Recv (&n, 1, MPI_UNSIGNED_LONG_LONG, src, tag, comm.comm (), MPI_STATUS_IGNORE);
+		v.resize (n);
+		MPI_Recv (v.empty () ? NULL : &v[0], count (n), type, src, tag, comm.comm (), MPI_STATUS_IGNORE);
+		MPI_Type_free (&type);
+	}
+} // namespace MPITransfer
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_MPI_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,167 @@
+/* lela/util/output-buffer.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Character-buffer with fast integer-formatting for bulk output
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_OUTPUT_BUFFER_H
+#define __LELA_UTIL_OUTPUT_BUFFER_H
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include "lela/integer.h"
+
+namespace LELA
+{
+
+/** Growable character-buffer for formatting large amounts of output
+ *
+ * Text is accumulated in memory and handed to the stream in one
+ * call to std::ostream::write, so that the stream is neither flushed
+ * nor asked to do any formatting of its own for each item. Unsigned
+ * and signed integers are formatted directly into the buffer two
+ * digits at a time.
+ *
+ * Each buffer is meant to be used by one thread only; parallel
+ * writers use one buffer per thread and concatenate the results in
+ * order.
+ *
+ * \ingroup util
+ */
+class OutputBuffer {
+	std::vector<char> _data;
+	size_t _size;
+
+	char *reserve (size_t n)
+	{
+		if (_size + n > _data.size ())
+			_data.resize (std::max (2 * _data.size (), _size + n));
+
+		return &_data[_size];
+	}
+
+public:
+	/// Construct an empty buffer with the given initial capacity
+	OutputBuffer (size_t capacity = 1 << 16) : _data (capacity), _size (0) {}
+
+	/// Number of characters in the buffer
+	size_t size () const { return _size; }
+
+	/// Discard the contents of the buffer
+	void clear () { _size = 0; }
+
+	/// Append a single character
+	void put (char c)
+		{ *reserve (1) = c; ++_size; }
+
+	/// Append n copies of the character c
+	void put (char c, size_t n)
+		{ std::memset (reserve (n), c, n); _size += n; }
+
+	/// Append the first n characters of s
+	void put (const char *s, size_t n)
+		{ std::memcpy (reserve (n), s, n); _size += n; }
+
+	/// Append a null-terminated string
+	void put (const char *s)
+		{ put (s, std::strlen (s)); }
+
+	/// Append the decimal representation of an unsigned integer
+	void putUnsigned (uint64 v)
+	{
+		static const char digit_pairs[201] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		char tmp[20];
+		char *p = tmp + sizeof (tmp);
+
+		while (v >= 100) {
+			unsigned int r = (unsigned int) (v % 100);
+			v /= 100;
+			*--p = digit_pairs[2 * r + 1];
+			*--p = digit_pairs[2 * r];
+		}
+
+		if (v >= 10) {
+			*--p = digit_pairs[2 * v + 1];
+			*--p = digit_pairs[2 * v];
+		} else
+			*--p = '0' + (char) v;
+
+		put (p, tmp + sizeof (tmp) - p);
+	}
+
+	/// Append the decimal representation of a signed integer
+	void putSigned (int64 v)
+	{
+		if (v < 0) {
+			put ('-');
+			putUnsigned (uint64 (0) - uint64 (v));
+		} else
+			putUnsigned (uint64 (v));
+	}
+
+	/** Right-justify the text from position start onwards
+	 *
+	 * Inserts spaces before position start so that the text
+	 * appended since then occupies at least width characters. This
+	 * mirrors the effect of std::ostream::width on a single
+	 * formatted item.
+	 */
+	void justify (size_t start, size_t width)
+	{
+		size_t len = _size - start;
+
+		if (len >= width)
+			return;
+
+		size_t pad = width - len;
+
+		reserve (pad);
+		std::memmove (&_data[start + pad], &_data[start], len);
+		std::memset (&_data[start], ' ', pad);
+		_size += pad;
+	}
+
+	/// Write the contents of the buffer to the stream and clear it
+	std::ostream &writeTo (std::ostream &os)
+	{
+		if (_size > 0)
+			os.write (&_data[0], _size);
+
+		_size = 0;
+		return os;
+	}
+};
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_OUTPUT_BUFFER_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
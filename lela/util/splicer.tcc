@@ -118,7 +118,7 @@ void Splicer::attach_block_specialised (const Ring &F, Vector1 &out, const Vecto
 	typename SparseSubvector<const Vector2, VectorRepresentationTypes::Hybrid01>::const_iterator i_v1;
 
 	for (i_v1 = v1.begin (); i_v1 != v1.end (); ++i_v1)
-		append_word (out, dest_idx + (i_v1->first << WordTraits<typename Vector2::word_type>::logof_size), i_v1->second);
+		append_word (out, dest_idx + ((size_t) i_v1->first << WordTraits<typename Vector2::word_type>::logof_size), i_v1->second);
 }
 
 template <class Ring, class Vector1, class Vector2>
@@ -158,7 +158,7 @@ void Splicer::attach_block_specialised (const Ring &F, Vector1 &out, const Vecto
 
 	for (i = v1.begin (); i != v1.end (); ++i) {
 		typename Subvector2::word_type t;
-		size_t idx = (i->first << WordTraits<typename Subvector2::word_type>::logof_size) + dest_idx;
+		size_t idx = ((size_t) i->first << WordTraits<typename Subvector2::word_type>::logof_size) + dest_idx;
 
 		for (t = Subvector2::Endianness::e_0; t != 0; t = Subvector2::Endianness::shift_right (t, 1), ++idx)
 			if (i->second & t)
@@ -0,0 +1,133 @@
+/* lela/util/trace.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Recording of activities as a timeline in Chrome trace format
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_UTIL_TRACE_H
+#define __LELA_UTIL_TRACE_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+
+namespace LELA
+{
+
+/** Timeline of activities
+ *
+ * A TraceSink records the beginning and end of activities into a
+ * buffer in memory, together with the thread on which they ran,
+ * their nesting-depth, and any number of integer arguments such as
+ * the dimensions of the matrices involved. The buffer may then be
+ * written in the JSON trace-event format understood by
+ * chrome://tracing and Perfetto, so that the durations of the phases
+ * of an algorithm and their overlap between threads can be inspected.
+ *
+ * Nothing is written until @ref write is called; recording an event
+ * costs one timestamp and one append to the buffer.
+ *
+ * The commentator forwards all its activities to the sink installed
+ * with Commentator::setTraceSink. Parallel code which does not go
+ * through the commentator may call @ref begin and @ref end directly;
+ * if LELA is built with OpenMP, the sink is safe to use from within
+ * parallel regions and records the OpenMP thread-number.
+ *
+ * \ingroup util
+ */
+class TraceSink
+{
+public:
+	/** Constructor
+	 *
+	 * Timestamps are measured from the time of construction.
+	 */
+	TraceSink ();
+
+	/** Record the beginning of an activity
+	 *
+	 * @param name Human-readable description of the activity
+	 * @param category Category, usually the function in which the
+	 * activity runs; may be 0
+	 * @param depth Nesting-depth of the activity
+	 */
+	void begin (const char *name, const char *category = (const char *) 0, size_t depth = 0);
+
+	/** Attach an argument to the innermost activity
+	 *
+	 * The argument is attached to the innermost activity of the
+	 * calling thread which has begun but not ended. Has no effect if
+	 * there is no such activity.
+	 *
+	 * @param key Name of the argument, e.g. "rows"
+	 * @param value Value of the argument
+	 */
+	void argument (const char *key, long value);
+
+	/** Record the end of the innermost activity of the calling thread
+	 */
+	void end ();
+
+	/** Write the recorded events in Chrome trace JSON format
+	 *
+	 * Activities which have not yet ended are written as begun but
+	 * not ended; trace-viewers show them extending to the end of the
+	 * trace.
+	 */
+	std::ostream &write (std::ostream &os) const;
+
+	/** Discard all recorded events
+	 */
+	void clear ();
+
+	/** Number of events recorded so far
+	 */
+	size_t size () const
+		{ return _events.size (); }
+
+	/** Write s to os as a JSON-string, i.e. quoted and with
+	 * special characters escaped
+	 */
+	static std::ostream &writeString (std::ostream &os, const std::string &s);
+
+private:
+	struct Event
+	{
+		char                                        _phase;     // 'B' or 'E'
+		std::string                                 _name;
+		std::string                                 _category;
+		double                                      _ts;        // Microseconds since construction
+		int                                         _tid;
+		size_t                                      _depth;
+		std::vector<std::pair<std::string, long> >  _args;
+	};
+
+	double now () const;
+	static int threadId ();
+
+	std::vector<Event>                  _events;
+	std::map<int, std::vector<size_t> > _open;     // Indices of begun but not ended events, per thread
+	double                              _start;
+	int                                 _pid;
+};
+
+} // namespace LELA
+
+#endif // __LELA_UTIL_TRACE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -0,0 +1,234 @@
+/* lela/vector/adaptive.h
+ * Copyright 2026 agent <agent@local>
+ *
+ * Written by agent <agent@local>
+ *
+ * Vector which switches between sparse, hybrid, and dense storage
+ * according to its density
+ *
+ * ------------------------------------
+ *
+ * This file is part of LELA, licensed under the GNU General Public
+ * License version 3. See COPYING for more information.
+ */
+
+#ifndef __LELA_VECTOR_ADAPTIVE_H
+#define __LELA_VECTOR_ADAPTIVE_H
+
+#include <algorithm>
+
+#include "lela/util/debug.h"
+#include "lela/vector/traits.h"
+#include "lela/vector/sparse.h"
+
+namespace LELA
+{
+
+/** Storage of an adaptive vector
+ *
+ * Defines the underlying vector-types of an @ref AdaptiveVector with
+ * the given element-type and the default density-thresholds at which
+ * it switches between them. Rings whose element-type admits a hybrid
+ * representation specialise this (see lela/ring/gf2.h).
+ *
+ * \ingroup vector
+ */
+template <class Element>
+struct AdaptiveVectorStorage
+{
+	typedef typename RawVector<Element>::Dense Dense;
+	typedef typename RawVector<Element>::Sparse Sparse;
+
+	/// There is no hybrid representation; the type is unused
+	typedef typename RawVector<Element>::Sparse Hybrid;
+
+	static const bool has_hybrid = false;
+
+	/// Maximum proportion of nonzero entries in a sparse vector
+	static double sparseMax () { return 0.25; }
+
+	/// Maximum proportion of nonzero words in a hybrid vector
+	static double hybridMax () { return 1.0; }
+
+	/// Number of words in the hybrid representation of a vector of dimension n
+	static size_t words (size_t n) { return n; }
+};
+
+/** Vector with per-vector choice of representation
+ *
+ * An AdaptiveVector holds its entries in exactly one of a sparse,
+ * hybrid (where the ring supports it) or dense vector and moves them
+ * to another representation when its density crosses a threshold. A
+ * matrix with rows of this type (see @ref SparseMatrix) thus stores
+ * rows which have filled in during elimination densely while keeping
+ * the rest sparse.
+ *
+ * The level 1 BLAS dispatch on kind () and then on the
+ * representation-type of the underlying vector, so each pair of
+ * representations is handled by the existing specialised code. After
+ * an operation which writes to an AdaptiveVector, the vector is
+ * promoted to a denser representation if it has filled in beyond
+ * the threshold for its current one; demotion to a sparser
+ * representation costs a scan of the entries, and happens only on
+ * copy and on explicit calls to BLAS1::adapt.
+ *
+ * Thresholds are proportions of nonzero entries (for leaving the
+ * sparse representation) and of nonzero words (for leaving the hybrid
+ * representation). A vector demotes only once its density falls
+ * below half the threshold, so that it does not oscillate.
+ *
+ * Subvectors of adaptive vectors are not supported.
+ *
+ * \ingroup vector
+ */
+template <class _Element>
+class AdaptiveVector
+{
+public:
+	typedef _Element Element;
+	typedef AdaptiveVectorStorage<Element> Storage;
+	typedef typename Storage::Dense Dense;
+	typedef typename Storage::Sparse Sparse;
+	typedef typename Storage::Hybrid Hybrid;
+
+	typedef VectorRepresentationTypes::Adaptive RepresentationType;
+	typedef VectorStorageTypes::Generic StorageType;
+	typedef AdaptiveVector ContainerType;
+	typedef void SubvectorType;
+	typedef void ConstSubvectorType;
+	typedef void AlignedSubvectorType;
+	typedef void ConstAlignedSubvectorType;
+	static const int align = 1;
+
+	/// Representation currently in use, ordered by increasing density
+	enum Kind { SPARSE, HYBRID, DENSE };
+
+	/** Constructor
+	 *
+	 * @param n Dimension of the vector. The vector is initially
+	 * zero and sparse.
+	 */
+	AdaptiveVector (size_t n = 0)
+		: _kind (SPARSE), _n (n), _sparse_max (Storage::sparseMax ()), _hybrid_max (Storage::hybridMax ()) {}
+
+	/// Representation currently in use
+	Kind kind () const { return _kind; }
+
+	/// Dimension of the vector
+	size_t dim () const { return _n; }
+
+	/// Set the dimension of the vector
+	void resize (size_t n)
+	{
+		_n = n;
+
+		if (_kind == DENSE)
+			_dense.resize (n);
+	}
+
+	/// Underlying vector; the vector must currently be of kind SPARSE
+	Sparse &sparse () { lela_check (_kind == SPARSE); return _sparse; }
+	const Sparse &sparse () const { lela_check (_kind == SPARSE); return _sparse; }
+
+	/// Underlying vector; the vector must currently be of kind HYBRID
+	Hybrid &hybrid () { lela_check (_kind == HYBRID); return _hybrid; }
+	const Hybrid &hybrid () const { lela_check (_kind == HYBRID); return _hybrid; }
+
+	/// Underlying vector; the vector must currently be of kind DENSE
+	Dense &dense () { lela_check (_kind == DENSE); return _dense; }
+	const Dense &dense () const { lela_check (_kind == DENSE); return _dense; }
+
+	/** Discard the contents and switch to the given representation
+	 *
+	 * Afterwards the underlying vector is empty, or for DENSE, of
+	 * dimension dim () with undefined entries.
+	 */
+	void reset (Kind kind)
+	{
+		lela_check (kind != HYBRID || Storage::has_hybrid);
+
+		Sparse ().swap (_sparse);
+		Hybrid ().swap (_hybrid);
+
+		if (kind == DENSE)
+			_dense.resize (_n);
+		else
+			Dense ().swap (_dense);
+
+		_kind = kind;
+	}
+
+	/** Set the density-thresholds
+	 *
+	 * @param sparse_max Maximum proportion of nonzero entries in the
+	 * sparse representation
+	 * @param hybrid_max Maximum proportion of nonzero words in the
+	 * hybrid representation; ignored if there is none
+	 */
+	void setThresholds (double sparse_max, double hybrid_max)
+		{ _sparse_max = sparse_max; _hybrid_max = hybrid_max; }
+
+	double sparseMax () const { return _sparse_max; }
+	double hybridMax () const { return _hybrid_max; }
+
+	/** Representation appropriate to the given density
+	 *
+	 * @param nonzero Number of nonzero entries
+	 * @param nonzero_words Number of nonzero words in the hybrid
+	 * representation; ignored if there is none
+	 * @param scale Factor by which to scale the thresholds
+	 */
+	Kind classify (size_t nonzero, size_t nonzero_words, double scale = 1.0) const
+	{
+		if ((double) nonzero <= scale * _sparse_max * (double) _n)
+			return SPARSE;
+		else if (Storage::has_hybrid && (double) nonzero_words <= scale * _hybrid_max * (double) Storage::words (_n))
+			return HYBRID;
+		else
+			return DENSE;
+	}
+
+	void swap (AdaptiveVector &v)
+	{
+		std::swap (_kind, v._kind);
+		std::swap (_n, v._n);
+		std::swap (_sparse_max, v._sparse_max);
+		std::swap (_hybrid_max, v._hybrid_max);
+		_sparse.swap (v._sparse);
+		_hybrid.swap (v._hybrid);
+		_dense.swap (v._dense);
+	}
+
+private:
+	Kind   _kind;
+	size_t _n;
+	double _sparse_max;
+	double _hybrid_max;
+
+	Sparse _sparse;
+	Hybrid _hybrid;
+	Dense  _dense;
+};
+
+} // namespace LELA
+
+namespace std
+{
+
+// Specialisation of std::swap to adaptive vectors
+template <class Element>
+void swap (LELA::AdaptiveVector<Element> &v1, LELA::AdaptiveVector<Element> &v2)
+	{ v1.swap (v2); }
+
+} // namespace std
+
+#endif // __LELA_VECTOR_ADAPTIVE_H
+
+// Local Variables:
+// mode: C++
+// tab-width: 8
+// indent-tabs-mode: t
+// c-basic-offset: 8
+// End:
+
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s:syntax=cpp.doxygen:foldmethod=syntax
@@ -13,6 +13,7 @@
 #define __LELA_BIT_VECTOR_H
 
 #include <iterator>
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
 
@@ -175,6 +176,8 @@ class BitVector
 
 	inline void clear () { _v.clear (); _size = 0; }
 
+	inline void swap (BitVector &v) { _v.swap (v._v); std::swap (_size, v._size); }
+
 	inline size_type size      (void) const { return _size;            }
 	inline bool      empty     (void) const { return _v.empty ();      }
 
@@ -202,6 +205,16 @@ class BitVector
 
 } // namespace LELA
 
+namespace std
+{
+
+// Specialisation of std::swap to bit-vectors
+template <class Endianness>
+void swap (LELA::BitVector<Endianness> &v1, LELA::BitVector<Endianness> &v2)
+	{ v1.swap (v2); }
+
+} // namespace std
+
 #include "lela/vector/bit-vector.tcc"
 
 #endif // __LELA_BIT_VECTOR_H
@@ -488,14 +488,14 @@ class SparseSubvector<Vector, HybridSubvectorWordAlignedTag>
 			       start >> WordTraits<word_type>::logof_size)
 	{
 		lela_check ((start & WordTraits<word_type>::pos_mask) == 0);
-		lela_check ((finish & WordTraits<word_type>::pos_mask) == 0 || v.empty () || finish > (size_t) (v.back ().first << WordTraits<word_type>::logof_size));
+		lela_check ((finish & WordTraits<word_type>::pos_mask) == 0 || v.empty () || finish > ((size_t) v.back ().first << WordTraits<word_type>::logof_size));
 	}
 
 	SparseSubvector (SparseSubvector &v, size_t start, size_t finish)
 		: parent_type (v, start >> WordTraits<word_type>::logof_size, (finish + WordTraits<word_type>::bits - 1) >> WordTraits<word_type>::logof_size)
 	{
 		lela_check ((start & WordTraits<word_type>::pos_mask) == 0);
-		lela_check ((finish & WordTraits<word_type>::pos_mask) == 0 || v.empty () || finish > (size_t) (v.back ().first << WordTraits<word_type>::logof_size));
+		lela_check ((finish & WordTraits<word_type>::pos_mask) == 0 || v.empty () || finish > ((size_t) v.back ().first << WordTraits<word_type>::logof_size));
 	}
 
 	SparseSubvector &operator = (const SparseSubvector &v)
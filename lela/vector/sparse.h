@@ -69,7 +69,7 @@ class SparseVectorIterator
 public:
 	typedef std::random_access_iterator_tag iterator_category;
 	typedef SparseVectorReference<IndexIterator, ElementIterator> reference;
-	typedef std::pair<typename IndexIterator::value_type, typename ElementIterator::value_type> value_type;
+	typedef std::pair<typename std::iterator_traits<IndexIterator>::value_type, typename std::iterator_traits<ElementIterator>::value_type> value_type;
 	typedef const SparseVectorReference<ConstIndexIterator, ConstElementIterator> const_reference;
 	typedef reference *pointer;
 	typedef const_reference *const_pointer;
@@ -206,8 +206,10 @@ public:
 	typedef VectorRepresentationTypes::Sparse RepresentationType; 
 	typedef VectorStorageTypes::Transformed StorageType;
 	typedef ConstSparseVector ContainerType;
-	typedef SparseSubvector<ConstSparseVector, VectorRepresentationTypes::Sparse> ConstSubvectorType;
-	typedef SparseSubvector<ConstSparseVector, VectorRepresentationTypes::Sparse> ConstAlignedSubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> SubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> ConstSubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> AlignedSubvectorType;
+	typedef SparseSubvector<const ConstSparseVector, VectorRepresentationTypes::Sparse> ConstAlignedSubvectorType;
 	static const int align = 1;
 
 	typedef SparseVectorIterator<IndexIterator, ElementIterator, ConstIndexIterator, ConstElementIterator> iterator;
@@ -399,8 +399,8 @@ class RandomDenseStream<Ring, _Vector, RandIter, VectorRepresentationTypes::Dens
 		: _F (F), _MT (0), _n (n), _m (m), _j (0)
 	{}
 
-	RandomDenseStream (const Ring &F, const RandIter &r, size_t n, size_t m = 0)
-		: _F (F), _MT (0), _n (n), _m (m), _j (0)
+	RandomDenseStream (const Ring &F, const RandIter &r, size_t n, size_t m = 0, int seed = 0)
+		: _F (F), _MT (seed), _n (n), _m (m), _j (0)
 	{}
 
 	Vector &get (Vector &v);
@@ -432,8 +432,8 @@ class RandomSparseStream<Ring, _Vector, RandIter, VectorRepresentationTypes::Spa
 		: _F (F), _n (n), _m (m), _j (0), _MT (0)
 		{ setP (p); }
 
-	RandomSparseStream (const Ring &F, const RandIter &r, double p, size_t n, size_t m = 0)
-		: _F (F), _n (n), _m (m), _j (0), _MT (0)
+	RandomSparseStream (const Ring &F, const RandIter &r, double p, size_t n, size_t m = 0, int seed = 0)
+		: _F (F), _n (n), _m (m), _j (0), _MT (seed)
 		{ setP (p); }
 
 	Vector &get (Vector &v);
@@ -474,8 +474,8 @@ class RandomSparseStream<Ring, _Vector, RandIter, VectorRepresentationTypes::Hyb
 		: _F (F), _n (n), _m (m), _j (0), _MT (0)
 		{ setP (p); }
 
-	RandomSparseStream (const Ring &F, const RandIter &r, double p, size_t n, size_t m = 0)
-		: _F (F), _n (n), _m (m), _j (0), _MT (0)
+	RandomSparseStream (const Ring &F, const RandIter &r, double p, size_t n, size_t m = 0, int seed = 0)
+		: _F (F), _n (n), _m (m), _j (0), _MT (seed)
 		{ setP (p); }
 
 	Vector &get (Vector &v);
@@ -16,7 +16,9 @@
 
 #include <vector>
 #include <algorithm>
+#include <limits>
 
+#include "lela/util/index.h"
 #include "lela/vector/bit-iterator.h"
 
 namespace LELA
@@ -134,6 +136,20 @@ namespace VectorRepresentationTypes
 	 * and that the vector e_i corresponds to the word with value 2^i.
 	 */
 	struct Hybrid01 : public Generic {};
+
+	/** Adaptive vector
+	 *
+	 * An adaptive vector stores its entries in one of several
+	 * representations -- sparse, hybrid (over GF2 only), or dense --
+	 * and switches between them at runtime according to its
+	 * density. It must provide a method kind () returning the
+	 * representation currently in use and methods sparse (), hybrid
+	 * () and dense () returning the underlying vector in that
+	 * representation. Operations dispatch on kind () and then on the
+	 * representation-type of the underlying vector. The class @ref
+	 * AdaptiveVector implements this interface.
+	 */
+	struct Adaptive : public Generic {};
 };
 
 /** Vector storage-types
@@ -393,6 +409,16 @@ class VectorUtils
 			return false;
 	}
 
+	template <class Element, class Vector>
+	static inline bool getEntrySpecialised (const Vector &v, Element &a, size_t i, VectorRepresentationTypes::Adaptive)
+	{
+		switch (v.kind ()) {
+		case Vector::SPARSE: return getEntry (v.sparse (), a, i);
+		case Vector::HYBRID: return getEntry (v.hybrid (), a, i);
+		default:             return getEntry (v.dense (), a, i);
+		}
+	}
+
 	template <class Ring, class Vector>
 	static inline void appendEntrySpecialised (const Ring &R, Vector &v, const typename Ring::Element &a, size_t i, VectorRepresentationTypes::Dense)
 		{ R.copy (v[i], a); }
@@ -439,6 +465,10 @@ class VectorUtils
 	static inline void ensureDimSpecialized (Vector &v, size_t n, VectorRepresentationTypes::Hybrid01)
 		{}
 
+	template <class Vector>
+	static inline void ensureDimSpecialized (Vector &v, size_t n, VectorRepresentationTypes::Adaptive)
+		{ if (v.dim () != n) v.resize (n); }
+
 	template <class Vector>
 	static inline bool hasDimSpecialized (const Vector &v, size_t n, VectorRepresentationTypes::Dense)
 		{ return v.size () == n; }
@@ -460,7 +490,7 @@ class VectorUtils
 	{
 		if (v.empty ())
 			return true;
-		else if ((v.back ().first << WordTraits<typename Vector::word_type>::logof_size) >= (long) n)
+		else if (((size_t) v.back ().first << WordTraits<typename Vector::word_type>::logof_size) >= n)
 			return false;
 		else if (v.back ().first == (n >> WordTraits<typename Vector::word_type>::logof_size))
 			return (v.back ().second & Vector::Endianness::mask_right (n & WordTraits<typename Vector::word_type>::pos_mask)) == 0;
@@ -468,6 +498,41 @@ class VectorUtils
 			return true;
 	}
 
+	template <class Vector>
+	static inline bool hasDimSpecialized (const Vector &v, size_t n, VectorRepresentationTypes::Adaptive)
+		{ return v.dim () == n; }
+
+	template <class Index>
+	static inline size_t maxIndex ()
+		{ return ((uint64) std::numeric_limits<Index>::max () >= (uint64) (size_t) -1) ? (size_t) -1 : (size_t) std::numeric_limits<Index>::max (); }
+
+	template <class Ring, class Vector>
+	static inline size_t maxDimSpecialized (VectorRepresentationTypes::Generic)
+		{ return (size_t) -1; }
+
+	template <class Ring, class Vector>
+	static inline size_t maxDimSpecialized (VectorRepresentationTypes::Sparse)
+		{ return maxIndex<typename Vector::value_type::first_type> (); }
+
+	template <class Ring, class Vector>
+	static inline size_t maxDimSpecialized (VectorRepresentationTypes::Sparse01)
+		{ return maxIndex<typename Vector::value_type> (); }
+
+	template <class Ring, class Vector>
+	static inline size_t maxDimSpecialized (VectorRepresentationTypes::Hybrid01)
+	{
+		size_t words = maxIndex<typename Vector::index_type> ();
+
+		if (words >= ((size_t) -1 >> WordTraits<typename Vector::word_type>::logof_size))
+			return (size_t) -1;
+		else
+			return ((words + 1) << WordTraits<typename Vector::word_type>::logof_size) - 1;
+	}
+
+	template <class Ring, class Vector>
+	static inline size_t maxDimSpecialized (VectorRepresentationTypes::Adaptive)
+		{ return std::min (maxDim<Ring, typename Vector::Sparse> (), maxDim<Ring, typename Vector::Hybrid> ()); }
+
 	template <class Vector>
 	static inline bool isValidSpecialized (const Vector &v, VectorRepresentationTypes::Dense)
 		{ return true; }
@@ -598,6 +663,17 @@ public:
 	static inline bool hasDim (const Vector &v, size_t n) 
 		{ return hasDimSpecialized (v, n, typename VectorTraits<Ring, Vector>::RepresentationType ()); }
 
+	/** Largest dimension which a vector of type Vector can address
+	 *
+	 * This is limited by the type of the indices of sparse and
+	 * hybrid vectors; a dense vector can have any dimension. The
+	 * dimension itself must also fit, so that it may be used as an
+	 * end-marker.
+	 */
+	template <class Ring, class Vector>
+	static inline size_t maxDim ()
+		{ return maxDimSpecialized<Ring, Vector> (typename VectorTraits<Ring, Vector>::RepresentationType ()); }
+
 	/// Determines whether v is a valid vector of its format.
 	/// @returns true if v is valid or false if there is an error
 	template <class Ring, class Vector>
@@ -622,8 +698,9 @@ public:
 // Forward declarations of types we're about to use
 template <typename Iterator, typename ConstIterator = Iterator> class Subvector;
 template <typename Iterator> class Subiterator;
-template <class Element, class IndexVector = std::vector<uint32>, class ElementVector = std::vector<Element> > class SparseVector;
+template <class Element, class IndexVector = std::vector<DefaultIndex>, class ElementVector = std::vector<Element> > class SparseVector;
 template <class Vector, class Trait> class SparseSubvector;
+template <class Element> class AdaptiveVector;
 
 template <class Element>
 struct DefaultVectorTraits< std::vector<Element> >
@@ -719,6 +796,7 @@ struct Vector
 	typedef typename Ring::Element Element;
 	typedef std::vector<Element> Dense;
 	typedef SparseVector<Element> Sparse;
+	typedef AdaptiveVector<Element> Adaptive;
 };
 
 // Version parametrised only by element
@@ -0,0 +1,83 @@
+# Check for MPI
+
+dnl LB_CHECK_MPI
+dnl
+dnl Test for an MPI-implementation and define MPI_CFLAGS, MPI_LIBS,
+dnl MPIRUN, MPIRUN_FLAGS, and HAVE_MPI. Flags are taken from the compiler-wrapper
+dnl mpicxx (Open MPI: --showme, MPICH: -compile-info and -link-info).
+
+AC_DEFUN([LB_CHECK_MPI],
+[
+MPI_LIBS=
+MPI_CFLAGS=
+
+AC_ARG_WITH(mpi,[
+   --with-mpi=<path>|yes|no Use MPI for distributed algorithms. <path> is
+			 the directory containing the compiler-wrapper
+			 mpicxx and the launcher mpirun.
+],[
+if test "$withval" = yes ; then
+	MPI_PATH="$PATH"
+elif test "$withval" != no ; then
+	MPI_PATH="$withval:$withval/bin"
+fi
+],[
+	MPI_PATH="$PATH"
+])
+
+if test "x$MPI_PATH" != "x" ; then
+	AC_PATH_PROG(MPICXX, mpicxx, no, $MPI_PATH)
+	AC_PATH_PROG(MPIRUN, mpirun, no, $MPI_PATH)
+fi
+
+AC_MSG_CHECKING(for MPI)
+
+if test "x$MPICXX" != "x" -a "x$MPICXX" != "xno" ; then
+	if $MPICXX --showme:compile >/dev/null 2>&1 ; then
+		MPI_CFLAGS=`$MPICXX --showme:compile`
+		MPI_LIBS=`$MPICXX --showme:link`
+	else
+		MPI_CFLAGS=`$MPICXX -compile-info 2>/dev/null | sed -e 's/^[[^ ]]* //' -e 's/ -c / /'`
+		MPI_LIBS=`$MPICXX -link-info 2>/dev/null | sed -e 's/^[[^ ]]* //'`
+	fi
+
+	BACKUP_CXXFLAGS=${CXXFLAGS}
+	BACKUP_LIBS=${LIBS}
+	CXXFLAGS="${BACKUP_CXXFLAGS} ${MPI_CFLAGS}"
+	LIBS="${BACKUP_LIBS} ${MPI_LIBS}"
+
+	AC_TRY_LINK([#include <mpi.h>],
+		    [int flag; MPI_Initialized (&flag); MPI_Request r; MPI_Ibcast (0, 0, MPI_BYTE, 0, MPI_COMM_WORLD, &r);],
+		    [mpi_found="yes"], [mpi_found="no"])
+
+	CXXFLAGS=${BACKUP_CXXFLAGS}
+	LIBS=${BACKUP_LIBS}
+else
+	mpi_found="no"
+fi
+
+if test "x$mpi_found" = "xyes" ; then
+	AC_MSG_RESULT(found)
+	AC_DEFINE(HAVE_MPI,1,[Define if MPI is available])
+	HAVE_MPI=yes
+else
+	AC_MSG_RESULT(not found)
+	MPI_CFLAGS=
+	MPI_LIBS=
+fi
+
+# Open MPI refuses to start more processes than there are cores
+# unless told to oversubscribe, which the tests need on small machines
+MPIRUN_FLAGS=
+
+if test "x$mpi_found" = "xyes" && $MPIRUN --version 2>&1 | grep "Open MPI" >/dev/null ; then
+	MPIRUN_FLAGS="--oversubscribe"
+fi
+
+AC_SUBST(MPI_CFLAGS)
+AC_SUBST(MPI_LIBS)
+AC_SUBST(MPIRUN)
+AC_SUBST(MPIRUN_FLAGS)
+
+AM_CONDITIONAL(LELA_HAVE_MPI, test "x$HAVE_MPI" = "xyes")
+])
@@ -24,6 +24,7 @@
 #include "lela/vector/stream.h"
 #include "lela/blas/context.h"
 #include "lela/blas/level1.h"
+#include "lela/vector/small-vector.h"
 
 #include "test-common.h" 
 
@@ -876,6 +877,52 @@ bool testBLAS1RepsConsistency (LELA::Context<Ring, Modules> &ctx, const char *te
 	return pass;
 }
 
+template <class Ring, class Modules>
+bool testBLAS1SmallSparse (LELA::Context<Ring, Modules> &ctx, const char *text, size_t n, unsigned int iterations) 
+{
+	std::ostringstream str;
+	str << "Testing BLAS1 with short sparse vectors with inline storage over <" << text << ">" << std::ends;
+	LELA::commentator.start (str.str ().c_str ());
+
+	bool pass = true;
+
+	typedef typename Ring::Element Element;
+	typedef LELA::SparseVector<Element, LELA::SmallVector<LELA::uint32, 4>, LELA::SmallVector<Element, 4> > SmallSparse;
+
+	// About three nonzero entries, so that some vectors spill over
+	// to the heap and most do not
+	double p = 3.0 / (double) n;
+
+	LELA::RandomDenseStream<Ring, typename LELA::Vector<Ring>::Dense> stream1 (ctx.F, n, iterations), stream2 (ctx.F, n, iterations);
+	LELA::RandomSparseStream<Ring, typename LELA::Vector<Ring>::Sparse> stream3 (ctx.F, p, n, iterations);
+	LELA::RandomSparseStream<Ring, SmallSparse> stream4 (ctx.F, p, n, iterations), stream5 (ctx.F, p, n, iterations);
+
+	if (!testCopyEqual (ctx, "small sparse/dense", stream4, stream2)) pass = false;        stream4.reset (); stream2.reset ();
+	if (!testCopyEqual (ctx, "small sparse/sparse", stream4, stream3)) pass = false;       stream4.reset (); stream3.reset ();
+	if (!testCopyEqual (ctx, "small sparse/small sparse", stream4, stream5)) pass = false; stream4.reset (); stream5.reset ();
+
+	if (!testInequality (ctx, "small sparse/small sparse", stream4, stream5)) pass = false; stream4.reset (); stream5.reset ();
+
+	if (!testNonzero (ctx, "small sparse", stream4)) pass = false; stream4.reset ();
+
+	if (!testDotProduct (ctx, "small sparse/dense", stream4, stream1)) pass = false;        stream4.reset (); stream1.reset ();
+	if (!testDotProduct (ctx, "small sparse/small sparse", stream4, stream5)) pass = false; stream4.reset (); stream5.reset ();
+
+	if (!testScal (ctx, "small sparse", stream4)) pass = false; stream4.reset ();
+
+	if (!testAXPY (ctx, "small sparse", stream4, stream5)) pass = false; stream4.reset (); stream5.reset ();
+
+	if (!testswap (ctx, "small sparse", stream4)) pass = false; stream4.reset ();
+
+	pass = testDotConsistency (ctx, ctx, "small sparse/small sparse with dense/dense", stream4, stream5, stream1, stream1) && pass; stream4.reset (); stream5.reset ();
+	pass = testAxpyConsistency (ctx, ctx, "small sparse/small sparse with dense/dense", stream4, stream5, stream1, stream1) && pass; stream4.reset (); stream5.reset ();
+	pass = testScalConsistency (ctx, ctx, "small sparse with dense", stream4, stream1) && pass; stream4.reset (); stream1.reset ();
+
+	LELA::commentator.stop (MSG_STATUS (pass));
+
+	return pass;
+}
+
 #endif // __LELA_TESTS_TEST_BLAS_LEVEL1_H
 
 // Local Variables:
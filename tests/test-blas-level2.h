@@ -961,6 +961,7 @@ bool testBLAS2RepsConsistency (LELA::Context<Ring, Modules> &ctx, const char *te
 	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise) with dense (LT, diag != 1)", M6p, v1, M4, v1, LowerTriangular, false) && pass;
 	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise) with dense (UT, diag != 1)", M6p, v1, M4, v1, UpperTriangular, false) && pass;
 
+
 	pass = testgerConsistency (ctx, ctx, "sparse(row-wise) /dense  /dense          with dense/dense/dense", M2, v2, v1, M1, v1, v1) && pass;
         pass = testgerConsistency (ctx, ctx, "sparse(col-wise) /dense  /dense          with dense/dense/dense", M3, v1, v2, M1, v1, v1) && pass;
         pass = testgerConsistency (ctx, ctx, "sparse(row-wise) /sparse /sparse         with dense/dense/dense", M2, w2, w1, M1, v1, v1) && pass;
@@ -976,6 +977,55 @@ bool testBLAS2RepsConsistency (LELA::Context<Ring, Modules> &ctx, const char *te
 	return pass;
 }
 
+/* Test: trsv with sparse right-hand sides, checked against the
+ * solution with a dense copy of the right-hand side
+ */
+
+template <class Ring, class Modules>
+bool testBLAS2SparseTrsv (LELA::Context<Ring, Modules> &ctx, const char *text, size_t n, size_t k) 
+{
+	std::ostringstream str;
+	str << "Testing trsv with sparse vectors over <" << text << ">" << std::ends;
+	LELA::commentator.start (str.str ().c_str ());
+
+	bool pass = true;
+
+	typename LELA::Vector<Ring>::Dense v1 (n);
+	typename LELA::Vector<Ring>::Sparse w1, w2;
+
+	LELA::RandomSparseStream<Ring, typename LELA::Vector<Ring>::Sparse> stream1 (ctx.F, (double) k / (double) n, n);
+	stream1 >> w1;
+
+	// Single nonzero entry, so that the solution depends on only a
+	// small part of the matrix
+	w2.push_back (typename LELA::Vector<Ring>::Sparse::value_type (n / 2, ctx.F.one ()));
+
+	DenseMatrix<typename Ring::Element> M1 (n, n);
+
+	RandomSparseStream<Ring, typename SparseMatrix<typename Ring::Element>::Row> stream3 (ctx.F, (double) k / (double) n, n, n);
+	SparseMatrix<typename Ring::Element> M2 (stream3);
+
+	TransposeMatrix<SparseMatrix<typename Ring::Element> > M3 (M2);
+
+	SparseMatrix<typename Ring::Element> M2p (n, n);
+	BLAS3::copy (ctx, M2, M2p);
+	makeNonsingDiag (ctx.F, M2p, false);
+
+	TransposeMatrix<SparseMatrix<typename Ring::Element> > M3p (M2p);
+
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/sparse with dense/dense (LT, diag = 1)", M3, w1, M1, v1, LowerTriangular, true) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/sparse with dense/dense (UT, diag = 1)", M3, w1, M1, v1, UpperTriangular, true) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/sparse with dense/dense (LT, diag != 1)", M3p, w1, M1, v1, LowerTriangular, false) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/sparse with dense/dense (UT, diag != 1)", M3p, w1, M1, v1, UpperTriangular, false) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/very sparse with dense/dense (LT, diag != 1)", M3p, w2, M1, v1, LowerTriangular, false) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(col-wise)/very sparse with dense/dense (UT, diag != 1)", M3p, w2, M1, v1, UpperTriangular, false) && pass;
+	pass = testtrsvConsistency (ctx, ctx, "sparse(row-wise)/sparse with dense/dense (LT, diag != 1)", M2p, w1, M1, v1, LowerTriangular, false) && pass;
+
+	LELA::commentator.stop (MSG_STATUS (pass));
+
+	return pass;
+}
+
 #endif // __LELA_TESTS_TEST_BLAS_LEVEL2_H
 
 // Local Variables:
@@ -1479,7 +1479,7 @@ bool testtrmmConsistency  (LELA::Context<Ring, Modules1> &ctx1,
         bool pass = true;
 
         typename Matrix3::ContainerType A5 (A1.rowdim (), A1.coldim ());
-        typename Matrix2::ContainerType A6 (A2.rowdim (), A1.coldim ());
+        typename Matrix2::ContainerType A6 (A2.rowdim (), A2.coldim ());
 	typename Matrix4::ContainerType A7 (A2.rowdim (), A2.coldim ()); 
 
 	BLAS3::copy(ctx1, A1, A5);
@@ -2063,6 +2063,11 @@ bool testBLAS3RepsConsistency (LELA::Context<Ring, Modules> &ctx, const char *te
         pass = testgemmConsistency (ctx, ctx, "sparse(col-wise)/sparse(col-wise)/dense     with dense/dense/dense",
 				    A2_trans, A1_trans, A4_dense, A1_dense, A2_dense, A3_dense) && pass;
 
+        pass = testgemmConsistency (ctx, ctx, "dense/sparse(row-wise)/dense                with dense/dense/dense",
+				    A1_dense, A2_sparse, A3_dense, A1_dense, A2_dense, A3_dense) && pass;
+        pass = testgemmConsistency (ctx, ctx, "dense/sparse(row-wise)/sparse(row-wise)     with dense/dense/dense",
+				    A1_dense, A2_sparse, A3_sparse, A1_dense, A2_dense, A3_dense) && pass;
+
         pass = testgemmConsistency (ctx, ctx, "sparse(row-wise)/dense/sparse(row-wise)                with dense/dense/dense",
 				    A1_sparse, A2_dense, A3_sparse, A1_dense, A2_dense, A3_dense) && pass;
         pass = testgemmConsistency (ctx, ctx, "sparse(col-wise)/dense/sparse(row-wise)                with dense/dense/dense",
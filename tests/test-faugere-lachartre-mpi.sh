@@ -0,0 +1,14 @@
+#!/bin/sh
+# Copyright 2026 agent <agent@local>
+#
+# Written by agent <agent@local>
+#
+# This file is part of LELA, licensed under the GNU General Public
+# License version 3. See COPYING for more information.
+#
+# Run the test of the distributed Faugère-Lachartre algorithm under
+# mpirun. The launcher, its flags, and the number of processes may be
+# set through MPIRUN, MPIRUN_FLAGS, and MPI_NP. The test is told the
+# number of processes, and fails if it runs on any other number.
+
+exec ${MPIRUN:-mpirun} ${MPIRUN_FLAGS} -np ${MPI_NP:-3} ./test-faugere-lachartre-mpi -P ${MPI_NP:-3} "$@"
@@ -465,6 +465,85 @@ bool testRingInversion (const Ring &F, const char *name, unsigned int iterations
 	return ret;
 }
 
+/** Generic test 5a: Batch-inversion of elements
+ *
+ * Inverts vectors of random nonzero elements with invBatch and
+ * checks the results against inv
+ */
+
+template <class Ring>
+bool testRingBatchInversion (const Ring &F, const char *name, unsigned int iterations) 
+{
+	std::ostringstream str;
+	str << "Testing " << name << " batch-inversion" << ends;
+	char * st = new char[str.str().size()];
+	strcpy (st, str.str().c_str());
+	commentator.start (st, "testRingBatchInversion", iterations);
+
+	static const size_t len = 17;
+
+	std::vector<typename Ring::Element> a (len), ainv (len);
+	typename Ring::Element b;
+	typename Ring::RandIter r (F);
+
+	F.init (b, 0);
+
+	bool ret = true;
+
+	for (unsigned int i = 0; i < iterations; i++) {
+		commentator.startIteration (i);
+
+		ostream &report = commentator.report (LELA::Commentator::LEVEL_UNIMPORTANT, INTERNAL_DESCRIPTION);
+
+		size_t k;
+		bool all_invertible = true;
+
+		for (k = 0; k < len; ++k) {
+			do r.random (a[k]); while (F.isZero (a[k]));
+
+			if (!F.inv (b, a[k]))
+				all_invertible = false;
+		}
+
+		if (F.invBatch (ainv.begin (), a.begin (), a.end ())) {
+			if (!all_invertible)
+				reportError ("invBatch reports success although not all elements are invertible", ret);
+
+			for (k = 0; k < len; ++k) {
+				F.inv (b, a[k]);
+
+				if (!F.areEqual (b, ainv[k])) {
+					report << "Element " << k << ": a = ";
+					F.write (report, a[k]) << ", a^{-1} = ";
+					F.write (report, b) << ", invBatch gave ";
+					F.write (report, ainv[k]) << endl;
+					reportError ("invBatch and inv disagree", ret);
+				}
+			}
+		} else if (all_invertible)
+			reportError ("invBatch reports failure although all elements are invertible", ret);
+
+		// The same, in place
+		ainv = a;
+
+		if (F.invBatch (ainv.begin (), ainv.begin (), ainv.end ())) {
+			for (k = 0; k < len; ++k) {
+				F.inv (b, a[k]);
+
+				if (!F.areEqual (b, ainv[k]))
+					reportError ("In-place invBatch and inv disagree", ret);
+			}
+		}
+
+		commentator.stop ("done");
+		commentator.progress ();
+	}
+
+	commentator.stop (MSG_STATUS (ret), (const char *) 0, "testRingBatchInversion");
+	delete[] st;
+	return ret;
+}
+
 /** @brief Generic test 7a: Distributivity of multiplication over addition
 
  * Given random ring elements 'a', 'b', and 'c', checks that
@@ -1195,6 +1274,7 @@ bool runRingTests (const Ring &F, const char *desc, unsigned int iterations, boo
 	if (runInversionTests) {
 		ret = testInvDivConsistency (F, desc, iterations) && ret;
 		ret = testRingInversion (F, desc, iterations) && ret;
+		ret = testRingBatchInversion (F, desc, iterations) && ret;
 	}
 
 	ret = testRingCommutativity (F, desc, iterations) && ret;